@@ -0,0 +1,226 @@
+/*
+//
+// Copyright (c) 1993-2018 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//				
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+*/		
+
+////////////////////////////////////////////////////////////////
+//
+//  example_classid_benchmark.cpp  
+// 
+//  Example program that measures MYON_ClassId::ClassId() lookups.
+//  Reading a 3dm file looks up the class of every object table record
+//  by uuid, so the files on the command line are read with
+//  MYONX_Model::Read() once using the class id hash tables and once
+//  using the linear search, and the time per object table record is
+//  reported for each. Name and uuid lookups are then timed directly,
+//  and finally new class ids are registered so the tables are rebuilt.
+//
+//  Usage: example_classid_benchmark [-r:repeat_count] file1.3dm [file2.3dm ...]
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "../opennurbs_public_examples.h"
+
+#include <chrono>
+
+static const MYON_ClassId* ClassIds[] =
+{
+  &MYON_CLASS_RTTI(MYON_Object),
+  &MYON_CLASS_RTTI(MYON_Geometry),
+  &MYON_CLASS_RTTI(MYON_Curve),
+  &MYON_CLASS_RTTI(MYON_LineCurve),
+  &MYON_CLASS_RTTI(MYON_ArcCurve),
+  &MYON_CLASS_RTTI(MYON_PolylineCurve),
+  &MYON_CLASS_RTTI(MYON_PolyCurve),
+  &MYON_CLASS_RTTI(MYON_NurbsCurve),
+  &MYON_CLASS_RTTI(MYON_Surface),
+  &MYON_CLASS_RTTI(MYON_PlaneSurface),
+  &MYON_CLASS_RTTI(MYON_RevSurface),
+  &MYON_CLASS_RTTI(MYON_SumSurface),
+  &MYON_CLASS_RTTI(MYON_NurbsSurface),
+  &MYON_CLASS_RTTI(MYON_Brep),
+  &MYON_CLASS_RTTI(MYON_Extrusion),
+  &MYON_CLASS_RTTI(MYON_Mesh),
+  &MYON_CLASS_RTTI(MYON_SubD),
+  &MYON_CLASS_RTTI(MYON_Point),
+  &MYON_CLASS_RTTI(MYON_PointCloud),
+  &MYON_CLASS_RTTI(MYON_TextDot),
+  &MYON_CLASS_RTTI(MYON_Hatch),
+  &MYON_CLASS_RTTI(MYON_InstanceRef),
+  &MYON_CLASS_RTTI(MYON_Layer),
+  &MYON_CLASS_RTTI(MYON_Material),
+  &MYON_CLASS_RTTI(MYON_3dmObjectAttributes),
+};
+
+static const unsigned int ClassIdCount = (unsigned int)(sizeof(ClassIds) / sizeof(ClassIds[0]));
+
+static unsigned int LookupClassIds(unsigned int lookup_count)
+{
+  // Returns the number of failed lookups; it should be zero.
+  unsigned int error_count = 0;
+  for (unsigned int i = 0; i < lookup_count; i++)
+  {
+    const MYON_ClassId* class_id = ClassIds[i % ClassIdCount];
+    if (class_id != MYON_ClassId::ClassId(class_id->ClassName()))
+      error_count++;
+    if (class_id != MYON_ClassId::ClassId(class_id->Uuid()))
+      error_count++;
+  }
+  return error_count;
+}
+
+static double Seconds(std::chrono::steady_clock::time_point t0)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static MYON_Object* CreateNothing()
+{
+  return nullptr;
+}
+
+static bool ReadFiles(
+  const MYON_ClassArray<MYON_String>& file_names,
+  unsigned int repeat_count,
+  double& seconds,
+  unsigned int& record_count
+)
+{
+  seconds = 0.0;
+  record_count = 0;
+  for (unsigned int r = 0; r < repeat_count; r++)
+  {
+    for (int i = 0; i < file_names.Count(); i++)
+    {
+      MYONX_Model model;
+      const auto t0 = std::chrono::steady_clock::now();
+      const bool rc = model.Read(static_cast<const char*>(file_names[i]));
+      seconds += Seconds(t0);
+      if (false == rc)
+        return false;
+      record_count += model.ActiveAndDeletedComponentCount(MYON_ModelComponent::Type::ModelGeometry);
+    }
+  }
+  return true;
+}
+
+int main( int argc, const char *argv[] )
+{
+  MYON::Begin();
+
+  MYON_TextLog dump_to_stdout;
+  MYON_TextLog& dump = dump_to_stdout;
+
+  unsigned int repeat_count = 10;
+  MYON_ClassArray<MYON_String> file_names;
+  for (int argi = 1; argi < argc; argi++)
+  {
+    const char* arg = argv[argi];
+    if (nullptr == arg || 0 == arg[0])
+      continue;
+    if (0 == strncmp(arg, "-r:", 3))
+    {
+      if (atoi(arg + 3) > 0)
+        repeat_count = (unsigned int)atoi(arg + 3);
+      continue;
+    }
+    file_names.Append(MYON_String(arg));
+  }
+
+  if (0 == file_names.Count())
+  {
+    dump.Print("Usage: example_classid_benchmark [-r:repeat_count] file1.3dm [file2.3dm ...]\n");
+    MYON::End();
+    return 1;
+  }
+
+  unsigned int error_count = 0;
+  const bool bUseHashTables = MYON_ClassId::UseHashTablesForExperts();
+
+  // The first pass reads each file once so the file system cache
+  // does not favor whichever lookup path is measured second.
+  double seconds = 0.0;
+  unsigned int record_count = 0;
+  if (false == ReadFiles(file_names, 1, seconds, record_count))
+  {
+    dump.Print("ERROR: Unable to read the files.\n");
+    MYON::End();
+    return 1;
+  }
+
+  for (int pass = 0; pass < 2; pass++)
+  {
+    const bool bHash = (1 == pass);
+    const char* path_name = bHash ? "hash table" : "linear search";
+    MYON_ClassId::SetUseHashTablesForExperts(bHash);
+
+    if (false == ReadFiles(file_names, repeat_count, seconds, record_count))
+    {
+      dump.Print("ERROR: Unable to read the files.\n");
+      error_count++;
+      break;
+    }
+    dump.Print(
+      "MYONX_Model::Read() with %s: %u object table records in %g seconds (%g microseconds per record)\n",
+      path_name, record_count, seconds, (record_count > 0) ? (1.0e6 * seconds / record_count) : 0.0
+    );
+
+    // Each lookup searches once by name and once by uuid.
+    const unsigned int lookup_count = 1000000;
+    const auto t0 = std::chrono::steady_clock::now();
+    error_count += LookupClassIds(lookup_count);
+    seconds = Seconds(t0);
+    dump.Print(
+      "MYON_ClassId::ClassId() with %s: %u lookups in %g seconds (%g ns per lookup)\n",
+      path_name, 2 * lookup_count, seconds, 1.0e9 * seconds / (2.0 * lookup_count)
+    );
+  }
+
+  MYON_ClassId::SetUseHashTablesForExperts(bUseHashTables);
+
+  // Registering a class id retires the lookup tables and later
+  // lookups rebuild them. Applications register class ids when they
+  // load plug-ins, so this measures the cost of a rebuild.
+  // The class ids are never destroyed because MYON_ClassId keeps them
+  // in a linked list for the life of the program.
+  const unsigned int new_class_id_count = 64;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < new_class_id_count; i++)
+  {
+    MYON_String sClassName;
+    sClassName.Format("MYON_ExampleBenchmarkClass%u", i);
+    MYON_String sUUID;
+    sUUID.Format("6D3A4F62-8C1B-4E9A-9F0E-%012X", i + 1);
+    const MYON_ClassId* class_id = new MYON_ClassId(
+      static_cast<const char*>(sClassName),
+      "MYON_Object",
+      CreateNothing,
+      static_cast<const char*>(sUUID)
+    );
+    if (class_id != MYON_ClassId::ClassId(static_cast<const char*>(sClassName)))
+      error_count++;
+    error_count += LookupClassIds(ClassIdCount);
+  }
+  seconds = Seconds(t0);
+  dump.Print(
+    "%u class id registrations and table rebuilds: %g seconds\n",
+    new_class_id_count, seconds
+  );
+
+  if (0 != error_count)
+    dump.Print("ERROR: %u errors.\n", error_count);
+
+  MYON::End();
+
+  return (0 == error_count) ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/*
+//
+// Copyright (c) 1993-2018 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Associates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//				
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+*/		
+
+////////////////////////////////////////////////////////////////
+//
+//  example_manifest_benchmark.cpp  
+// 
+//  Example program that measures MYON_ComponentManifest with a large
+//  number of layers:
+//  - adding the layers one at a time with AddComponentToManifest()
+//  - adding the layers at once with AddComponentsToManifest()
+//  - finding every layer by name
+//  - finding unused names with the same base name
+//
+//  Usage: example_manifest_benchmark [layer_count] [unused_name_count]
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "../opennurbs_public_examples.h"
+
+#include <chrono>
+
+static double Seconds(std::chrono::steady_clock::time_point t0)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main( int argc, const char *argv[] )
+{
+  MYON::Begin();
+
+  MYON_TextLog dump_to_stdout;
+  MYON_TextLog& dump = dump_to_stdout;
+
+  unsigned int layer_count = 1000000;
+  unsigned int unused_name_count = 20000;
+  if (argc > 1 && atoi(argv[1]) > 0)
+    layer_count = (unsigned int)atoi(argv[1]);
+  if (argc > 2 && atoi(argv[2]) > 0)
+    unused_name_count = (unsigned int)atoi(argv[2]);
+
+  const MYON_ModelComponent::Type layer_type = MYON_ModelComponent::Type::Layer;
+
+  // No MYON_ModelComponent instances are created by this program, so
+  // runtime serial numbers starting at serial_number are not in use.
+  MYON__UINT64 serial_number = MYON_ModelComponent::NextRuntimeSerialNumber();
+
+  // The items describe layers named "Layer 0000000", "Layer 0000001", ...
+  MYON_SimpleArray<MYON_ComponentManifestItem> items(layer_count);
+  MYON_wString name;
+  for (unsigned int i = 0; i < layer_count; i++)
+  {
+    name.Format(L"Layer %07u", i);
+    items.Append(
+      MYON_ComponentManifestItem(
+        layer_type,
+        serial_number++,
+        MYON_CreateId(),
+        MYON_NameHash::Create(MYON_nil_uuid, name)
+      )
+    );
+  }
+
+  unsigned int error_count = 0;
+
+  MYON_ComponentManifest manifest1;
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < layer_count; i++)
+  {
+    const MYON_ComponentManifestItem& item = items[i];
+    if (manifest1.AddComponentToManifest(layer_type, item.ComponentRuntimeSerialNumber(), item.Id(), item.NameHash()).IsUnset())
+      error_count++;
+  }
+  double seconds = Seconds(t0);
+  dump.Print("AddComponentToManifest() %u layers: %g seconds\n", layer_count, seconds);
+
+  MYON_ComponentManifest manifest2;
+  t0 = std::chrono::steady_clock::now();
+  if (layer_count != manifest2.AddComponentsToManifest(items, false, nullptr))
+    error_count++;
+  seconds = Seconds(t0);
+  dump.Print("AddComponentsToManifest() %u layers: %g seconds\n", layer_count, seconds);
+
+  t0 = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < layer_count; i++)
+  {
+    const MYON_ComponentManifestItem& item = manifest2.ItemFromNameHash(layer_type, items[i].NameHash());
+    if (item.Id() != items[i].Id())
+      error_count++;
+  }
+  seconds = Seconds(t0);
+  dump.Print("ItemFromNameHash() %u layers: %g seconds\n", layer_count, seconds);
+
+  // Adding many layers with the same base name is what happens when
+  // layers are imported or pasted repeatedly.
+  MYON_ComponentManifest manifest3;
+  t0 = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < unused_name_count; i++)
+  {
+    const MYON_wString unused_name = manifest3.UnusedName(layer_type, MYON_nil_uuid, nullptr, L"Layer", nullptr, 0, nullptr);
+    if (unused_name.IsEmpty())
+    {
+      error_count++;
+      break;
+    }
+    if (manifest3.AddComponentToManifest(layer_type, serial_number++, MYON_CreateId(), MYON_NameHash::Create(MYON_nil_uuid, unused_name)).IsUnset())
+      error_count++;
+  }
+  seconds = Seconds(t0);
+  dump.Print("UnusedName() and AddComponentToManifest() %u layers: %g seconds\n", unused_name_count, seconds);
+
+  if (0 != error_count)
+    dump.Print("ERROR: %u manifest operations failed.\n", error_count);
+
+  MYON::End();
+
+  return (0 == error_count) ? 0 : 1;
+}
@@ -77,6 +77,7 @@ static bool ReadFileHelper(
   const wchar_t* sFileName,
   bool bVerboseTextDump,
   bool bChunkDump,
+  bool bMetadataDump,
   MYON_TextLog& dump
   )
 {
@@ -85,6 +86,18 @@ static bool ReadFileHelper(
     return Dump3dmFileHelper(sFileName,dump);
   }
 
+  if ( bMetadataDump )
+  {
+    // Reads the file's metadata without reading the model.
+    MYONX_ModelMetadata metadata;
+    dump.Print("\nOpenNURBS Archive File:  %ls\n", sFileName );
+    dump.PushIndent();
+    const bool rc = metadata.Read( sFileName, &dump );
+    metadata.Dump(dump);
+    dump.PopIndent();
+    return rc;
+  }
+
   MYONX_Model model;
 
   dump.Print("\nOpenNURBS Archive File:  %ls\n", sFileName );
@@ -138,6 +151,7 @@ static int ReadDirectoryHelper(
   const wchar_t* file_name_filter,
   bool bVerboseTextDump,
   bool bChunkDump,
+  bool bMetadataDump,
   MYON_TextLog& dump
   )
 {
@@ -174,7 +188,7 @@ static int ReadDirectoryHelper(
       if ( !MYON::IsOpenNURBSFile(full_path) )
         continue;
 
-      if ( ReadFileHelper(full_path,bVerboseTextDump,bChunkDump,dump) )
+      if ( ReadFileHelper(full_path,bVerboseTextDump,bChunkDump,bMetadataDump,dump) )
         file_count++;
     }
 
@@ -204,6 +218,7 @@ static int ReadDirectoryHelper(
                             file_name_filter,
                             bVerboseTextDump,
                             bChunkDump,
+                            bMetadataDump,
                             dump
                             );
       }
@@ -221,7 +236,7 @@ static void print_help(const char* example_read_exe_name)
 
   printf("\n");
   printf("SYNOPSIS:\n");
-  printf("  %s [-out:outputfilename.txt] [-c] [-r] <file or directory names>\n",example_read_exe_name );
+  printf("  %s [-out:outputfilename.txt] [-c] [-m] [-r] <file or directory names>\n",example_read_exe_name );
   printf("\n");
   printf("DESCRIPTION:\n");
   printf("  If a file is listed, it is read as an opennurbs model file.\n");
@@ -233,6 +248,8 @@ static void print_help(const char* example_read_exe_name)
   printf("      The output is written to the named file.\n");
   printf("    -chunkdump\n");
   printf("      Does a chunk dump instead of reading the file's contents.\n");
+  printf("    -metadata\n");
+  printf("      Prints the file's metadata instead of reading the file's contents.\n");
   printf("    -recursive\n");
   printf("      Recursivly reads files in subdirectories.\n");
   printf("\n");
@@ -313,6 +330,8 @@ int main( int argc, const char *argv[] )
 
   bool bChunkDump = false;
 
+  bool bMetadataDump = false;
+
 
   int maximum_directory_depth = 0;
 
@@ -373,6 +392,21 @@ int main( int argc, const char *argv[] )
       continue;
     }
 
+    // check for -metadata or /metadata option
+    if (    0 == strcmp(arg,"-M") 
+         || 0 == strcmp(arg,"-m") 
+         || 0 == strcmp(arg,"-metadata") 
+#if defined(MYON_OS_WINDOWS)
+         || 0 == strcmp(arg,"/M") 
+         || 0 == strcmp(arg,"/m") 
+         || 0 == strcmp(arg,"/metadata") 
+#endif
+         )
+    {
+      bMetadataDump = true;
+      continue;
+    }
+
     // check for -recursive or /recursive option
     if (    0 == strcmp(arg,"-R") 
          || 0 == strcmp(arg,"-r") 
@@ -395,11 +429,11 @@ int main( int argc, const char *argv[] )
 
     if ( MYON::IsDirectory(wchar_arg) )
     {
-      file_count += ReadDirectoryHelper( 0, maximum_directory_depth, wchar_arg, 0, bVerboseTextDump, bChunkDump, *dump );
+      file_count += ReadDirectoryHelper( 0, maximum_directory_depth, wchar_arg, 0, bVerboseTextDump, bChunkDump, bMetadataDump, *dump );
     }
     else
     {
-      if ( ReadFileHelper( wchar_arg, bVerboseTextDump, bChunkDump, *dump ) )
+      if ( ReadFileHelper( wchar_arg, bVerboseTextDump, bChunkDump, bMetadataDump, *dump ) )
         file_count++;
     }    
 
@@ -142,6 +142,9 @@
 
 #define TCODE_HISTORYRECORD_TABLE (TCODE_TABLE | 0x0026) /* history records */
 
+/* changes appended after the end mark by MYONX_Model::AppendChanges() */
+#define TCODE_APPENDED_CHANGES_TABLE (TCODE_TABLE | 0x0027)
+
 #define TCODE_ENDOFTABLE          0xFFFFFFFF
 
 /* records in properties table */
@@ -176,6 +179,8 @@
 #define TCODE_SETTINGS_ATTRIBUTES             (TCODE_TABLEREC | TCODE_CRC   | 0x0134)
 /* 2016-Nov-28 RH-33298 MYON_3dmRenderSettings user data in MYON_3dmSettings.m_RenderSettings */
 #define TCODE_SETTINGS_RENDER_USERDATA (TCODE_TABLEREC | TCODE_CRC | 0x0136)
+/* bounding box of the model geometry - optional first record in the settings table */
+#define TCODE_SETTINGS_MODEL_GEOMETRY_BBOX (TCODE_TABLEREC | TCODE_CRC | 0x0137)
 
 /* views are subrecords in the settings table */
 #define TCODE_VIEW_RECORD            (TCODE_TABLEREC | TCODE_CRC   | 0x003B)
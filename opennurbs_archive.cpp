@@ -28,6 +28,17 @@
 #include "opennurbs_internal_V2_annotation.h"
 #include "opennurbs_internal_V5_annotation.h"
 
+#if !defined(MYON_RUNTIME_WIN)
+// mmap() is used by MYON_BinaryMappedFile
+#include <sys/mman.h>
+#endif
+
+// std::map, std::vector and std::sort are used by MYON_BinaryArchiveProfile
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <condition_variable>
+
 const MYON_String Internal_RuntimeEnvironmentToString(
   MYON::RuntimeEnvironment runtime_environment
 )
@@ -261,6 +272,172 @@ struct MYON__3dmV1LayerIndex
   struct MYON__3dmV1LayerIndex* m_next;
 };
 
+class MYON_BinaryArchiveProfile
+{
+public:
+  MYON_BinaryArchiveProfile() = default;
+  ~MYON_BinaryArchiveProfile() = default;
+
+  static double Clock()
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  class Item
+  {
+  public:
+    MYON__UINT64 m_count = 0;
+    MYON__UINT64 m_byte_count = 0;
+    double m_total_seconds = 0.0;
+    double m_self_seconds = 0.0;
+    double m_compression_seconds = 0.0;
+  };
+
+  class Frame
+  {
+  public:
+    double m_start_time;
+    double m_nested_seconds;
+    double m_compression_seconds;
+    // m_chunk.Count() after the chunk was pushed (0 for objects)
+    int m_depth;
+  };
+
+  void BeginFrame(MYON_SimpleArray<Frame>& frames, int depth)
+  {
+    Frame& frame = frames.AppendNew();
+    frame.m_start_time = Clock();
+    frame.m_nested_seconds = 0.0;
+    frame.m_compression_seconds = 0.0;
+    frame.m_depth = depth;
+  }
+
+  void EndFrame(MYON_SimpleArray<Frame>& frames, Item& item, MYON__UINT64 byte_count)
+  {
+    const Frame frame = *frames.Last();
+    frames.Remove();
+    const double seconds = Clock() - frame.m_start_time;
+    item.m_count++;
+    item.m_byte_count += byte_count;
+    item.m_total_seconds += seconds;
+    item.m_self_seconds += seconds - frame.m_nested_seconds;
+    item.m_compression_seconds += frame.m_compression_seconds;
+    if (frames.Count() > 0)
+      frames.Last()->m_nested_seconds += seconds;
+  }
+
+  template <class KEY>
+  static void DumpItems(MYON_TextLog& text_log, const std::map<KEY, Item>& items, const char*(*name)(KEY), double seconds)
+  {
+    // sort by self time
+    std::vector<std::pair<KEY, Item>> sorted(items.begin(), items.end());
+    std::sort(sorted.begin(), sorted.end(), 
+      [](const std::pair<KEY, Item>& a, const std::pair<KEY, Item>& b) { return a.second.m_self_seconds > b.second.m_self_seconds; }
+    );
+    text_log.PushIndent();
+    text_log.Print("self%%  self sec  total sec  compress sec       count          bytes  name\n");
+    for (const auto& it : sorted)
+    {
+      const Item& item = it.second;
+      text_log.Print(
+        "%5.1f %9.4f %10.4f %13.4f %11llu %14llu  %s\n",
+        (seconds > 0.0) ? (100.0 * item.m_self_seconds / seconds) : 0.0,
+        item.m_self_seconds,
+        item.m_total_seconds,
+        item.m_compression_seconds,
+        (unsigned long long)item.m_count,
+        (unsigned long long)item.m_byte_count,
+        name(it.first)
+      );
+    }
+    text_log.PopIndent();
+  }
+
+  static void MergeItem(Item& dst, const Item& src)
+  {
+    dst.m_count += src.m_count;
+    dst.m_byte_count += src.m_byte_count;
+    dst.m_total_seconds += src.m_total_seconds;
+    dst.m_self_seconds += src.m_self_seconds;
+    dst.m_compression_seconds += src.m_compression_seconds;
+  }
+
+  // Adds the items recorded by an archive that decoded objects on another thread.
+  void Merge(const MYON_BinaryArchiveProfile& src)
+  {
+    m_merge_lock.GetLock(MYON_SleepLock::OneMillisecond, 0);
+    for (const auto& it : src.m_chunk_items)
+      MergeItem(m_chunk_items[it.first], it.second);
+    for (const auto& it : src.m_class_items)
+      MergeItem(m_class_items[it.first], it.second);
+    MergeItem(m_compression, src.m_compression);
+    m_merge_lock.ReturnLock();
+  }
+
+  double m_start_time = Clock();
+  double m_stop_time = 0.0;
+  MYON_SleepLock m_merge_lock;
+
+  std::map<MYON__UINT32, Item> m_chunk_items;
+  std::map<const MYON_ClassId*, Item> m_class_items;
+  Item m_compression;
+
+  MYON_SimpleArray<Frame> m_chunk_frames;
+  MYON_SimpleArray<Frame> m_object_frames;
+  double m_compression_start_time = 0.0;
+};
+
+// MYON_3dmObjectDeduplication is used by MYON_BinaryArchive::SetDeduplicateGeometry()
+// and when reading archives that contain object references.
+class MYON_3dmObjectDeduplication
+{
+public:
+  MYON_3dmObjectDeduplication() = default;
+  ~MYON_3dmObjectDeduplication();
+
+  class Source
+  {
+  public:
+    // archive offset of the TCODE_OPENNURBS_CLASS chunk
+    MYON__UINT64 m_offset = 0;
+    // size of the TCODE_OPENNURBS_CLASS chunk including the header
+    size_t m_size = 0;
+  };
+
+  class HashLess
+  {
+  public:
+    bool operator()(const MYON_SHA1_Hash& a, const MYON_SHA1_Hash& b) const
+    {
+      return MYON_SHA1_Hash::Compare(a, b) < 0;
+    }
+  };
+
+  // writing: content hash -> first object written with that content
+  std::map<MYON_SHA1_Hash, Source, HashLess> m_written;
+
+  // reading: TCODE_OPENNURBS_CLASS chunk offset -> decoded object shared
+  // by the records that reference it
+  std::map<MYON__UINT64, std::shared_ptr<MYON_Object> > m_decoded;
+
+private:
+  MYON_3dmObjectDeduplication(const MYON_3dmObjectDeduplication&) = delete;
+  MYON_3dmObjectDeduplication& operator=(const MYON_3dmObjectDeduplication&) = delete;
+};
+
+MYON_3dmObjectDeduplication::~MYON_3dmObjectDeduplication()
+{
+  // This destructor is explictily implemented to insure the decoded objects
+  // are destroyed by the same c-runtime that creates them.
+  m_decoded.clear();
+}
+
+// Class uuid written in the TCODE_OPENNURBS_CLASS_UUID chunk of an object
+// reference. No class has this uuid, so versions of opennurbs that do not
+// resolve references silently discard the record's object.
+// 295B4806-0BCA-454F-9B59-58A14D57F9AD
+static const MYON_UUID MYON_3dmObjectReference_class_uuid = { 0x295b4806, 0x0bca, 0x454f, { 0x9b, 0x59, 0x58, 0xa1, 0x4d, 0x57, 0xf9, 0xad } };
+
 MYON_BinaryArchive::MYON_BinaryArchive( MYON::archive_mode mode )
   : m_mode(mode)
 {
@@ -295,10 +472,18 @@ MYON_BinaryArchive::~MYON_BinaryArchive()
     }
   }
 
-  if (nullptr != m_compressor)
+  Internal_ReleaseCompressor();
+
+  if (nullptr != m_profile)
+  {
+    delete m_profile;
+    m_profile = nullptr;
+  }
+
+  if (nullptr != m_deduplication)
   {
-    CompressionEnd();
-    onfree(m_compressor);
+    delete m_deduplication;
+    m_deduplication = nullptr;
   }
 
   MYON_3dmTableStatusLink* next = m_3dm_table_status_list;
@@ -4760,7 +4945,12 @@ bool MYON_BinaryArchive::Internal_WriteObject(
     // TCODE_OPENNURBS_CLASS_DATA chunk contains definition of class
     if (false == BeginWrite3dmChunk(TCODE_OPENNURBS_CLASS_DATA, 0))
       break;
+    const MYON__UINT64 data_offset = m_bProfilingEnabled ? CurrentPosition() : 0;
+    if (m_bProfilingEnabled)
+      Internal_ProfileBeginObject();
     bool bChunkDataOk = model_object.Write(*this) ? true : false;
+    if (m_bProfilingEnabled)
+      Internal_ProfileEndObject(pID, CurrentPosition() - data_offset);
     if (false == bChunkDataOk)
     {
       MYON_ERROR("archive_object->Write() failed.");
@@ -4861,6 +5051,8 @@ bool MYON_BinaryArchive::WriteObjectUserData( const MYON_Object& object )
       continue;
     if (0 == MYON_UuidCompare(userdata_classid, MYON_CLASS_ID(MYON_UnknownUserData)))
       continue;
+    if (0 == MYON_UuidCompare(userdata_classid, MYON_CLASS_ID(MYON_UnknownUserDataReference)))
+      continue;
     if (0 == MYON_UuidCompare(userdata_classid, MYON_CLASS_ID(MYON_ObsoleteUserData)))
       continue;
 
@@ -5218,7 +5410,12 @@ int MYON_BinaryArchive::ReadObjectHelper( MYON_Object** ppObject )
         }
         else 
         {
-          if ( false == (pObject->Read(*this) ? true : false) ) 
+          if (m_bProfilingEnabled)
+            Internal_ProfileBeginObject();
+          const bool bObjectRead = pObject->Read(*this) ? true : false;
+          if (m_bProfilingEnabled)
+            Internal_ProfileEndObject(pID, (MYON__UINT64)length_TCODE_OPENNURBS_CLASS_DATA);
+          if ( false == bObjectRead ) 
           {
             rc = 0;
             MYON_ERROR("MYON_BinaryArchive::ReadObject() pObject->Read() failed.");
@@ -5644,7 +5841,10 @@ bool MYON_BinaryArchive::ReadObjectUserData( MYON_Object& object )
           // not available.  This information will be stored
           // in an MYON_UnknownUserData class so that it can
           // persist.
-          udId = &MYON_CLASS_RTTI(MYON_UnknownUserData);
+          udId 
+            = (nullptr != m_unknown_user_data_reference_owner.get())
+            ? &MYON_CLASS_RTTI(MYON_UnknownUserDataReference)
+            : &MYON_CLASS_RTTI(MYON_UnknownUserData);
         }
       }
 
@@ -6001,6 +6201,8 @@ MYON_BinaryArchive::EndWrite3dmChunk()
       rc = true;
     }
 
+    if (m_bProfilingEnabled)
+      Internal_ProfileEndChunk();
     m_chunk.Remove();
     c = m_chunk.Last();
     if ( nullptr == c )
@@ -6663,6 +6865,8 @@ bool MYON_BinaryArchive::EndRead3dmChunk(bool bSupressPartiallyReadChunkWarning)
 
     }
 
+    if (m_bProfilingEnabled)
+      Internal_ProfileEndChunk();
     m_chunk.Remove();
     c = m_chunk.Last();
     m_bDoChunkCRC = (c && (c->m_do_crc16 || c->m_do_crc32));
@@ -7188,6 +7392,9 @@ bool MYON_BinaryArchive::PushBigChunk( MYON__UINT32 typecode, MYON__INT64 big_va
     m_chunk.Reserve(128);
   m_chunk.Append( c );
 
+  if (m_bProfilingEnabled)
+    Internal_ProfileBeginChunk();
+
   return true;
 }
 
@@ -7263,6 +7470,180 @@ bool MYON_BinaryArchive::UseBufferCompression() const
 {
   return m_bUseBufferCompression;
 }
+
+void MYON_BinaryArchive::SetCompressionThreadCount(
+  unsigned int thread_count
+)
+{
+  m_compression_thread_count = thread_count;
+}
+
+unsigned int MYON_BinaryArchive::CompressionThreadCount() const
+{
+  return m_compression_thread_count;
+}
+
+void MYON_BinaryArchive::SetDeduplicateGeometry(
+  bool bDeduplicateGeometry
+)
+{
+  m_bDeduplicateGeometry = bDeduplicateGeometry ? true : false;
+}
+
+void MYON_BinaryArchive::SetUnknownUserDataReferenceOwner(
+  const std::shared_ptr<const void>& archive_memory_owner
+  )
+{
+  m_unknown_user_data_reference_owner = archive_memory_owner;
+}
+
+const std::shared_ptr<const void>& MYON_BinaryArchive::UnknownUserDataReferenceOwner() const
+{
+  return m_unknown_user_data_reference_owner;
+}
+
+bool MYON_BinaryArchive::DeduplicateGeometry() const
+{
+  return m_bDeduplicateGeometry;
+}
+
+void MYON_BinaryArchive::SetMeshQuantizationTolerance(
+  double mesh_quantization_tolerance
+)
+{
+  m_mesh_quantization_tolerance
+    = (MYON_IsValid(mesh_quantization_tolerance) && mesh_quantization_tolerance > 0.0)
+    ? mesh_quantization_tolerance
+    : 0.0;
+}
+
+double MYON_BinaryArchive::MeshQuantizationTolerance() const
+{
+  return m_mesh_quantization_tolerance;
+}
+
+void MYON_BinaryArchive::SetCompactMeshFaces(
+  bool bCompactMeshFaces
+)
+{
+  m_bCompactMeshFaces = bCompactMeshFaces ? true : false;
+}
+
+bool MYON_BinaryArchive::CompactMeshFaces() const
+{
+  return m_bCompactMeshFaces;
+}
+
+void MYON_BinaryArchive::EnableProfiling(
+  bool bEnable
+)
+{
+  if (bEnable)
+  {
+    delete m_profile;
+    m_profile = new MYON_BinaryArchiveProfile();
+    m_bProfilingEnabled = true;
+  }
+  else if (m_bProfilingEnabled)
+  {
+    m_bProfilingEnabled = false;
+    m_profile->m_stop_time = MYON_BinaryArchiveProfile::Clock();
+  }
+}
+
+bool MYON_BinaryArchive::ProfilingEnabled() const
+{
+  return m_bProfilingEnabled;
+}
+
+void MYON_BinaryArchive::Internal_ProfileBeginChunk()
+{
+  m_profile->BeginFrame(m_profile->m_chunk_frames, m_chunk.Count());
+}
+
+void MYON_BinaryArchive::Internal_ProfileEndChunk()
+{
+  // Called before m_chunk.Remove(). Frames for chunks that were removed 
+  // without calling EndRead3dmChunk()/EndWrite3dmChunk() are discarded.
+  const int depth = m_chunk.Count();
+  MYON_SimpleArray<MYON_BinaryArchiveProfile::Frame>& frames = m_profile->m_chunk_frames;
+  while (frames.Count() > 0 && frames.Last()->m_depth > depth)
+    frames.Remove();
+  const MYON_3DM_BIG_CHUNK* c = m_chunk.Last();
+  if (nullptr == c || 0 == frames.Count() || frames.Last()->m_depth != depth)
+    return;
+  m_profile->EndFrame(
+    frames, 
+    m_profile->m_chunk_items[c->m_typecode], 
+    c->m_bLongChunk ? c->Length() : 0
+  );
+}
+
+void MYON_BinaryArchive::Internal_ProfileBeginObject()
+{
+  m_profile->BeginFrame(m_profile->m_object_frames, 0);
+}
+
+void MYON_BinaryArchive::Internal_ProfileEndObject(const MYON_ClassId* class_id, MYON__UINT64 byte_count)
+{
+  if (m_profile->m_object_frames.Count() > 0)
+    m_profile->EndFrame(m_profile->m_object_frames, m_profile->m_class_items[class_id], byte_count);
+}
+
+void MYON_BinaryArchive::Internal_ProfileBeginCompression()
+{
+  m_profile->m_compression_start_time = MYON_BinaryArchiveProfile::Clock();
+}
+
+void MYON_BinaryArchive::Internal_ProfileEndCompression()
+{
+  const double seconds = MYON_BinaryArchiveProfile::Clock() - m_profile->m_compression_start_time;
+  m_profile->m_compression.m_count++;
+  m_profile->m_compression.m_compression_seconds += seconds;
+  if (m_profile->m_chunk_frames.Count() > 0)
+    m_profile->m_chunk_frames.Last()->m_compression_seconds += seconds;
+  if (m_profile->m_object_frames.Count() > 0)
+    m_profile->m_object_frames.Last()->m_compression_seconds += seconds;
+}
+
+static const char* Internal_ProfileTypecodeName(MYON__UINT32 typecode)
+{
+  const char* name = MYON_BinaryArchive::TypecodeName(typecode);
+  return (nullptr != name) ? name : "unknown typecode";
+}
+
+static const char* Internal_ProfileClassName(const MYON_ClassId* class_id)
+{
+  const char* name = (nullptr != class_id) ? class_id->ClassName() : nullptr;
+  return (nullptr != name) ? name : "unknown class";
+}
+
+void MYON_BinaryArchive::DumpProfile(
+  MYON_TextLog& text_log
+) const
+{
+  if (nullptr == m_profile)
+  {
+    text_log.Print("Profiling was not enabled.\n");
+    return;
+  }
+
+  const double seconds 
+    = (m_bProfilingEnabled ? MYON_BinaryArchiveProfile::Clock() : m_profile->m_stop_time)
+    - m_profile->m_start_time;
+  text_log.Print("Binary archive profile: %g seconds\n", seconds);
+  text_log.PushIndent();
+  text_log.Print(
+    "Compressed buffers: %llu, %g seconds\n", 
+    (unsigned long long)m_profile->m_compression.m_count, 
+    m_profile->m_compression.m_compression_seconds
+  );
+  text_log.Print("Chunks by typecode:\n");
+  MYON_BinaryArchiveProfile::DumpItems<MYON__UINT32>(text_log, m_profile->m_chunk_items, Internal_ProfileTypecodeName, seconds);
+  text_log.Print("Objects by class:\n");
+  MYON_BinaryArchiveProfile::DumpItems<const MYON_ClassId*>(text_log, m_profile->m_class_items, Internal_ProfileClassName, seconds);
+  text_log.PopIndent();
+}
   
 void MYON_BinaryArchive::SetSave3dmPreviewImage(
   bool bSave3dmPreviewImage
@@ -8533,6 +8914,14 @@ bool MYON_BinaryArchive::Read3dmProperties( MYON_3dmProperties& prop )
 bool MYON_BinaryArchive::Write3dmSettings(
       const MYON_3dmSettings& settings
       )
+{
+  return Write3dmSettings(settings, MYON_BoundingBox::UnsetBoundingBox);
+}
+
+bool MYON_BinaryArchive::Write3dmSettings(
+  const MYON_3dmSettings& settings,
+  const MYON_BoundingBox& model_geometry_bbox
+  )
 {
   if (!Begin3dmTable(MYON::archive_mode::write3dm,MYON_3dmArchiveTableType::settings_table))
     return false;
@@ -8546,7 +8935,19 @@ bool MYON_BinaryArchive::Write3dmSettings(
   // version 2+ file settings chunk
   bool rc = BeginWrite3dmChunk(TCODE_SETTINGS_TABLE,0);
   if ( rc ) {
-    rc = settings.Write( *this );
+    if ( model_geometry_bbox.IsValid() && Archive3dmVersion() >= 2 )
+    {
+      // MYON_3dmSettings::Read() skips this record.
+      rc = BeginWrite3dmChunk(TCODE_SETTINGS_MODEL_GEOMETRY_BBOX, 0);
+      if (rc)
+      {
+        rc = WriteBoundingBox(model_geometry_bbox);
+        if (!EndWrite3dmChunk())
+          rc = false;
+      }
+    }
+    if ( rc )
+      rc = settings.Write( *this );
     if ( !EndWrite3dmChunk() )
       rc = false;
   }
@@ -8597,6 +8998,17 @@ bool MYON_BinaryArchive::Write3dmSettings(
 
 bool MYON_BinaryArchive::Read3dmSettings( MYON_3dmSettings& settings )
 {
+  return Read3dmSettings(settings, nullptr);
+}
+
+bool MYON_BinaryArchive::Read3dmSettings(
+  MYON_3dmSettings& settings,
+  MYON_BoundingBox* model_geometry_bbox
+  )
+{
+  if (nullptr != model_geometry_bbox)
+    *model_geometry_bbox = MYON_BoundingBox::UnsetBoundingBox;
+
   if (!Begin3dmTable(MYON::archive_mode::read3dm,MYON_3dmArchiveTableType::settings_table))
     return false;
 
@@ -8624,8 +9036,26 @@ bool MYON_BinaryArchive::Read3dmSettings( MYON_3dmSettings& settings )
       if ( !rc )
         break;
       if ( tcode == TCODE_SETTINGS_TABLE ) {
+        MYON__UINT32 bbox_tcode = 0;
+        MYON__INT64 bbox_value = 0;
+        if ( nullptr != model_geometry_bbox
+          && PeekAt3dmBigChunkType(&bbox_tcode, &bbox_value)
+          && TCODE_SETTINGS_MODEL_GEOMETRY_BBOX == bbox_tcode
+          )
+        {
+          rc = BeginRead3dmBigChunk(&bbox_tcode, &bbox_value);
+          if (rc)
+          {
+            MYON_BoundingBox bbox;
+            if (ReadBoundingBox(bbox) && bbox.IsValid())
+              *model_geometry_bbox = bbox;
+            if (!EndRead3dmChunk())
+              rc = false;
+          }
+        }
         // version 2 model settings
-        rc = settings.Read(*this);
+        if (rc)
+          rc = settings.Read(*this);
       }
       if ( !EndRead3dmChunk() ) {
         rc = false;
@@ -13170,10 +13600,123 @@ bool MYON_BinaryArchive::Write3dmModelGeometryComponent(
   return rc;
 }
 
+static bool Internal_ObjectTypeIsSelfContained( MYON__INT64 object_type )
+{
+  // Objects of these types do not reference the archive's component
+  // tables or annotation context while they are read or written, so 
+  // they can be decoded or encoded by a separate archive on another thread.
+  switch ( object_type )
+  {
+  case MYON::point_object:
+  case MYON::pointset_object:
+  case MYON::curve_object:
+  case MYON::surface_object:
+  case MYON::brep_object:
+  case MYON::extrusion_object:
+  case MYON::mesh_object:
+  case MYON::subd_object:
+    return true;
+  default:
+    break;
+  }
+  return false;
+}
+
+MYON_3dmEncodedObject::~MYON_3dmEncodedObject()
+{
+  Destroy();
+}
+
+void MYON_3dmEncodedObject::Destroy()
+{
+  if ( nullptr != m_buffer )
+  {
+    onfree(m_buffer);
+    m_buffer = nullptr;
+  }
+  m_sizeof_buffer = 0;
+}
+
+bool MYON_3dmEncodedObject::IsEncoded() const
+{
+  return (nullptr != m_buffer && m_sizeof_buffer > 0);
+}
+
+size_t MYON_3dmEncodedObject::SizeOfSerializedObject() const
+{
+  return m_sizeof_buffer;
+}
+
 bool MYON_BinaryArchive::Write3dmObject( 
           const MYON_Object& object, 
           const MYON_3dmObjectAttributes* attributes 
           )
+{
+  return Internal_Write3dmObject(object, attributes, nullptr);
+}
+
+bool MYON_BinaryArchive::Write3dmObjectForExperts(
+  const MYON_Object& object,
+  const MYON_3dmObjectAttributes* attributes,
+  const MYON_3dmEncodedObject& encoded_object
+  )
+{
+  return Internal_Write3dmObject(object, attributes, encoded_object.IsEncoded() ? &encoded_object : nullptr);
+}
+
+bool MYON_BinaryArchive::Encode3dmObject(
+  const MYON_Object& object,
+  MYON_3dmEncodedObject& encoded_object
+  ) const
+{
+  encoded_object.Destroy();
+
+  // V1 and V2 archives write point clouds as points (see Internal_Write3dmObject()).
+  if ( false == WriteMode() || Archive3dmVersion() < 3 )
+    return false;
+
+  if ( false == Internal_ObjectTypeIsSelfContained(object.ObjectType()) )
+    return false;
+
+  MYON_Write3dmBufferArchive buffer_archive(0, 0, Archive3dmVersion(), ArchiveOpenNURBSVersion());
+
+  // The encoding archive needs the settings that affect how objects are written.
+  MYON_BinaryArchive& archive = buffer_archive;
+  archive.m_archive_runtime_environment = m_archive_runtime_environment;
+  archive.m_user_data_filter = m_user_data_filter;
+  archive.m_error_message_mask = m_error_message_mask;
+  archive.m_save_3dm_render_mesh_flags = m_save_3dm_render_mesh_flags;
+  archive.m_save_3dm_analysis_mesh_flags = m_save_3dm_analysis_mesh_flags;
+  archive.m_bUseBufferCompression = m_bUseBufferCompression;
+  archive.m_mesh_quantization_tolerance = m_mesh_quantization_tolerance;
+  archive.m_bCompactMeshFaces = m_bCompactMeshFaces;
+  // Objects are encoded on multiple threads, so each buffer is compressed on one.
+  archive.m_compression_thread_count = 1;
+  if (m_bProfilingEnabled)
+    archive.EnableProfiling(true);
+
+  bool rc = archive.WriteObject(object);
+  if (m_bProfilingEnabled && nullptr != archive.m_profile)
+    m_profile->Merge(*archive.m_profile);
+
+  if ( rc && 0 == archive.CriticalErrorCount() && buffer_archive.SizeOfArchive() > 0 )
+  {
+    encoded_object.m_sizeof_buffer = buffer_archive.SizeOfArchive();
+    encoded_object.m_buffer = buffer_archive.HarvestBuffer();
+    if (m_bDeduplicateGeometry)
+      encoded_object.m_content_hash = MYON_SHA1_Hash::BufferContentHash(encoded_object.m_buffer, encoded_object.m_sizeof_buffer);
+  }
+  else
+    rc = false;
+
+  return rc;
+}
+
+bool MYON_BinaryArchive::Internal_Write3dmObject(
+  const MYON_Object& object,
+  const MYON_3dmObjectAttributes* attributes,
+  const MYON_3dmEncodedObject* encoded_object
+  )
 {
   if ( false == Internal_Begin3dmTableRecord(MYON_3dmArchiveTableType::object_table) )
     return false;
@@ -13218,7 +13761,43 @@ bool MYON_BinaryArchive::Write3dmObject(
       }
 
       // WriteObject writes TCODE_OPENNURBS_CLASS chunk that contains object definition
-      rc = WriteObject( object );
+      MYON_3dmEncodedObject local_encoded_object;
+      if ( nullptr == encoded_object && m_bDeduplicateGeometry && Encode3dmObject(object, local_encoded_object) )
+        encoded_object = &local_encoded_object;
+
+      const MYON_3dmObjectDeduplication::Source* source = nullptr;
+      if ( nullptr != encoded_object && m_bDeduplicateGeometry )
+      {
+        if ( nullptr == m_deduplication )
+          m_deduplication = new MYON_3dmObjectDeduplication();
+        const auto it = m_deduplication->m_written.find(encoded_object->m_content_hash);
+        if ( it != m_deduplication->m_written.end() && it->second.m_size == encoded_object->m_sizeof_buffer )
+          source = &it->second;
+      }
+
+      if ( nullptr != source )
+      {
+        // identical object was written earlier in the object table
+        rc = Internal_Write3dmObjectReference(source->m_offset, source->m_size);
+      }
+      else if ( nullptr != encoded_object )
+      {
+        // The encoded TCODE_OPENNURBS_CLASS chunk has its own length and CRC.
+        // Nested chunks are not included in the CRC of the parent chunk.
+        const MYON__UINT64 class_offset = CurrentPosition();
+        const bool bDoChunkCRC = m_bDoChunkCRC;
+        m_bDoChunkCRC = false;
+        rc = WriteByte(encoded_object->m_sizeof_buffer, encoded_object->m_buffer);
+        m_bDoChunkCRC = bDoChunkCRC;
+        if ( rc && m_bDeduplicateGeometry && nullptr != m_deduplication )
+        {
+          MYON_3dmObjectDeduplication::Source& written = m_deduplication->m_written[encoded_object->m_content_hash];
+          written.m_offset = class_offset;
+          written.m_size = encoded_object->m_sizeof_buffer;
+        }
+      }
+      else
+        rc = WriteObject( object );
 
       // optional TCODE_OBJECT_RECORD_ATTRIBUTES chunk
       if ( rc && nullptr != attributes ) {
@@ -13294,34 +13873,296 @@ bool MYON_BinaryArchive::Write3dmObject(
   return rc;
 }
 
-bool MYON_BinaryArchive::EndWrite3dmObjectTable()
-{
-  return EndWrite3dmTable( TCODE_OBJECT_TABLE );
-}
-
-bool MYON_BinaryArchive::BeginRead3dmObjectTable()
-{
-  m_3dm_v1_material_index = 0;
-  return BeginRead3dmTable( TCODE_OBJECT_TABLE );
-}
-
-bool MYON_BinaryArchive::ReadV1_TCODE_RH_POINT(
-  MYON_Object** ppObject,
-  MYON_3dmObjectAttributes* pAttributes
+bool MYON_BinaryArchive::Internal_Write3dmObjectReference(
+  MYON__UINT64 source_offset,
+  size_t sizeof_source
   )
 {
-  MYON__UINT64 pos0 = 0;
-  MYON_3DM_BIG_CHUNK* point_chunk = m_chunk.Last();
-
-  if (    0 != point_chunk 
-       && TCODE_RH_POINT == point_chunk->m_typecode 
-       && 0 == point_chunk->m_big_value )
+  // An object reference is a TCODE_OPENNURBS_CLASS chunk with the
+  // MYON_3dmObjectReference_class_uuid class id. The data chunk saves 
+  // the distance from this chunk back to the referenced TCODE_OPENNURBS_CLASS
+  // chunk, so the reference does not depend on where the object table starts.
+  const MYON__UINT64 offset = CurrentPosition();
+  if ( source_offset >= offset || 0 == sizeof_source )
   {
-    // Some early V1 files have TCODE_RH_POINT chunks with arrow xdata
-    // attached have a length set to zero.
-    // For these chunks we need to set the chunk length so EndRead3dmChunk()
-    // will keep going.
-    pos0 = CurrentPosition();
+    MYON_ERROR("Invalid object reference.");
+    return false;
+  }
+
+  if (false == BeginWrite3dmChunk(TCODE_OPENNURBS_CLASS, 0))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    if (false == BeginWrite3dmChunk(TCODE_OPENNURBS_CLASS_UUID, 0))
+      break;
+    bool bChunkIdOk = WriteUuid(MYON_3dmObjectReference_class_uuid);
+    if (false == EndWrite3dmChunk())
+      bChunkIdOk = false;
+    if (false == bChunkIdOk)
+      break;
+
+    if (false == BeginWrite3dmChunk(TCODE_OPENNURBS_CLASS_DATA, 0))
+      break;
+    bool bChunkDataOk = Write3dmChunkVersion(1, 0);
+    if (bChunkDataOk)
+      bChunkDataOk = WriteBigInt((MYON__UINT64)(offset - source_offset));
+    if (bChunkDataOk)
+      bChunkDataOk = WriteBigSize(sizeof_source);
+    if (false == EndWrite3dmChunk())
+      bChunkDataOk = false;
+    if (false == bChunkDataOk)
+      break;
+
+    if (false == BeginWrite3dmChunk(TCODE_OPENNURBS_CLASS_END, 0))
+      break;
+    if (false == EndWrite3dmChunk())
+      break;
+
+    rc = true;
+    break;
+  }
+
+  if (false == EndWrite3dmChunk()) // end of TCODE_OPENNURBS_CLASS chunk
+    rc = false;
+
+  return rc;
+}
+
+int MYON_BinaryArchive::Internal_Read3dmObjectReference(
+  MYON_Object** ppObject,
+  std::shared_ptr<MYON_Object>* shared_object
+  )
+{
+  // Returns:
+  //   0: the next chunk is not an object reference and the archive position is unchanged.
+  //   1: the reference was resolved. When shared_object is not nullptr, the 
+  //      referenced object is returned there. Otherwise a copy is returned.
+  //   3: the referenced object's class is not registered.
+  //  -1: the archive is corrupt.
+
+  // Object references are small TCODE_OPENNURBS_CLASS chunks.
+  // Larger chunks are objects and are not looked at.
+  const size_t max_sizeof_reference = 256;
+  MYON__UINT32 tcode = 0;
+  MYON__INT64 length_TCODE_OPENNURBS_CLASS = 0;
+  if ( false == PeekAt3dmBigChunkType(&tcode, &length_TCODE_OPENNURBS_CLASS) 
+    || TCODE_OPENNURBS_CLASS != tcode
+    || length_TCODE_OPENNURBS_CLASS <= 0
+    || length_TCODE_OPENNURBS_CLASS > (MYON__INT64)max_sizeof_reference
+    )
+    return 0;
+
+  const MYON__UINT64 offset = CurrentPosition();
+  const size_t sizeof_chunk = (size_t)(4 + SizeofChunkLength()) + (size_t)length_TCODE_OPENNURBS_CLASS;
+  unsigned char chunk[2*max_sizeof_reference];
+
+  const bool bDoChunkCRC = m_bDoChunkCRC;
+  m_bDoChunkCRC = false;
+  bool rc = ReadByte(sizeof_chunk, chunk);
+  m_bDoChunkCRC = bDoChunkCRC;
+  if (false == rc)
+    return -1;
+
+  bool bIsReference = false;
+  MYON__UINT64 back_offset = 0;
+  size_t sizeof_source = 0;
+  {
+    MYON_Read3dmBufferArchive reference_archive(sizeof_chunk, chunk, false, Archive3dmVersion(), ArchiveOpenNURBSVersion());
+    MYON__INT64 length = 0;
+    MYON_UUID class_uuid = MYON_nil_uuid;
+    if (reference_archive.BeginRead3dmBigChunk(&tcode, &length))
+    {
+      if (reference_archive.BeginRead3dmBigChunk(&tcode, &length))
+      {
+        if (TCODE_OPENNURBS_CLASS_UUID == tcode && reference_archive.ReadUuid(class_uuid))
+          bIsReference = (MYON_3dmObjectReference_class_uuid == class_uuid);
+        reference_archive.EndRead3dmChunk();
+      }
+      if (bIsReference)
+      {
+        rc = false;
+        if (reference_archive.BeginRead3dmBigChunk(&tcode, &length))
+        {
+          int major_version = 0;
+          int minor_version = 0;
+          if (TCODE_OPENNURBS_CLASS_DATA == tcode
+            && reference_archive.Read3dmChunkVersion(&major_version, &minor_version)
+            && 1 == major_version
+            && reference_archive.ReadBigInt(&back_offset)
+            && reference_archive.ReadBigSize(&sizeof_source)
+            )
+            rc = true;
+          if (false == reference_archive.EndRead3dmChunk())
+            rc = false;
+        }
+      }
+      // The remaining chunks are skipped by ending the class chunk.
+      if (false == reference_archive.EndRead3dmChunk() && bIsReference)
+        rc = false;
+    }
+  }
+
+  if (false == bIsReference)
+  {
+    // this is an object - put the archive back where it was
+    return SeekBackward(sizeof_chunk) ? 0 : -1;
+  }
+
+  // The referenced TCODE_OPENNURBS_CLASS chunk must be in the active 
+  // object table and end before this record's reference.
+  MYON__UINT64 object_table_start_offset = 0;
+  for (int i = 0; i < m_chunk.Count(); i++)
+  {
+    if (TCODE_OBJECT_TABLE == m_chunk[i].m_typecode)
+    {
+      object_table_start_offset = m_chunk[i].m_start_offset;
+      break;
+    }
+  }
+  const MYON__UINT64 source_offset = offset - back_offset;
+  if (false == rc 
+    || 0 == back_offset 
+    || back_offset > offset 
+    || 0 == object_table_start_offset
+    || source_offset < object_table_start_offset
+    || sizeof_source < (size_t)(4 + SizeofChunkLength())
+    || sizeof_source > back_offset
+    )
+  {
+    MYON_ERROR("Invalid object reference.");
+    return -1;
+  }
+
+  if (nullptr == m_deduplication)
+    m_deduplication = new MYON_3dmObjectDeduplication();
+
+  std::shared_ptr<MYON_Object>& source = m_deduplication->m_decoded[source_offset];
+  if (nullptr == source.get())
+  {
+    // Read the referenced TCODE_OPENNURBS_CLASS chunk. It is before the 
+    // current chunk, so chunk boundary checking is disabled while it is read.
+    MYON_3dmDeferredObject deferred_object;
+    const MYON__UINT64 pos = CurrentPosition();
+    const bool bChunkBoundaryCheck = m_bChunkBoundaryCheck;
+    m_bChunkBoundaryCheck = false;
+    m_bDoChunkCRC = false;
+    bool bSeekOk = SeekBackward(pos - source_offset);
+    if (bSeekOk)
+    {
+      const void* view = ReadByteView(sizeof_source);
+      if (nullptr == view)
+      {
+        deferred_object.m_buffer = onmalloc(sizeof_source);
+        if (nullptr != deferred_object.m_buffer && ReadByte(sizeof_source, deferred_object.m_buffer))
+          view = deferred_object.m_buffer;
+      }
+      if (nullptr != view)
+      {
+        deferred_object.m_serialized_object = view;
+        deferred_object.m_sizeof_serialized_object = sizeof_source;
+      }
+      const MYON__UINT64 source_end = CurrentPosition();
+      bSeekOk = (source_end <= pos) ? SeekForward(pos - source_end) : SeekBackward(source_end - pos);
+    }
+    m_bChunkBoundaryCheck = bChunkBoundaryCheck;
+    m_bDoChunkCRC = bDoChunkCRC;
+    if (false == bSeekOk)
+    {
+      m_deduplication->m_decoded.erase(source_offset);
+      return -1;
+    }
+
+    // Before anything is decoded, the bytes must be a single object's 
+    // TCODE_OPENNURBS_CLASS chunk and not another reference.
+    bool bValidSource = false;
+    if (deferred_object.DecodePending())
+    {
+      MYON_Read3dmBufferArchive source_archive(
+        deferred_object.m_sizeof_serialized_object, 
+        deferred_object.m_serialized_object,
+        false, 
+        Archive3dmVersion(), 
+        ArchiveOpenNURBSVersion()
+        );
+      MYON__UINT32 source_tcode = 0;
+      MYON__INT64 source_length = 0;
+      if (source_archive.BeginRead3dmBigChunk(&source_tcode, &source_length))
+      {
+        if (TCODE_OPENNURBS_CLASS == source_tcode
+          && source_length > 0
+          && (MYON__UINT64)(4 + SizeofChunkLength()) + (MYON__UINT64)source_length == (MYON__UINT64)sizeof_source
+          && source_archive.BeginRead3dmBigChunk(&source_tcode, &source_length)
+          )
+        {
+          MYON_UUID class_uuid = MYON_nil_uuid;
+          bValidSource
+            = TCODE_OPENNURBS_CLASS_UUID == source_tcode
+            && source_archive.ReadUuid(class_uuid)
+            && MYON_3dmObjectReference_class_uuid != class_uuid;
+          // The class chunk is not ended, so its CRC is not checked here.
+        }
+      }
+    }
+    if (false == bValidSource)
+    {
+      m_deduplication->m_decoded.erase(source_offset);
+      MYON_ERROR("Invalid object reference.");
+      return -1;
+    }
+
+    Decode3dmDeferredObject(deferred_object);
+    m_crc_error_count += deferred_object.m_crc_error_count;
+    if (deferred_object.m_critical_error_count > 0)
+      Internal_ReportCriticalError();
+
+    if (1 != deferred_object.m_rc || nullptr == deferred_object.m_object)
+    {
+      m_deduplication->m_decoded.erase(source_offset);
+      return (3 == deferred_object.m_rc) ? 3 : -1;
+    }
+
+    source = std::shared_ptr<MYON_Object>(deferred_object.m_object);
+    deferred_object.m_object = nullptr;
+  }
+
+  if (nullptr != shared_object)
+    *shared_object = source;
+  else if (nullptr != ppObject)
+    *ppObject = source->Duplicate();
+
+  return 1;
+}
+
+bool MYON_BinaryArchive::EndWrite3dmObjectTable()
+{
+  return EndWrite3dmTable( TCODE_OBJECT_TABLE );
+}
+
+bool MYON_BinaryArchive::BeginRead3dmObjectTable()
+{
+  m_3dm_v1_material_index = 0;
+  return BeginRead3dmTable( TCODE_OBJECT_TABLE );
+}
+
+bool MYON_BinaryArchive::ReadV1_TCODE_RH_POINT(
+  MYON_Object** ppObject,
+  MYON_3dmObjectAttributes* pAttributes
+  )
+{
+  MYON__UINT64 pos0 = 0;
+  MYON_3DM_BIG_CHUNK* point_chunk = m_chunk.Last();
+
+  if (    0 != point_chunk 
+       && TCODE_RH_POINT == point_chunk->m_typecode 
+       && 0 == point_chunk->m_big_value )
+  {
+    // Some early V1 files have TCODE_RH_POINT chunks with arrow xdata
+    // attached have a length set to zero.
+    // For these chunks we need to set the chunk length so EndRead3dmChunk()
+    // will keep going.
+    pos0 = CurrentPosition();
   }
   else
     point_chunk = 0;
@@ -15703,7 +16544,20 @@ int MYON_BinaryArchive::Read3dmModelGeometryForExperts(
     *model_geometry = nullptr;
   MYON_Object* p = nullptr;
   MYON_3dmObjectAttributes* attributes = new MYON_3dmObjectAttributes();
-  int rc = Read3dmObject(&p, attributes, object_filter);
+  // When the component manages the geometry and attributes, a deduplicated
+  // object is shared instead of copied (see SetDeduplicateGeometry()).
+  std::shared_ptr<MYON_Object> shared;
+  const bool bShare = bManageGeometry && bManageAttributes && nullptr != model_geometry;
+  int rc = Internal_Read3dmObject(&p, attributes, object_filter, nullptr, bShare ? &shared : nullptr);
+  if (nullptr != shared.get())
+  {
+    const std::shared_ptr<MYON_Geometry> geometry_sp(shared, MYON_Geometry::Cast(shared.get()));
+    if (1 == rc)
+      *model_geometry = MYON_ModelGeometryComponent::CreateSharedForExperts(geometry_sp, attributes, nullptr);
+    if (nullptr == *model_geometry)
+      delete attributes;
+    return rc;
+  }
   MYON_Geometry* geometry = MYON_Geometry::Cast(p);
   if (1 == rc && nullptr != geometry)
   {
@@ -15717,14 +16571,254 @@ int MYON_BinaryArchive::Read3dmModelGeometryForExperts(
   return rc;
 }
 
+MYON_3dmDeferredObject::~MYON_3dmDeferredObject()
+{
+  Destroy();
+}
+
+void MYON_3dmDeferredObject::Destroy()
+{
+  if ( nullptr != m_object )
+  {
+    delete m_object;
+    m_object = nullptr;
+  }
+  m_shared_object.reset();
+  if ( nullptr != m_buffer )
+  {
+    onfree(m_buffer);
+    m_buffer = nullptr;
+  }
+  m_serialized_object = nullptr;
+  m_sizeof_serialized_object = 0;
+  m_rc = 0;
+  m_crc_error_count = 0;
+  m_critical_error_count = 0;
+}
+
+bool MYON_3dmDeferredObject::DecodePending() const
+{
+  return (nullptr != m_serialized_object && m_sizeof_serialized_object > 0);
+}
+
+size_t MYON_3dmDeferredObject::SizeOfSerializedObject() const
+{
+  return m_sizeof_serialized_object;
+}
+
+const std::shared_ptr<MYON_Object>& MYON_3dmDeferredObject::SharedObject() const
+{
+  return m_shared_object;
+}
+
+
 int MYON_BinaryArchive::Read3dmObject( 
   MYON_Object** ppObject,                // object is returned here
   MYON_3dmObjectAttributes* pAttributes, // optional - object attributes 
   unsigned int object_filter           // optional filter made by or-ing object_type bits
   )
+{
+  return Internal_Read3dmObject(ppObject, pAttributes, object_filter, nullptr, nullptr);
+}
+
+int MYON_BinaryArchive::Read3dmObjectForExperts(
+  MYON_3dmObjectAttributes* pAttributes,
+  unsigned int object_filter,
+  MYON_3dmDeferredObject& deferred_object
+  )
+{
+  deferred_object.Destroy();
+  const int rc = Internal_Read3dmObject(&deferred_object.m_object, pAttributes, object_filter, &deferred_object, &deferred_object.m_shared_object);
+  deferred_object.m_rc = rc;
+  if ( 1 != rc && nullptr != deferred_object.m_object )
+  {
+    delete deferred_object.m_object;
+    deferred_object.m_object = nullptr;
+  }
+  if ( 1 != rc )
+    deferred_object.m_shared_object.reset();
+  return rc;
+}
+
+bool MYON_BinaryArchive::Decode3dmDeferredObject(
+  MYON_3dmDeferredObject& deferred_object
+  ) const
+{
+  if ( false == deferred_object.DecodePending() )
+    return (1 == deferred_object.m_rc && nullptr != deferred_object.m_object);
+
+  MYON_Read3dmBufferArchive buffer_archive( 
+    deferred_object.m_sizeof_serialized_object,
+    deferred_object.m_serialized_object,
+    false,
+    Archive3dmVersion(),
+    ArchiveOpenNURBSVersion()
+    );
+
+  // The decoding archive needs the settings that affect how objects are read.
+  MYON_BinaryArchive& archive = buffer_archive;
+  archive.m_archive_runtime_environment = m_archive_runtime_environment;
+  archive.m_user_data_filter = m_user_data_filter;
+  archive.m_error_message_mask = m_error_message_mask;
+  if (nullptr == deferred_object.m_buffer)
+  {
+    // The serialized object is in this archive's memory.
+    archive.m_unknown_user_data_reference_owner = m_unknown_user_data_reference_owner;
+  }
+  if (m_bProfilingEnabled)
+    archive.EnableProfiling(true);
+
+  MYON_Object* object = nullptr;
+  const int read_rc = archive.ReadObject(&object);
+  if (m_bProfilingEnabled && nullptr != archive.m_profile)
+    m_profile->Merge(*archive.m_profile);
+  switch ( read_rc )
+  {
+  case 1:
+    deferred_object.m_rc = 1;
+    break;
+  case 3:
+    deferred_object.m_rc = 3; // object's class is not registered
+    break;
+  default:
+    deferred_object.m_rc = -1;
+    break;
+  }
+
+  if ( 1 == deferred_object.m_rc )
+    deferred_object.m_object = object;
+  else if ( nullptr != object )
+    delete object;
+
+  deferred_object.m_crc_error_count = archive.BadCRCCount();
+  deferred_object.m_critical_error_count = archive.CriticalErrorCount();
+
+  if ( nullptr != deferred_object.m_buffer )
+  {
+    onfree(deferred_object.m_buffer);
+    deferred_object.m_buffer = nullptr;
+  }
+  deferred_object.m_serialized_object = nullptr;
+  deferred_object.m_sizeof_serialized_object = 0;
+
+  return (1 == deferred_object.m_rc);
+}
+
+int MYON_BinaryArchive::Finish3dmDeferredObject(
+  MYON_3dmDeferredObject& deferred_object,
+  MYON_Object** ppObject,
+  MYON_3dmObjectAttributes* pAttributes
+  )
+{
+  if ( nullptr != ppObject )
+    *ppObject = nullptr;
+
+  if ( deferred_object.DecodePending() )
+    Decode3dmDeferredObject(deferred_object);
+
+  m_crc_error_count += deferred_object.m_crc_error_count;
+  if ( deferred_object.m_critical_error_count > 0 )
+    Internal_ReportCriticalError();
+
+  if ( 1 == deferred_object.m_rc && nullptr != deferred_object.m_shared_object.get() )
+  {
+    // The record references an object that is shared with other records.
+    if ( nullptr != ppObject )
+      *ppObject = deferred_object.m_shared_object->Duplicate();
+    deferred_object.Destroy();
+    Internal_Finish3dmObject(nullptr, pAttributes);
+    return 1;
+  }
+
+  int rc = deferred_object.m_rc;
+  MYON_Object* object = deferred_object.m_object;
+  deferred_object.m_object = nullptr;
+  deferred_object.Destroy();
+
+  if ( 1 == rc && nullptr == object )
+    rc = -1;
+
+  if ( 1 == rc )
+    Internal_Finish3dmObject(&object, pAttributes);
+
+  if ( 1 != rc && nullptr != object )
+  {
+    delete object;
+    object = nullptr;
+  }
+
+  if ( nullptr != ppObject )
+    *ppObject = object;
+  else if ( nullptr != object )
+    delete object;
+
+  return rc;
+}
+
+int MYON_BinaryArchive::Finish3dmDeferredObjectAttributes(
+  MYON_3dmDeferredObject& deferred_object,
+  MYON_3dmObjectAttributes* pAttributes
+  )
+{
+  if ( false == deferred_object.DecodePending() || 1 != deferred_object.m_rc || nullptr == pAttributes )
+  {
+    MYON_ERROR("Invalid parameters.");
+    return -1;
+  }
+
+  Internal_Finish3dmObject(nullptr, pAttributes);
+
+  return 1;
+}
+
+MYON_Object* MYON_BinaryArchive::Create3dmDeferredObject(
+  MYON_3dmDeferredObject& deferred_object,
+  const MYON_3dmObjectAttributes* pAttributes
+  ) const
+{
+  if ( deferred_object.DecodePending() )
+    Decode3dmDeferredObject(deferred_object);
+
+  MYON_Object* object = deferred_object.m_object;
+  deferred_object.m_object = nullptr;
+  if ( nullptr == object && 1 == deferred_object.m_rc && nullptr != deferred_object.m_shared_object.get() )
+    object = deferred_object.m_shared_object->Duplicate();
+  if ( 1 != deferred_object.m_rc && nullptr != object )
+  {
+    delete object;
+    object = nullptr;
+  }
+
+  if ( deferred_object.m_crc_error_count > 0 || deferred_object.m_critical_error_count > 0 )
+    MYON_ERROR("Deferred object is corrupt.");
+
+  deferred_object.Destroy();
+
+  if ( nullptr != object )
+  {
+    MYON_Object* updated_object = Internal_ConvertObject(object, pAttributes);
+    if (nullptr != updated_object && updated_object != object)
+    {
+      delete object;
+      object = updated_object;
+    }
+  }
+
+  return object;
+}
+
+int MYON_BinaryArchive::Internal_Read3dmObject(
+  MYON_Object** ppObject,
+  MYON_3dmObjectAttributes* pAttributes,
+  unsigned int object_filter,
+  MYON_3dmDeferredObject* deferred_object,
+  std::shared_ptr<MYON_Object>* shared_object
+  )
 {
   if ( pAttributes )
     pAttributes->Default();
+  if ( nullptr != shared_object )
+    shared_object->reset();
 
   if ( false == Read3dmTableRecord(MYON_3dmArchiveTableType::object_table, (void**)ppObject))
     return 0;
@@ -15767,13 +16861,68 @@ int MYON_BinaryArchive::Read3dmObject(
           if ( !EndRead3dmChunk() )
             rc = -1;
 
-          if ( 1 == rc )
+          bool bReadObject = (1 == rc);
+          if ( bReadObject && Internal_ObjectTypeIsSelfContained(value_TCODE_OBJECT_RECORD_TYPE) )
           {
-            switch(ReadObject(ppObject))
+            // The object may be a reference to an identical object 
+            // earlier in the table (see SetDeduplicateGeometry()).
+            const int reference_rc = Internal_Read3dmObjectReference(ppObject, shared_object);
+            if ( 0 != reference_rc )
             {
-            case 1:
-              rc = 1; // successfully read this object
-              break;
+              rc = reference_rc;
+              bReadObject = false;
+            }
+          }
+
+          if ( bReadObject 
+            && nullptr != deferred_object 
+            && Internal_ObjectTypeIsSelfContained(value_TCODE_OBJECT_RECORD_TYPE) 
+            )
+          {
+            // Save the serialized TCODE_OPENNURBS_CLASS chunk so it can
+            // be decoded later by Decode3dmDeferredObject().
+            MYON__UINT32 class_tcode = 0;
+            MYON__INT64 length_TCODE_OPENNURBS_CLASS = 0;
+            if ( PeekAt3dmBigChunkType(&class_tcode, &length_TCODE_OPENNURBS_CLASS)
+              && TCODE_OPENNURBS_CLASS == class_tcode
+              && length_TCODE_OPENNURBS_CLASS > 0
+              )
+            {
+              const size_t sizeof_header = (size_t)(4 + SizeofChunkLength());
+              const size_t sizeof_chunk = sizeof_header + (size_t)length_TCODE_OPENNURBS_CLASS;
+
+              // Chunk headers and nested chunks are not included in the 
+              // CRC of the parent chunk. The chunk's contents are checked
+              // when Decode3dmDeferredObject() reads the chunk.
+              const bool bDoChunkCRC = m_bDoChunkCRC;
+              m_bDoChunkCRC = false;
+              const void* view = ReadByteView(sizeof_chunk);
+              if ( nullptr == view )
+              {
+                deferred_object->m_buffer = onmalloc(sizeof_chunk);
+                if ( nullptr != deferred_object->m_buffer && ReadByte(sizeof_chunk, deferred_object->m_buffer) )
+                  view = deferred_object->m_buffer;
+              }
+              m_bDoChunkCRC = bDoChunkCRC;
+
+              if ( nullptr != view )
+              {
+                deferred_object->m_serialized_object = view;
+                deferred_object->m_sizeof_serialized_object = sizeof_chunk;
+              }
+              else
+                rc = -1;
+            }
+            else
+              rc = -1;
+          }
+          else if ( bReadObject )
+          {
+            switch(ReadObject(ppObject))
+            {
+            case 1:
+              rc = 1; // successfully read this object
+              break;
             case 3:
               rc = 3; // skipped object - assume it's just a newer object than this code reads
               break;
@@ -15853,10 +17002,37 @@ int MYON_BinaryArchive::Read3dmObject(
   }
 
   if ( 1 == rc 
+    && nullptr == deferred_object
     && nullptr != ppObject
     && nullptr != *ppObject
     && nullptr != pAttributes
     )
+  {
+    // When deferred_object is not nullptr, Finish3dmDeferredObject() does this.
+    Internal_Finish3dmObject(ppObject, pAttributes);
+  }
+  else if ( 1 == rc
+    && nullptr == deferred_object
+    && nullptr != shared_object
+    && nullptr != shared_object->get()
+    && nullptr != pAttributes
+    )
+  {
+    // Shared objects are not converted.
+    Internal_Finish3dmObject(nullptr, pAttributes);
+  }
+
+  return rc;
+}
+
+void MYON_BinaryArchive::Internal_Finish3dmObject(
+  MYON_Object** ppObject,
+  MYON_3dmObjectAttributes* pAttributes
+  )
+{
+  if ( (nullptr == ppObject || nullptr != *ppObject)
+    && nullptr != pAttributes
+    )
   {
     if (MYON_nil_uuid == pAttributes->m_uuid)
     {
@@ -15875,7 +17051,8 @@ int MYON_BinaryArchive::Read3dmObject(
     // Examples include reading obsolete objects and converting them into their 
     // current counterpart, converting WIP objects into a proxy for a commercial build, 
     // and converting a proxy object into a WIP object for a WIP build.
-    MYON_Object* updated_object = Internal_ConvertObject(*ppObject, pAttributes);
+    // When decoding is deferred, Create3dmDeferredObject() does this.
+    MYON_Object* updated_object = (nullptr != ppObject) ? Internal_ConvertObject(*ppObject, pAttributes) : nullptr;
 
     if (nullptr != updated_object && updated_object != *ppObject)
     {
@@ -15890,8 +17067,6 @@ int MYON_BinaryArchive::Read3dmObject(
       pAttributes->m_name
       );
   }
-
-  return rc;
 }
 
 bool MYON_BinaryArchive::EndRead3dmObjectTable()
@@ -15913,6 +17088,506 @@ bool MYON_BinaryArchive::EndRead3dmObjectTable()
   return rc;
 }
 
+static bool Internal_ReadObjectTableIndexItem(
+  MYON_BinaryArchive& archive,
+  MYON_3dmObjectTableIndexItem& item
+  )
+{
+  // The archive is positioned after the TCODE_OBJECT_RECORD chunk header.
+  MYON__UINT32 tcode = 0;
+  MYON__INT64 big_value = 0;
+
+  // TCODE_OBJECT_RECORD_TYPE
+  if ( false == archive.BeginRead3dmBigChunk(&tcode, &big_value) )
+    return false;
+  bool rc = (TCODE_OBJECT_RECORD_TYPE == tcode);
+  if (rc)
+    item.m_object_type = (unsigned int)big_value;
+  if ( false == archive.EndRead3dmChunk() )
+    rc = false;
+  if (false == rc)
+    return false;
+
+  // TCODE_OPENNURBS_CLASS - the class id is read and the object is skipped.
+  if ( false == archive.BeginRead3dmBigChunk(&tcode, &big_value) )
+    return false;
+  rc = (TCODE_OPENNURBS_CLASS == tcode);
+  if ( rc )
+  {
+    rc = archive.BeginRead3dmBigChunk(&tcode, &big_value);
+    if (rc)
+    {
+      rc = (TCODE_OPENNURBS_CLASS_UUID == tcode) && archive.ReadUuid(item.m_class_id);
+      if ( false == archive.EndRead3dmChunk() )
+        rc = false;
+    }
+  }
+  if ( false == archive.EndRead3dmChunk(true) )
+    rc = false;
+  if (false == rc)
+    return false;
+
+  // attributes
+  for (;;)
+  {
+    tcode = 0;
+    if ( false == archive.BeginRead3dmBigChunk(&tcode, &big_value) )
+      return false;
+    if ( TCODE_OBJECT_RECORD_ATTRIBUTES == tcode )
+    {
+      MYON_3dmObjectAttributes attributes;
+      rc = attributes.Read(archive);
+      item.m_id = attributes.m_uuid;
+      item.m_layer_index = attributes.m_layer_index;
+    }
+    if ( false == archive.EndRead3dmChunk() )
+      rc = false;
+    if ( false == rc )
+      return false;
+    if ( TCODE_OBJECT_RECORD_END == tcode )
+      break;
+  }
+
+  return true;
+}
+
+static bool Internal_ReadObjectTableIndexArchiveLayout(
+  MYON_BinaryArchive& archive,
+  MYON__UINT64* object_table_end_offset,
+  MYON__UINT64* end_mark_file_length
+  )
+{
+  // The archive is positioned at the start of the object table and no
+  // chunks are active. The object table chunk and the chunks after it
+  // are skipped, the file length is read from the end mark, and the
+  // archive is returned to the start of the object table.
+  *object_table_end_offset = 0;
+  *end_mark_file_length = 0;
+
+  const MYON__UINT64 object_table_offset = archive.CurrentPosition();
+  bool rc = false;
+  for (bool bObjectTable = true; /*empty test*/; bObjectTable = false)
+  {
+    MYON__UINT32 tcode = 0;
+    MYON__INT64 big_value = 0;
+    if (false == archive.BeginRead3dmBigChunk(&tcode, &big_value))
+      break;
+    MYON_3DM_BIG_CHUNK chunk;
+    archive.GetCurrentChunk(chunk);
+
+    bool bChunkRead = true;
+    bool bEndMark = false;
+    if (bObjectTable)
+    {
+      bChunkRead = (TCODE_OBJECT_TABLE == tcode);
+      *object_table_end_offset = chunk.m_end_offset;
+    }
+    else if (TCODE_ENDOFFILE == tcode)
+    {
+      // The end mark saves the file length in 4 or 8 bytes.
+      const MYON__UINT64 sizeof_file_length = chunk.LengthRemaining(archive.CurrentPosition());
+      bEndMark = true;
+      if (8 == sizeof_file_length)
+      {
+        MYON__UINT64 u64 = 0;
+        bChunkRead = archive.ReadBigInt(&u64);
+        *end_mark_file_length = u64;
+      }
+      else if (4 == sizeof_file_length)
+      {
+        MYON__UINT32 u32 = 0;
+        bChunkRead = archive.ReadInt(&u32);
+        *end_mark_file_length = u32;
+      }
+      else
+        bChunkRead = false;
+    }
+
+    if (false == archive.EndRead3dmChunk())
+      bChunkRead = false;
+    if (false == bChunkRead)
+      break;
+    if (bEndMark)
+    {
+      // Appended changes can modify or delete objects in the object table.
+      rc = *end_mark_file_length > 0 && false == archive.AtAppended3dmChanges();
+      break;
+    }
+  }
+
+  if (false == archive.SeekFromStart(object_table_offset))
+    rc = false;
+
+  return rc;
+}
+
+bool MYON_3dmObjectTableIndex::Create(
+  MYON_BinaryArchive& archive
+  )
+{
+  Destroy();
+
+  if ( archive.Archive3dmVersion() < 2 )
+  {
+    // Version 1 archives do not have object table records.
+    MYON_ERROR("Version 1 archives cannot be indexed.");
+    return false;
+  }
+
+  if (MYON_3dmArchiveTableType::Unset != archive.Active3dmTable())
+  {
+    MYON_ERROR("Create() must be called before the object table is started.");
+    return false;
+  }
+
+  const MYON__UINT64 object_table_offset = archive.CurrentPosition();
+  MYON__UINT64 object_table_end_offset = 0;
+  MYON__UINT64 end_mark_file_length = 0;
+  if (false == Internal_ReadObjectTableIndexArchiveLayout(archive, &object_table_end_offset, &end_mark_file_length))
+  {
+    MYON_ERROR("Unable to find the end of the object table and the end mark or the archive has appended changes.");
+    return false;
+  }
+
+  if ( false == archive.BeginRead3dmObjectTable() )
+    return false;
+
+  const MYON__UINT64 first_record_offset = archive.CurrentPosition();
+  bool rc = false;
+  for (;;)
+  {
+    const MYON__UINT64 record_offset = archive.CurrentPosition();
+    MYON__UINT32 tcode = 0;
+    MYON__INT64 big_value = 0;
+    if ( false == archive.BeginRead3dmBigChunk(&tcode, &big_value) )
+      break;
+
+    if ( TCODE_ENDOFTABLE == tcode )
+    {
+      m_end_of_table_offset = record_offset;
+      rc = archive.EndRead3dmChunk();
+      break;
+    }
+
+    MYON_3dmObjectTableIndexItem& item = m_items.AppendNew();
+    item.m_record_offset = record_offset;
+    bool bRecordRead = (TCODE_OBJECT_RECORD == tcode) && Internal_ReadObjectTableIndexItem(archive, item);
+    if ( false == archive.EndRead3dmChunk() )
+      bRecordRead = false;
+    if ( false == bRecordRead )
+    {
+      MYON_ERROR("Corrupt object table record.");
+      break;
+    }
+  }
+
+  if (rc)
+  {
+    // Leave the object table active and positioned at the first record
+    // so the records can be read in any order.
+    // SeekFromStart() cannot be used inside a chunk.
+    const MYON__UINT64 pos = archive.CurrentPosition();
+    rc = (pos >= first_record_offset) && archive.SeekBackward(pos - first_record_offset);
+  }
+
+  if (false == rc)
+  {
+    // If BeginRead3dmObjectTable() returns true, 
+    // then you MUST call EndRead3dmObjectTable().
+    archive.EndRead3dmObjectTable();
+    Destroy();
+    return false;
+  }
+
+  m_archive_3dm_version = archive.Archive3dmVersion();
+  m_archive_opennurbs_version = archive.ArchiveOpenNURBSVersion();
+  m_object_table_offset = object_table_offset;
+  m_object_table_end_offset = object_table_end_offset;
+  m_end_mark_file_length = end_mark_file_length;
+  Internal_SortById();
+
+  return true;
+}
+
+void MYON_3dmObjectTableIndex::Destroy()
+{
+  m_archive_3dm_version = 0;
+  m_archive_opennurbs_version = 0;
+  m_object_table_offset = 0;
+  m_end_of_table_offset = 0;
+  m_object_table_end_offset = 0;
+  m_end_mark_file_length = 0;
+  m_items.Destroy();
+  m_id_order.Destroy();
+}
+
+static int Internal_CompareObjectTableIndexItemId(const void* a, const void* b)
+{
+  const MYON_3dmObjectTableIndexItem* itemA = (const MYON_3dmObjectTableIndexItem*)a;
+  const MYON_3dmObjectTableIndexItem* itemB = (const MYON_3dmObjectTableIndexItem*)b;
+  const int rc = MYON_UuidCompare(itemA->m_id, itemB->m_id);
+  if (0 != rc)
+    return rc;
+  // When ids are duplicated, the first record is found by ItemFromId().
+  if (itemA->m_record_offset < itemB->m_record_offset)
+    return -1;
+  if (itemA->m_record_offset > itemB->m_record_offset)
+    return 1;
+  return 0;
+}
+
+void MYON_3dmObjectTableIndex::Internal_SortById()
+{
+  const unsigned int count = m_items.UnsignedCount();
+  m_id_order.SetCapacity(count);
+  m_id_order.SetCount(count);
+  if (count > 0)
+  {
+    MYON_Sort(
+      MYON::sort_algorithm::quick_sort,
+      m_id_order.Array(),
+      m_items.Array(),
+      count,
+      sizeof(m_items[0]),
+      Internal_CompareObjectTableIndexItemId
+    );
+  }
+}
+
+bool MYON_3dmObjectTableIndex::IsValidForArchive(
+  MYON_BinaryArchive& archive
+  ) const
+{
+  if (false == (m_object_table_offset < m_end_of_table_offset && m_end_of_table_offset < m_object_table_end_offset))
+    return false;
+  if (0 == m_end_mark_file_length)
+    return false;
+  if (m_archive_3dm_version != archive.Archive3dmVersion() || m_archive_opennurbs_version != archive.ArchiveOpenNURBSVersion())
+    return false;
+
+  const MYON__UINT64 pos = archive.CurrentPosition();
+  if (MYON_3dmArchiveTableType::Unset == archive.Active3dmTable())
+  {
+    // object table not started
+    if (m_object_table_offset != pos)
+      return false;
+    MYON__UINT64 object_table_end_offset = 0;
+    MYON__UINT64 end_mark_file_length = 0;
+    return
+      Internal_ReadObjectTableIndexArchiveLayout(archive, &object_table_end_offset, &end_mark_file_length)
+      && m_object_table_end_offset == object_table_end_offset
+      && m_end_mark_file_length == end_mark_file_length;
+  }
+
+  if (MYON_3dmArchiveTableType::object_table == archive.Active3dmTable())
+  {
+    // object table active (Create() was just called)
+    MYON_3DM_BIG_CHUNK chunk;
+    return
+      1 == archive.GetCurrentChunk(chunk)
+      && TCODE_OBJECT_TABLE == chunk.m_typecode
+      && m_object_table_end_offset == chunk.m_end_offset
+      && pos > m_object_table_offset
+      && pos <= m_end_of_table_offset;
+  }
+
+  return false;
+}
+
+unsigned int MYON_3dmObjectTableIndex::ItemCount() const
+{
+  return m_items.UnsignedCount();
+}
+
+const MYON_3dmObjectTableIndexItem* MYON_3dmObjectTableIndex::Item(
+  unsigned int item_index
+  ) const
+{
+  return (item_index < m_items.UnsignedCount()) ? (m_items.Array() + item_index) : nullptr;
+}
+
+const MYON_3dmObjectTableIndexItem* MYON_3dmObjectTableIndex::ItemFromId(
+  MYON_UUID id
+  ) const
+{
+  if (MYON_nil_uuid == id)
+    return nullptr;
+
+  const MYON_3dmObjectTableIndexItem* items = m_items.Array();
+  const unsigned int* id_order = m_id_order.Array();
+  unsigned int i0 = 0;
+  unsigned int i1 = m_id_order.UnsignedCount();
+  // find the first item with m_id >= id
+  while (i0 < i1)
+  {
+    const unsigned int i = i0 + (i1 - i0) / 2;
+    if (MYON_UuidCompare(items[id_order[i]].m_id, id) < 0)
+      i0 = i + 1;
+    else
+      i1 = i;
+  }
+
+  if (i0 < m_id_order.UnsignedCount() && id == items[id_order[i0]].m_id)
+    return items + id_order[i0];
+
+  return nullptr;
+}
+
+unsigned int MYON_3dmObjectTableIndex::GetItems(
+  unsigned int object_type_filter,
+  int layer_index,
+  MYON_SimpleArray< const MYON_3dmObjectTableIndexItem* >& items
+  ) const
+{
+  const unsigned int count0 = items.UnsignedCount();
+  const unsigned int count = m_items.UnsignedCount();
+  for (unsigned int i = 0; i < count; i++)
+  {
+    const MYON_3dmObjectTableIndexItem& item = m_items[i];
+    if (0 != object_type_filter && 0 == (object_type_filter & item.m_object_type))
+      continue;
+    if (MYON_UNSET_INT_INDEX != layer_index && layer_index != item.m_layer_index)
+      continue;
+    items.Append(&item);
+  }
+  return items.UnsignedCount() - count0;
+}
+
+MYON__UINT64 MYON_3dmObjectTableIndex::EndOfTableOffset() const
+{
+  return m_end_of_table_offset;
+}
+
+bool MYON_3dmObjectTableIndex::Write(
+  MYON_BinaryArchive& archive
+  ) const
+{
+  // content_version = 1: m_object_table_end_offset and m_end_mark_file_length added
+  const int content_version = 1;
+  if (false == archive.BeginWrite3dmAnonymousChunk(content_version))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    if (!archive.WriteInt(m_archive_3dm_version))
+      break;
+    if (!archive.WriteInt(m_archive_opennurbs_version))
+      break;
+    if (!archive.WriteBigInt(m_object_table_offset))
+      break;
+    if (!archive.WriteBigInt(m_end_of_table_offset))
+      break;
+    if (!archive.WriteBigInt(m_object_table_end_offset))
+      break;
+    if (!archive.WriteBigInt(m_end_mark_file_length))
+      break;
+
+    const unsigned int count = m_items.UnsignedCount();
+    if (!archive.WriteInt(count))
+      break;
+    unsigned int i;
+    for (i = 0; i < count; i++)
+    {
+      const MYON_3dmObjectTableIndexItem& item = m_items[i];
+      if (!archive.WriteUuid(item.m_id))
+        break;
+      if (!archive.WriteUuid(item.m_class_id))
+        break;
+      if (!archive.WriteBigInt(item.m_record_offset))
+        break;
+      if (!archive.WriteInt(item.m_object_type))
+        break;
+      if (!archive.WriteInt(item.m_layer_index))
+        break;
+    }
+    if (i < count)
+      break;
+
+    rc = true;
+    break;
+  }
+  if (!archive.EndWrite3dmChunk())
+    rc = false;
+  return rc;
+}
+
+bool MYON_3dmObjectTableIndex::Read(
+  MYON_BinaryArchive& archive
+  )
+{
+  Destroy();
+
+  int content_version = -1;
+  if (false == archive.BeginRead3dmAnonymousChunk(&content_version))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    // Indices saved before content_version 1 cannot be validated
+    // and are not used.
+    if (content_version < 1)
+      break;
+    if (!archive.ReadInt(&m_archive_3dm_version))
+      break;
+    if (!archive.ReadInt(&m_archive_opennurbs_version))
+      break;
+    if (!archive.ReadBigInt(&m_object_table_offset))
+      break;
+    if (!archive.ReadBigInt(&m_end_of_table_offset))
+      break;
+    if (!archive.ReadBigInt(&m_object_table_end_offset))
+      break;
+    if (!archive.ReadBigInt(&m_end_mark_file_length))
+      break;
+
+    unsigned int count = 0;
+    if (!archive.ReadInt(&count))
+      break;
+
+    // Each item is saved in 48 bytes (two uuids, an offset and two ints).
+    // The count is not trusted until the chunk is known to be large enough.
+    MYON_3DM_BIG_CHUNK chunk;
+    if (archive.GetCurrentChunk(chunk) <= 0)
+      break;
+    if ((MYON__UINT64)count > chunk.LengthRemaining(archive.CurrentPosition()) / 48)
+      break;
+    m_items.Reserve(count);
+    unsigned int i;
+    for (i = 0; i < count; i++)
+    {
+      MYON_3dmObjectTableIndexItem& item = m_items.AppendNew();
+      if (!archive.ReadUuid(item.m_id))
+        break;
+      if (!archive.ReadUuid(item.m_class_id))
+        break;
+      if (!archive.ReadBigInt(&item.m_record_offset))
+        break;
+      if (!archive.ReadInt(&item.m_object_type))
+        break;
+      if (!archive.ReadInt(&item.m_layer_index))
+        break;
+      if (item.m_record_offset <= m_object_table_offset || item.m_record_offset >= m_end_of_table_offset || m_end_of_table_offset >= m_object_table_end_offset)
+        break;
+    }
+    if (i < count)
+      break;
+
+    rc = true;
+    break;
+  }
+  if (!archive.EndRead3dmChunk())
+    rc = false;
+
+  if (rc)
+    Internal_SortById();
+  else
+    Destroy();
+
+  return rc;
+}
+
 bool MYON_BinaryArchive::BeginWrite3dmUserTable( const MYON_UUID& usertable_uuid )
 {
   return BeginWrite3dmUserTable(usertable_uuid, false, 0, 0 );
@@ -16346,6 +18021,196 @@ bool MYON_BinaryArchive::Read3dmEndMark( size_t* file_length )
   return End3dmTable(MYON_3dmArchiveTableType::end_mark,rc);
 }
 
+bool MYON_BinaryArchive::Write3dmAppendedEndMark( MYON__UINT64 sizeof_preceding_archive )
+{
+  Flush();
+  if ( m_chunk.Count() != 0 ) {
+    MYON_ERROR( "MYON_BinaryArchive::Write3dmAppendedEndMark() called with unfinished chunks.\n" );
+    return false;
+  }
+
+  MYON__UINT64 length = sizeof_preceding_archive + CurrentPosition();
+  bool rc = BeginWrite3dmChunk( TCODE_ENDOFFILE, 0 );
+  if ( rc ) 
+  {    
+    size_t sizeof_chunk_length = SizeofChunkLength();
+    size_t sizeoffile_length = (8==SizeofChunkLength()) ? 8 : 4;
+    length += (4 + sizeof_chunk_length + sizeoffile_length );
+    rc = WriteEOFSizeOfFile(length);
+    if ( !EndWrite3dmChunk() )
+      rc = false;
+  }
+  Flush();
+
+  return rc;
+}
+
+bool MYON_BinaryArchive::Read3dmAppendedEndMark( size_t* file_length )
+{
+  if ( file_length )
+    *file_length = 0;
+
+  unsigned int tcode=0;
+  MYON__INT64 value=0;
+  const unsigned int saved_error_message_mask = m_error_message_mask;
+  m_error_message_mask |= 0x0001; // disable v1 ReadByte() error message at EOF
+  bool rc = PeekAt3dmBigChunkType(&tcode,&value);
+  m_error_message_mask = saved_error_message_mask;
+  if ( !rc || TCODE_ENDOFFILE != tcode )
+    return false;
+
+  rc = BeginRead3dmBigChunk(&tcode,&value);
+  if ( rc )
+  {
+    if ( value > 0 && ((MYON__UINT64)value) >= SizeofChunkLength() )
+    {
+      MYON__UINT64 u64 = 0;
+      rc = ReadEOFSizeOfFile( &u64 );
+      if ( rc && file_length )
+        *file_length = (size_t)u64;
+      if ( rc )
+        m_3dm_end_mark_length = u64;
+    }
+    else
+      rc = false;
+    if ( !EndRead3dmChunk() )
+      rc = false;
+  }
+
+  return rc;
+}
+
+bool MYON_BinaryArchive::AtAppended3dmChanges()
+{
+  if ( false == ReadMode() || 0 != m_chunk.Count() )
+    return false;
+
+  unsigned int tcode=0;
+  MYON__INT64 value=0;
+  const unsigned int saved_error_message_mask = m_error_message_mask;
+  m_error_message_mask |= 0x0001; // disable v1 ReadByte() error message at EOF
+  const bool rc = PeekAt3dmBigChunkType(&tcode,&value);
+  m_error_message_mask = saved_error_message_mask;
+
+  return (rc && TCODE_APPENDED_CHANGES_TABLE == tcode);
+}
+
+bool MYON_BinaryArchive::Skip3dmTable(
+  MYON_3dmArchiveTableType table,
+  unsigned int* record_count
+  )
+{
+  if ( nullptr != record_count )
+    *record_count = 0;
+
+  unsigned int table_typecode = 0;
+  unsigned int record_typecode = 0;
+  switch (table)
+  {
+  case MYON_3dmArchiveTableType::bitmap_table:
+    table_typecode = TCODE_BITMAP_TABLE;
+    record_typecode = TCODE_BITMAP_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::texture_mapping_table:
+    table_typecode = TCODE_TEXTURE_MAPPING_TABLE;
+    record_typecode = TCODE_TEXTURE_MAPPING_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::material_table:
+    table_typecode = TCODE_MATERIAL_TABLE;
+    record_typecode = TCODE_MATERIAL_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::linetype_table:
+    table_typecode = TCODE_LINETYPE_TABLE;
+    record_typecode = TCODE_LINETYPE_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::layer_table:
+    table_typecode = TCODE_LAYER_TABLE;
+    record_typecode = TCODE_LAYER_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::group_table:
+    table_typecode = TCODE_GROUP_TABLE;
+    record_typecode = TCODE_GROUP_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::text_style_table:
+    table_typecode = TCODE_FONT_TABLE;
+    record_typecode = TCODE_FONT_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::dimension_style_table:
+    table_typecode = TCODE_DIMSTYLE_TABLE;
+    record_typecode = TCODE_DIMSTYLE_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::light_table:
+    table_typecode = TCODE_LIGHT_TABLE;
+    record_typecode = TCODE_LIGHT_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::hatchpattern_table:
+    table_typecode = TCODE_HATCHPATTERN_TABLE;
+    record_typecode = TCODE_HATCHPATTERN_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::instance_definition_table:
+    table_typecode = TCODE_INSTANCE_DEFINITION_TABLE;
+    record_typecode = TCODE_INSTANCE_DEFINITION_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::object_table:
+    table_typecode = TCODE_OBJECT_TABLE;
+    record_typecode = TCODE_OBJECT_RECORD;
+    break;
+  case MYON_3dmArchiveTableType::historyrecord_table:
+    table_typecode = TCODE_HISTORYRECORD_TABLE;
+    record_typecode = TCODE_HISTORYRECORD_RECORD;
+    break;
+  default:
+    break;
+  }
+
+  if (0 == table_typecode)
+  {
+    MYON_ERROR("Invalid table parameter.");
+    return false;
+  }
+
+  if (m_3dm_version <= 1)
+  {
+    MYON_ERROR("Version 1 archives do not have tables.");
+    return false;
+  }
+
+  const bool bArchiveContainsTable = ArchiveContains3dmTable(table);
+  if (false == BeginRead3dmTable(table_typecode))
+    return false;
+
+  unsigned int count = 0;
+  bool rc = true;
+  while (bArchiveContainsTable)
+  {
+    MYON__UINT32 tcode = 0;
+    MYON__INT64 big_value = 0;
+    if (false == BeginRead3dmBigChunk(&tcode, &big_value))
+    {
+      rc = false;
+      break;
+    }
+    if (record_typecode == tcode)
+      count++;
+    // The record is not read. EndRead3dmChunk() seeks past it.
+    if (false == EndRead3dmChunk())
+    {
+      rc = false;
+      break;
+    }
+    if (TCODE_ENDOFTABLE == tcode)
+      break;
+  }
+
+  if (false == EndRead3dmTable(table_typecode))
+    rc = false;
+
+  if (nullptr != record_count)
+    *record_count = count;
+
+  return rc;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -16503,62 +18368,308 @@ bool MYON_BinaryArchive::MaskReadError( MYON__UINT64 sizeof_request, MYON__UINT6
   if ( sizeof_request == sizeof_read )
     return true; // no error
 
-  if ( sizeof_read > sizeof_request )
-    return false; // something is seriously wrong
+  if ( sizeof_read > sizeof_request )
+    return false; // something is seriously wrong
+
+  if ( 0 != (0x04 & m_error_message_mask) )
+    return true;
+
+  if (0 != (0x01 & m_error_message_mask) && 4 == sizeof_request && 0 == sizeof_read)
+  {
+    // when reading v1 files, there are some situations where
+    // it is reasonable to attempt to read 4 bytes at the end
+    // of a file.
+    return true;
+  }
+
+  if (0 == m_3dm_version
+    && 0 == m_3dm_opennurbs_version
+    && 0 == m_3dm_start_section_offset
+    && MYON_3dmArchiveTableType::Unset == m_3dm_previous_table
+    && MYON_3dmArchiveTableType::Unset == m_3dm_active_table
+    && MYON_3dmArchiveTableType::Unset == m_3dm_first_failed_table
+    && 0 == m_chunk
+    && MYON::archive_mode::read3dm == m_mode
+    )
+  {
+    // In Read3dmStartSection(), we search for the string 
+    // "3D Geometry File Format ...".  When a non-.3dm file
+    // is searched, we eventually reach the end of the file.
+    // This error condition is reported by the returning
+    // false from MYON_BinaryArchive::Read3dmStartSection().
+    // MYON_ERROR is not called to prevent annoying everyone
+    // when the open file dialog is digging around looking
+    // for files.
+    return true;
+  }
+
+  return false; // parial read not permitted at this time.
+}
+
+MYON__UINT64 MYON_BinaryArchive::ReadBuffer( MYON__UINT64 sizeof_buffer, void* buffer )
+{
+  // Expert user function to load a buffer with up to sizeof_buffer
+  // bytes but tolerate encountering the end of the file.
+  if ( 0 == buffer )
+    return 0;
+  unsigned int saved_error_mask = m_error_message_mask;
+  m_error_message_mask |= 0x04; // tell Read to tolerate hitting the end of the file
+  MYON__UINT64 sizeof_read = Read((size_t)sizeof_buffer,buffer);
+  m_error_message_mask = saved_error_mask;
+  return sizeof_read;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+class MYON_BinaryFileReadBuffer
+{
+public:
+  MYON_BinaryFileReadBuffer(
+    FILE* fp,
+    size_t buffer_capacity,
+    bool bReadAhead
+    );
+  ~MYON_BinaryFileReadBuffer();
+
+  bool IsValid() const;
+
+  // Returns number of bytes copied to p (like fread()).
+  size_t Read(size_t count, void* p);
+
+  MYON__UINT64 CurrentPosition() const;
+
+  bool SeekFromStart(MYON__UINT64 position);
+
+  bool AtEnd();
+
+  // Positions the FILE at CurrentPosition() so it can be used without the buffer.
+  bool RestoreFilePosition();
+
+private:
+  MYON_BinaryFileReadBuffer() = delete;
+  MYON_BinaryFileReadBuffer(const MYON_BinaryFileReadBuffer&) = delete;
+  MYON_BinaryFileReadBuffer& operator=(const MYON_BinaryFileReadBuffer&) = delete;
+
+  struct Block
+  {
+    unsigned char* m_buffer = nullptr;
+    size_t m_size = 0;
+    // file position of m_buffer[0]
+    MYON__UINT64 m_start = 0;
+  };
+
+  // Begins reading the block that follows m_block[0] into m_block[1].
+  void Internal_BeginFill();
+  void Internal_FinishFill();
+
+  // m_reader_thread runs this function until m_bStopReader is true.
+  void Internal_ReaderThread();
+
+  // Makes m_block[1] the current block. 
+  // Returns false if m_block[1] is empty (end of file).
+  bool Internal_NextBlock();
+
+  FILE* m_fp = nullptr;
+  const size_t m_capacity;
+  // m_block[0] is being parsed. m_block[1] is the block after m_block[0].
+  Block m_block[2];
+  // m_block[0].m_buffer[m_ptr] is the next byte to read
+  size_t m_ptr = 0;
+
+  // When reading ahead, one thread reads every block. m_bFillPending is
+  // true while it is reading m_block[1].
+  std::thread m_reader_thread;
+  std::mutex m_reader_mutex;
+  std::condition_variable m_reader_cv;
+  bool m_bFillPending = false;
+  bool m_bStopReader = false;
+};
+
+MYON_BinaryFileReadBuffer::MYON_BinaryFileReadBuffer(
+  FILE* fp,
+  size_t buffer_capacity,
+  bool bReadAhead
+  )
+  : m_fp(fp)
+  , m_capacity(buffer_capacity < 4096 ? 4096 : buffer_capacity)
+{
+  m_block[0].m_buffer = (unsigned char*)onmalloc(m_capacity);
+  m_block[1].m_buffer = (unsigned char*)onmalloc(m_capacity);
+  const MYON__INT64 position = MYON_FileStream::CurrentPosition(m_fp);
+  m_block[0].m_start = (position > 0) ? ((MYON__UINT64)position) : 0;
+  if (IsValid())
+  {
+    if (bReadAhead)
+    {
+      try
+      {
+        m_reader_thread = std::thread(&MYON_BinaryFileReadBuffer::Internal_ReaderThread, this);
+      }
+      catch (const std::system_error&)
+      {
+        // No more threads are available. Blocks are read on the calling thread.
+      }
+    }
+    Internal_BeginFill();
+  }
+}
+
+MYON_BinaryFileReadBuffer::~MYON_BinaryFileReadBuffer()
+{
+  Internal_FinishFill();
+  if (m_reader_thread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_reader_mutex);
+      m_bStopReader = true;
+    }
+    m_reader_cv.notify_all();
+    m_reader_thread.join();
+  }
+  onfree(m_block[0].m_buffer);
+  onfree(m_block[1].m_buffer);
+}
+
+void MYON_BinaryFileReadBuffer::Internal_ReaderThread()
+{
+  std::unique_lock<std::mutex> lock(m_reader_mutex);
+  for (;;)
+  {
+    m_reader_cv.wait(lock, [this] { return m_bFillPending || m_bStopReader; });
+    if (m_bStopReader)
+      break;
+    Block& block = m_block[1];
+    lock.unlock();
+    block.m_size = fread(block.m_buffer, 1, m_capacity, m_fp);
+    lock.lock();
+    m_bFillPending = false;
+    m_reader_cv.notify_all();
+  }
+}
+
+bool MYON_BinaryFileReadBuffer::RestoreFilePosition()
+{
+  Internal_FinishFill();
+  return MYON_FileStream::SeekFromStart(m_fp, (MYON__INT64)CurrentPosition());
+}
+
+bool MYON_BinaryFileReadBuffer::IsValid() const
+{
+  return (nullptr != m_fp && nullptr != m_block[0].m_buffer && nullptr != m_block[1].m_buffer);
+}
+
+void MYON_BinaryFileReadBuffer::Internal_BeginFill()
+{
+  Block& block = m_block[1];
+  block.m_start = m_block[0].m_start + m_block[0].m_size;
+  block.m_size = 0;
+  if (m_reader_thread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_reader_mutex);
+      m_bFillPending = true;
+    }
+    m_reader_cv.notify_all();
+  }
+  else
+  {
+    block.m_size = fread(block.m_buffer, 1, m_capacity, m_fp);
+  }
+}
+
+void MYON_BinaryFileReadBuffer::Internal_FinishFill()
+{
+  if (m_reader_thread.joinable())
+  {
+    std::unique_lock<std::mutex> lock(m_reader_mutex);
+    m_reader_cv.wait(lock, [this] { return false == m_bFillPending; });
+  }
+}
+
+bool MYON_BinaryFileReadBuffer::Internal_NextBlock()
+{
+  Internal_FinishFill();
+  if (0 == m_block[1].m_size)
+  {
+    // end of file - read again in case the file has grown.
+    Internal_BeginFill();
+    Internal_FinishFill();
+    if (0 == m_block[1].m_size)
+      return false;
+  }
+  std::swap(m_block[0], m_block[1]);
+  m_ptr = 0;
+  Internal_BeginFill();
+  return true;
+}
+
+size_t MYON_BinaryFileReadBuffer::Read(size_t count, void* p)
+{
+  unsigned char* dst = (unsigned char*)p;
+  size_t read_count = 0;
+  while (read_count < count)
+  {
+    if (m_ptr >= m_block[0].m_size && false == Internal_NextBlock())
+      break;
+    size_t n = m_block[0].m_size - m_ptr;
+    if (n > count - read_count)
+      n = count - read_count;
+    memcpy(dst + read_count, m_block[0].m_buffer + m_ptr, n);
+    m_ptr += n;
+    read_count += n;
+  }
+  return read_count;
+}
 
-  if ( 0 != (0x04 & m_error_message_mask) )
-    return true;
+MYON__UINT64 MYON_BinaryFileReadBuffer::CurrentPosition() const
+{
+  return m_block[0].m_start + m_ptr;
+}
 
-  if (0 != (0x01 & m_error_message_mask) && 4 == sizeof_request && 0 == sizeof_read)
+bool MYON_BinaryFileReadBuffer::SeekFromStart(MYON__UINT64 position)
+{
+  if (position >= m_block[0].m_start && position <= m_block[0].m_start + m_block[0].m_size)
   {
-    // when reading v1 files, there are some situations where
-    // it is reasonable to attempt to read 4 bytes at the end
-    // of a file.
+    m_ptr = (size_t)(position - m_block[0].m_start);
     return true;
   }
 
-  if (0 == m_3dm_version
-    && 0 == m_3dm_opennurbs_version
-    && 0 == m_3dm_start_section_offset
-    && MYON_3dmArchiveTableType::Unset == m_3dm_previous_table
-    && MYON_3dmArchiveTableType::Unset == m_3dm_active_table
-    && MYON_3dmArchiveTableType::Unset == m_3dm_first_failed_table
-    && 0 == m_chunk
-    && MYON::archive_mode::read3dm == m_mode
-    )
+  Internal_FinishFill();
+  if (position >= m_block[1].m_start && position < m_block[1].m_start + m_block[1].m_size)
   {
-    // In Read3dmStartSection(), we search for the string 
-    // "3D Geometry File Format ...".  When a non-.3dm file
-    // is searched, we eventually reach the end of the file.
-    // This error condition is reported by the returning
-    // false from MYON_BinaryArchive::Read3dmStartSection().
-    // MYON_ERROR is not called to prevent annoying everyone
-    // when the open file dialog is digging around looking
-    // for files.
+    // Seeks past the rest of the current block, typically to skip a chunk,
+    // usually land in the block that was read ahead.
+    std::swap(m_block[0], m_block[1]);
+    m_ptr = (size_t)(position - m_block[0].m_start);
+    Internal_BeginFill();
     return true;
   }
 
-  return false; // parial read not permitted at this time.
+  if (false == MYON_FileStream::SeekFromStart(m_fp, (MYON__INT64)position))
+  {
+    // m_fp is at the end of m_block[1].
+    return false;
+  }
+  m_block[0].m_start = position;
+  m_block[0].m_size = 0;
+  m_ptr = 0;
+  Internal_BeginFill();
+  return true;
 }
 
-MYON__UINT64 MYON_BinaryArchive::ReadBuffer( MYON__UINT64 sizeof_buffer, void* buffer )
+bool MYON_BinaryFileReadBuffer::AtEnd()
 {
-  // Expert user function to load a buffer with up to sizeof_buffer
-  // bytes but tolerate encountering the end of the file.
-  if ( 0 == buffer )
-    return 0;
-  unsigned int saved_error_mask = m_error_message_mask;
-  m_error_message_mask |= 0x04; // tell Read to tolerate hitting the end of the file
-  MYON__UINT64 sizeof_read = Read((size_t)sizeof_buffer,buffer);
-  m_error_message_mask = saved_error_mask;
-  return sizeof_read;
+  if (m_ptr < m_block[0].m_size)
+    return false;
+  Internal_FinishFill();
+  if (m_block[1].m_size > 0)
+    return false;
+  return false == Internal_NextBlock();
 }
 
-
-///////////////////////////////////////////////////////////////////////////////
-///////////////////////////////////////////////////////////////////////////////
-///////////////////////////////////////////////////////////////////////////////
-
 MYON_BinaryFile::MYON_BinaryFile( MYON::archive_mode archive_mode ) 
   : MYON_BinaryArchive( archive_mode )
 {}
@@ -16623,6 +18734,11 @@ MYON_BinaryFile::MYON_BinaryFile( MYON::archive_mode archive_mode, const wchar_t
 
 MYON_BinaryFile::~MYON_BinaryFile()
 {
+  if (nullptr != m_read_buffer)
+  {
+    delete m_read_buffer;
+    m_read_buffer = nullptr;
+  }
   if ( m_bCloseFileInDestructor )
     CloseFile();
   EnableMemoryBuffer(0);
@@ -16635,6 +18751,11 @@ bool MYON_BinaryFile::FileIsOpen() const
 
 void MYON_BinaryFile::CloseFile()
 {
+  if (nullptr != m_read_buffer)
+  {
+    delete m_read_buffer;
+    m_read_buffer = nullptr;
+  }
   FILE* fp = m_fp;
   if (nullptr != fp)
   {
@@ -16644,6 +18765,36 @@ void MYON_BinaryFile::CloseFile()
   m_bCloseFileInDestructor = false;
 }
 
+bool MYON_BinaryFile::EnableReadBuffer(size_t buffer_capacity, bool bReadAhead)
+{
+  if (nullptr != m_read_buffer)
+  {
+    m_read_buffer->RestoreFilePosition();
+    delete m_read_buffer;
+    m_read_buffer = nullptr;
+  }
+  if (0 == buffer_capacity)
+    return false;
+  if (nullptr == m_fp || false == ReadMode())
+  {
+    MYON_ERROR("Read buffering requires a file opened for reading.");
+    return false;
+  }
+  m_read_buffer = new MYON_BinaryFileReadBuffer(m_fp, buffer_capacity, bReadAhead);
+  if (false == m_read_buffer->IsValid())
+  {
+    delete m_read_buffer;
+    m_read_buffer = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool MYON_BinaryFile::ReadBufferIsEnabled() const
+{
+  return (nullptr != m_read_buffer);
+}
+
 
 size_t MYON_BinaryArchive::Read( size_t count, void* p )
 {
@@ -16714,6 +18865,56 @@ bool MYON_BinaryArchive::ReadByte(size_t count, void* p)
   return (count == Read(count, p));
 }
 
+const void* MYON_BinaryArchive::Internal_ReadViewOverride( size_t /*count*/ )
+{
+  // Archives that do not keep their contents in memory cannot provide views.
+  return nullptr;
+}
+
+const void* MYON_BinaryArchive::ReadByteView( size_t count )
+{
+  bool bChunkBoundaryError = false;
+  return Internal_ReadByteView(count, bChunkBoundaryError);
+}
+
+const void* MYON_BinaryArchive::Internal_ReadByteView( size_t count, bool& bChunkBoundaryError )
+{
+  bChunkBoundaryError = false;
+  if ( !ReadMode() || 0 == count )
+    return nullptr;
+
+  if (m_bChunkBoundaryCheck)
+  {
+    const MYON_3DM_BIG_CHUNK* c = m_chunk.Last();
+    if (nullptr != c)
+    {
+      const MYON__UINT64 current_pos = CurrentPosition();
+      const MYON__UINT64 new_pos = current_pos + ((MYON__UINT64)count);
+      if (current_pos < c->m_start_offset)
+      {
+        MYON_ERROR("Attempt to read before the start of current chunk.");
+        bChunkBoundaryError = true;
+        return nullptr;
+      }
+      if ( new_pos > c->m_end_offset )
+      {
+        MYON_ERROR("Attempt to read beyond end of current chunk.");
+        bChunkBoundaryError = true;
+        return nullptr;
+      }
+    }
+  }
+
+  const void* view = Internal_ReadViewOverride(count);
+  if (nullptr != view)
+  {
+    UpdateCRC(count, view);
+    Internal_IncrementCurrentPosition((MYON__UINT64)count);
+  }
+
+  return view;
+}
+
 size_t MYON_BinaryArchive::Write( size_t count, const void* p )
 {
   size_t writecount = 0;
@@ -16855,7 +19056,9 @@ MYON_BinaryFile::EnableMemoryBuffer(
 
 size_t MYON_BinaryFile::Internal_ReadOverride( size_t count, void* p )
 {
-  const size_t rc  = (m_fp) ? fread( p, 1, count, m_fp ) : 0;
+  const size_t rc  = (m_fp) 
+    ? ((nullptr != m_read_buffer) ? m_read_buffer->Read(count, p) : fread( p, 1, count, m_fp )) 
+    : 0;
   if (rc != count && nullptr != m_fp)
   {
     if (false == MaskReadError(count, rc))
@@ -16941,7 +19144,11 @@ MYON__UINT64 MYON_BinaryFile::Internal_CurrentPositionOverride() const
 {
   MYON__UINT64 offset = 0;
 
-  if ( 0 != m_fp ) 
+  if ( nullptr != m_read_buffer )
+  {
+    offset = m_read_buffer->CurrentPosition();
+  }
+  else if ( 0 != m_fp ) 
   {
 
 #if defined(MYON_COMPILER_MSC)
@@ -16976,7 +19183,11 @@ MYON__UINT64 MYON_BinaryFile::Internal_CurrentPositionOverride() const
 bool MYON_BinaryFile::AtEnd() const
 {
   bool rc = true;
-  if ( m_fp ) 
+  if ( nullptr != m_read_buffer )
+  {
+    rc = m_read_buffer->AtEnd();
+  }
+  else if ( m_fp ) 
   {
     rc = false;
     if ( ReadMode() && m_memory_buffer_ptr >= m_memory_buffer_size ) 
@@ -17021,7 +19232,23 @@ bool MYON_BinaryFile::Internal_SeekFromCurrentPositionOverride( int offset )
   // it's own buffer for buffered I/O instead of relying on fwrite()
   // and the OS to handle this.
   bool rc = false;
-  if ( m_fp ) 
+  if ( nullptr != m_read_buffer )
+  {
+    const MYON__UINT64 position = m_read_buffer->CurrentPosition();
+    if ( offset < 0 && position < (MYON__UINT64)(-((MYON__INT64)offset)) )
+    {
+      MYON_ERROR("Attempt to seek before the start of the file.");
+    }
+    else if ( m_read_buffer->SeekFromStart(position + (MYON__INT64)offset) )
+    {
+      rc = true;
+    }
+    else
+    {
+      MYON_ERROR("MYON_FileStream::SeekFromStart(m_fp,offset) failed.");
+    }
+  }
+  else if ( m_fp ) 
   {
     if ( nullptr != m_memory_buffer
       && ((MYON__INT_PTR)m_memory_buffer_ptr)+((MYON__INT_PTR)offset) >= 0
@@ -17050,7 +19277,15 @@ bool MYON_BinaryFile::Internal_SeekFromCurrentPositionOverride( int offset )
 bool MYON_BinaryFile::Internal_SeekToStartOverride()
 {
   bool rc = false;
-  if ( m_fp ) 
+  if ( nullptr != m_read_buffer )
+  {
+    rc = m_read_buffer->SeekFromStart(0);
+    if (false == rc)
+    {
+      MYON_ERROR("MYON_FileStream::SeekFromStart(m_fp,0) failed.");
+    }
+  }
+  else if ( m_fp ) 
   {
     Flush(); // don't deal with memory buffer I/O in rare seek from start
     if ( MYON_FileStream::SeekFromStart(m_fp,0) )
@@ -17065,6 +19300,216 @@ bool MYON_BinaryFile::Internal_SeekToStartOverride()
   return rc;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+MYON_BinaryMappedFile::MYON_BinaryMappedFile( MYON::archive_mode archive_mode, const wchar_t* file_system_path ) 
+  : MYON_BinaryArchive( archive_mode )
+{
+  if ( ReadMode() && nullptr != file_system_path && 0 != file_system_path[0] )
+  {
+    FILE* fp = MYON::OpenFile(file_system_path,L"rb");
+    Internal_MapFile(fp);
+    MYON::CloseFile(fp);
+  }
+  else
+  {
+    MYON_ERROR("Invalid parameters");
+  }
+}
+
+MYON_BinaryMappedFile::MYON_BinaryMappedFile( MYON::archive_mode archive_mode, const char* file_system_path ) 
+  : MYON_BinaryArchive( archive_mode )
+{
+  if ( ReadMode() && nullptr != file_system_path && 0 != file_system_path[0] )
+  {
+    FILE* fp = MYON::OpenFile(file_system_path,"rb");
+    Internal_MapFile(fp);
+    MYON::CloseFile(fp);
+  }
+  else
+  {
+    MYON_ERROR("Invalid parameters");
+  }
+}
+
+MYON_BinaryMappedFile::~MYON_BinaryMappedFile()
+{
+  UnmapFile();
+}
+
+bool MYON_BinaryMappedFile::Internal_MapFile( FILE* fp )
+{
+  // The mapping remains valid after fp is closed.
+  if ( nullptr == fp )
+    return false;
+
+  MYON__UINT64 file_size = 0;
+  if ( false == MYON_FileStream::GetFileInformation(fp,&file_size,nullptr,nullptr) || 0 == file_size )
+    return false;
+
+  if ( file_size > (MYON__UINT64)((size_t)-1) )
+  {
+    MYON_ERROR("File is too large to map into this process.");
+    return false;
+  }
+
+#if defined(MYON_RUNTIME_WIN)
+  const HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(fp));
+  if ( INVALID_HANDLE_VALUE == file_handle )
+    return false;
+  HANDLE mapping_handle = ::CreateFileMapping(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if ( nullptr == mapping_handle )
+  {
+    MYON_ERROR("CreateFileMapping() failed.");
+    return false;
+  }
+  const void* view = ::MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+  if ( nullptr == view )
+  {
+    MYON_ERROR("MapViewOfFile() failed.");
+    ::CloseHandle(mapping_handle);
+    return false;
+  }
+  m_mapping_handle = mapping_handle;
+#else
+  const void* view = mmap(nullptr, (size_t)file_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+  if ( MAP_FAILED == view )
+  {
+    MYON_ERROR("mmap() failed.");
+    return false;
+  }
+  // 3dm files are read front to back.
+  madvise(const_cast<void*>(view), (size_t)file_size, MADV_SEQUENTIAL);
+#endif
+
+  m_view = (const unsigned char*)view;
+  m_sizeof_view = file_size;
+  m_view_position = 0;
+  return true;
+}
+
+void MYON_BinaryMappedFile::UnmapFile()
+{
+  if ( nullptr != m_view )
+  {
+#if defined(MYON_RUNTIME_WIN)
+    ::UnmapViewOfFile(m_view);
+    if ( nullptr != m_mapping_handle )
+      ::CloseHandle((HANDLE)m_mapping_handle);
+#else
+    munmap(const_cast<unsigned char*>(m_view), (size_t)m_sizeof_view);
+#endif
+  }
+  m_view = nullptr;
+  m_sizeof_view = 0;
+  m_view_position = 0;
+  m_mapping_handle = nullptr;
+}
+
+bool MYON_BinaryMappedFile::FileIsMapped() const
+{
+  return (nullptr != m_view);
+}
+
+MYON__UINT64 MYON_BinaryMappedFile::SizeOfFile() const
+{
+  return m_sizeof_view;
+}
+
+MYON__UINT64 MYON_BinaryMappedFile::Internal_CurrentPositionOverride() const
+{
+  return m_view_position;
+}
+
+bool MYON_BinaryMappedFile::Internal_SeekFromCurrentPositionOverride( int offset )
+{
+  bool rc = false;
+  if ( nullptr != m_view )
+  {
+    if ( offset >= 0 )
+    {
+      // Seeking to the end of the view is allowed; seeking past it is not.
+      if ( m_view_position <= m_sizeof_view && (MYON__UINT64)offset <= m_sizeof_view - m_view_position )
+      {
+        m_view_position += (MYON__UINT64)offset;
+        rc = true;
+      }
+    }
+    else if ( (MYON__UINT64)(-((MYON__INT64)offset)) <= m_view_position )
+    {
+      m_view_position -= (MYON__UINT64)(-((MYON__INT64)offset));
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+bool MYON_BinaryMappedFile::Internal_SeekToStartOverride()
+{
+  bool rc = false;
+  if ( nullptr != m_view )
+  {
+    m_view_position = 0;
+    rc = true;
+  }
+  return rc;
+}
+
+bool MYON_BinaryMappedFile::AtEnd() const
+{
+  return (m_view_position >= m_sizeof_view);
+}
+
+size_t MYON_BinaryMappedFile::Internal_ReadOverride( size_t count, void* p )
+{
+  if ( 0 == count || nullptr == p || nullptr == m_view )
+    return 0;
+
+  const MYON__UINT64 maxcount 
+    = (m_sizeof_view > m_view_position)
+    ? (m_sizeof_view - m_view_position)
+    : 0;
+  if ( (MYON__UINT64)count > maxcount )
+  {
+    if (false == MaskReadError(count, maxcount))
+    {
+      MYON_ERROR("Attempt to read beyond end of file.");
+    }
+    count = (size_t)maxcount;
+  }
+
+  if ( count > 0 )
+  {
+    memcpy( p, m_view + m_view_position, count );
+    m_view_position += count;
+  }
+
+  return count;
+}
+
+const void* MYON_BinaryMappedFile::Internal_ReadViewOverride( size_t count )
+{
+  if ( nullptr == m_view || m_view_position >= m_sizeof_view || (MYON__UINT64)count > m_sizeof_view - m_view_position )
+    return nullptr;
+  const unsigned char* view = m_view + m_view_position;
+  m_view_position += count;
+  return view;
+}
+
+size_t MYON_BinaryMappedFile::Internal_WriteOverride( size_t, const void* )
+{
+  // MYON_BinaryMappedFile does not support Write() and Flush()
+  return 0;
+}
+
+bool MYON_BinaryMappedFile::Flush()
+{
+  // MYON_BinaryMappedFile does not support Write() and Flush()
+  return false;
+}
+
 MYON_3dmGoo::MYON_3dmGoo()
         : m_typecode(0),
           m_value(0),
@@ -18375,6 +20820,15 @@ size_t MYON_Read3dmBufferArchive::Internal_ReadOverride( size_t count, void* buf
   return count;
 }
 
+const void* MYON_Read3dmBufferArchive::Internal_ReadViewOverride( size_t count )
+{
+  if ( 0 == m_buffer || m_buffer_position >= m_sizeof_buffer || count > m_sizeof_buffer - m_buffer_position )
+    return nullptr;
+  const unsigned char* view = m_buffer + m_buffer_position;
+  m_buffer_position += count;
+  return view;
+}
+
 size_t MYON_Read3dmBufferArchive::Internal_WriteOverride( size_t, const void* )
 {
   // MYON_Read3dmBufferArchive does not support Write() and Flush()
@@ -698,6 +698,36 @@ public:
     MYON_wString& assigned_name
     );
 
+  /*
+  Description:
+    Add many components to this manifest at once.
+  Parameters:
+    items - [in]
+      The component type, runtime serial number, id and name hash of each 
+      component. The item indices are ignored. Manifest indices are assigned
+      to components that require an index.
+    bResolveIdAndNameCollisions - [in]
+      If false, then items whose id is in use or whose required unique name
+      is not valid or is in use are not added.
+      If true, then new ids and names are assigned as needed.
+    manifest_items - [out]
+      If not nullptr, the identification information assigned to each item is
+      appended. MYON_ComponentManifestItem::UnsetItem is appended for items that 
+      were not added.
+  Returns:
+    Number of items added to this manifest.
+  Remarks:
+    The index lists and the id and name hash tables are sized for the
+    final item count before any items are added. This is much faster 
+    than calling AddComponentToManifest() for each item when importing 
+    large tables.
+  */
+  unsigned int AddComponentsToManifest(
+    const MYON_SimpleArray<MYON_ComponentManifestItem>& items,
+    bool bResolveIdAndNameCollisions,
+    MYON_SimpleArray<MYON_ComponentManifestItem>* manifest_items
+    );
+
 
   /*
   Description:
@@ -1069,6 +1099,17 @@ public:
   */
   MYON__UINT64 ManifestContentVersionNumber() const;
 
+  /*
+  Description:
+    Tidies the manifest's internal search structures.
+  Remarks:
+    After calling PrepareForConcurrentReaders(), and until the manifest
+    is modified, the const functions that find items by index, id, 
+    name or component runtime serial number do not modify the manifest
+    and may be called from multiple threads at the same time.
+  */
+  void PrepareForConcurrentReaders();
+
 private:
   const class MYON_ComponentManifestItem* Internal_AddItem(
     class MYON_ComponentManifestItem& item,
@@ -1891,6 +1932,313 @@ public:
   MYON_3dmArchiveTableStatus::TableState m_state = MYON_3dmArchiveTableStatus::TableState::Unset;
 };
 
+/*
+Description:
+  An MYON_3dmDeferredObject is an object table record that has been read
+  from a 3dm archive but whose object has not been decoded yet.
+  MYONX_Model::Read() uses it to decode object table records on 
+  multiple threads.
+See Also:
+  MYON_BinaryArchive::Read3dmObjectForExperts()
+  MYON_BinaryArchive::Decode3dmDeferredObject()
+  MYON_BinaryArchive::Finish3dmDeferredObject()
+*/
+class MYON_CLASS MYON_3dmDeferredObject
+{
+public:
+  MYON_3dmDeferredObject() = default;
+  ~MYON_3dmDeferredObject();
+
+  /*
+  Description:
+    Deletes any object that has not been handed to 
+    MYON_BinaryArchive::Finish3dmDeferredObject() and
+    frees the serialized object.
+  */
+  void Destroy();
+
+  /*
+  Returns:
+    True if the serialized object is waiting to be decoded.
+  */
+  bool DecodePending() const;
+
+  /*
+  Returns:
+    Number of bytes in the serialized object.
+  */
+  size_t SizeOfSerializedObject() const;
+
+  /*
+  Returns:
+    If the record references an object saved earlier in the object table
+    (see MYON_BinaryArchive::SetDeduplicateGeometry()), the decoded object
+    that is shared by every record that references it. 
+    Otherwise an empty shared_ptr.
+  */
+  const std::shared_ptr<class MYON_Object>& SharedObject() const;
+
+private:
+  friend class MYON_BinaryArchive;
+
+  // Read3dmObject() style return code
+  int m_rc = 0;
+
+  class MYON_Object* m_object = nullptr;
+
+#pragma MYON_PRAGMA_WARNING_PUSH
+#pragma MYON_PRAGMA_WARNING_DISABLE_MSC( 4251 ) 
+  // C4251: ... needs to have dll-interface to be used by clients of class ...
+  // m_shared_object is private and all code that manages it is explicitly implemented in the DLL.
+  // Set when the record references an object saved earlier.
+  std::shared_ptr<class MYON_Object> m_shared_object;
+#pragma MYON_PRAGMA_WARNING_POP
+
+  // m_serialized_object points into an in-memory archive (see 
+  // MYON_BinaryArchive::ReadByteView()) or at m_buffer.
+  const void* m_serialized_object = nullptr;
+  size_t m_sizeof_serialized_object = 0;
+  void* m_buffer = nullptr;
+
+  // errors detected while decoding
+  unsigned int m_crc_error_count = 0;
+  unsigned int m_critical_error_count = 0;
+
+private:
+  MYON_3dmDeferredObject(const MYON_3dmDeferredObject&) = delete;
+  MYON_3dmDeferredObject& operator=(const MYON_3dmDeferredObject&) = delete;
+};
+
+/*
+Description:
+  An MYON_3dmEncodedObject is an object that has been serialized
+  into memory so the object table record can be written later.
+  MYONX_Model::Write() uses it to serialize objects on multiple threads.
+See Also:
+  MYON_BinaryArchive::Encode3dmObject()
+  MYON_BinaryArchive::Write3dmObjectForExperts()
+*/
+class MYON_CLASS MYON_3dmEncodedObject
+{
+public:
+  MYON_3dmEncodedObject() = default;
+  ~MYON_3dmEncodedObject();
+
+  /*
+  Description:
+    Frees the serialized object.
+  */
+  void Destroy();
+
+  /*
+  Returns:
+    True if the object has been serialized.
+  */
+  bool IsEncoded() const;
+
+  /*
+  Returns:
+    Number of bytes in the serialized object.
+  */
+  size_t SizeOfSerializedObject() const;
+
+private:
+  friend class MYON_BinaryArchive;
+
+  // complete TCODE_OPENNURBS_CLASS chunk allocated with onmalloc()
+  void* m_buffer = nullptr;
+  size_t m_sizeof_buffer = 0;
+
+  // SHA-1 hash of m_buffer[] when the archive deduplicates geometry
+  MYON_SHA1_Hash m_content_hash;
+
+private:
+  MYON_3dmEncodedObject(const MYON_3dmEncodedObject&) = delete;
+  MYON_3dmEncodedObject& operator=(const MYON_3dmEncodedObject&) = delete;
+};
+
+class MYON_CLASS MYON_3dmObjectTableIndexItem
+{
+public:
+  MYON_3dmObjectTableIndexItem() = default;
+  ~MYON_3dmObjectTableIndexItem() = default;
+  MYON_3dmObjectTableIndexItem(const MYON_3dmObjectTableIndexItem&) = default;
+  MYON_3dmObjectTableIndexItem& operator=(const MYON_3dmObjectTableIndexItem&) = default;
+
+  static const MYON_3dmObjectTableIndexItem Unset;
+
+  // object id from the record's attributes
+  MYON_UUID m_id = MYON_nil_uuid;
+
+  // MYON_ClassId uuid of the object
+  MYON_UUID m_class_id = MYON_nil_uuid;
+
+  // archive offset of the TCODE_OBJECT_RECORD chunk
+  MYON__UINT64 m_record_offset = 0;
+
+  // MYON::object_type value from the record
+  unsigned int m_object_type = 0;
+
+  // model layer index from the record's attributes
+  int m_layer_index = MYON_UNSET_INT_INDEX;
+};
+
+/*
+Description:
+  MYON_3dmObjectTableIndex maps object ids, object types and layers to 
+  the archive offsets of object table records so individual objects can
+  be read from a 3dm archive without reading the entire object table.
+Example:
+
+          // First time the file is opened
+          MYONX_Model model;
+          MYON_3dmObjectTableIndex index;
+          model.IncrementalReadBegin(archive, true, 0, nullptr);
+          index.Create(archive);
+          ... use MYON_3dmObjectTableIndex::Write() to cache the index
+
+          // Later
+          ... use MYON_3dmObjectTableIndex::Read() to read the cached index
+          model.IncrementalReadBegin(archive, true, 0, nullptr);
+          if ( index.IsValidForArchive(archive) )
+          {
+            MYON_ModelComponentReference mcr;
+            model.IncrementalReadModelGeometry(archive, index.ItemFromId(id), true, true, true, mcr);
+            ...
+            model.IncrementalReadSkipModelGeometry(archive, index);
+            model.IncrementalReadFinish(archive, true, 0, nullptr);
+          }
+
+See Also:
+  MYONX_Model::IncrementalReadModelGeometry()
+*/
+class MYON_CLASS MYON_3dmObjectTableIndex
+{
+public:
+  MYON_3dmObjectTableIndex() = default;
+  ~MYON_3dmObjectTableIndex() = default;
+  MYON_3dmObjectTableIndex(const MYON_3dmObjectTableIndex&) = default;
+  MYON_3dmObjectTableIndex& operator=(const MYON_3dmObjectTableIndex&) = default;
+
+  /*
+  Description:
+    Create an index by reading the archive's object table. Object
+    attributes are read. Objects are skipped and are not decoded.
+  Parameters:
+    archive - [in]
+      The archive must be positioned at the start of the object table.
+      Typically MYONX_Model::IncrementalReadBegin() was just called.
+      When Create() returns true, the object table is active and the
+      archive is positioned at the first object table record.
+  Returns:
+    True if successful.
+    False if the archive cannot be read or it has changes appended by
+    MYONX_Model::AppendChanges(). Appended changes can modify or 
+    delete objects in the object table, so those archives are not indexed.
+  */
+  bool Create(
+    class MYON_BinaryArchive& archive
+    );
+
+  void Destroy();
+
+  /*
+  Parameters:
+    archive - [in]
+      If the object table is not started, the archive must be positioned
+      at the start of the object table. The chunks after the object table
+      are skipped to find the end mark and then the archive is returned 
+      to the start of the object table.
+  Returns:
+    True if the archive's version numbers, object table location and size,
+    and the file length saved in the end mark match the archive used to 
+    create this index and the archive does not have appended changes.
+  Remarks:
+    Call after MYONX_Model::IncrementalReadBegin() or Create().
+    When the object table is active, the end mark cannot be read and only
+    the version numbers and the object table location and size are checked.
+  */
+  bool IsValidForArchive(
+    class MYON_BinaryArchive& archive
+    ) const;
+
+  /*
+  Returns:
+    Number of records in the index.
+  */
+  unsigned int ItemCount() const;
+
+  /*
+  Parameters:
+    item_index - [in]
+      zero based index in the order the records appear in the archive.
+  Returns:
+    The item or nullptr if item_index is out of range.
+  */
+  const MYON_3dmObjectTableIndexItem* Item(
+    unsigned int item_index
+    ) const;
+
+  /*
+  Returns:
+    The item with the specified id or nullptr if there is not one.
+  */
+  const MYON_3dmObjectTableIndexItem* ItemFromId(
+    MYON_UUID id
+    ) const;
+
+  /*
+  Parameters:
+    object_type_filter - [in]
+      0 or a bitfield made by or-ing MYON::object_type values.
+    layer_index - [in]
+      MYON_UNSET_INT_INDEX or a model layer index.
+    items - [out]
+      items that pass the filters are appended in archive order.
+  Returns:
+    Number of items appended.
+  */
+  unsigned int GetItems(
+    unsigned int object_type_filter,
+    int layer_index,
+    MYON_SimpleArray< const MYON_3dmObjectTableIndexItem* >& items
+    ) const;
+
+  /*
+  Returns:
+    Archive offset of the object table's TCODE_ENDOFTABLE chunk.
+  */
+  MYON__UINT64 EndOfTableOffset() const;
+
+  bool Write(
+    class MYON_BinaryArchive& archive
+    ) const;
+
+  bool Read(
+    class MYON_BinaryArchive& archive
+    );
+
+private:
+  void Internal_SortById();
+
+  int m_archive_3dm_version = 0;
+  unsigned int m_archive_opennurbs_version = 0;
+  MYON__UINT64 m_object_table_offset = 0;
+  MYON__UINT64 m_end_of_table_offset = 0;
+
+  // archive offset of the first byte after the object table chunk
+  MYON__UINT64 m_object_table_end_offset = 0;
+
+  // file length saved in the archive's end mark
+  MYON__UINT64 m_end_mark_file_length = 0;
+
+  // items in archive order
+  MYON_SimpleArray< MYON_3dmObjectTableIndexItem > m_items;
+
+  // m_items[m_id_order[i]].m_id is sorted
+  MYON_SimpleArray< unsigned int > m_id_order;
+};
+
 class MYON_CLASS MYON_BinaryArchive // use for generic serialization of binary data
 {
 public:
@@ -2022,6 +2370,29 @@ public:
   */
   MYON__UINT64 ReadBuffer( MYON__UINT64 sizeof_buffer, void* buffer );
 
+  /*
+  Description:
+    Expert user function to get read-only access to the next sizeof_view
+    bytes of an archive whose contents are already in memory without 
+    copying them. MYON_BinaryMappedFile and MYON_Read3dmBufferArchive 
+    support views.
+  Parameters:
+    sizeof_view - [in] number of bytes to view.
+  Returns:
+    If the archive supports views and sizeof_view bytes are available,
+    a pointer to those bytes is returned and the current position is
+    advanced exactly as if ReadByte(sizeof_view,...) had been called.
+    Otherwise nullptr is returned, the current position is not changed
+    and the caller should use ReadByte() to copy the bytes.
+  Remarks:
+    The returned pointer points into the archive's memory and is valid 
+    until that memory is released. For an MYON_BinaryMappedFile this 
+    happens when MYON_BinaryMappedFile::UnmapFile() is called or the 
+    archive is destroyed. For an MYON_Read3dmBufferArchive it happens when
+    the archive is destroyed or the buffer passed to it is freed.
+  */
+  const void* ReadByteView( size_t sizeof_view );
+
   /*
   Description:
     Expert user function to control CRC calculation while reading and writing.
@@ -2944,6 +3315,222 @@ public:
   */
   bool UseBufferCompression() const;
 
+  /*
+  Description:
+    Set the maximum number of threads WriteCompressedBuffer() and 
+    ReadCompressedBuffer() use to deflate and inflate large buffers.
+  Parameters:
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: deflate and inflate on the calling thread (default).
+      > 1: use at most thread_count threads.
+  Remarks:
+    When the thread count is not 1, WriteCompressedBuffer() splits buffers
+    larger than MYON_BinaryArchive::CompressedBufferBlockSize into blocks
+    that are deflated independently. ReadCompressedBuffer() inflates those
+    blocks on multiple threads. Buffers written this way cannot be read by
+    opennurbs versions that predate the block format.
+    Smaller buffers are always written in the format every version can read.
+  */
+  void SetCompressionThreadCount(
+    unsigned int thread_count
+  );
+
+  /*
+  Returns:
+    The value set by SetCompressionThreadCount().
+  */
+  unsigned int CompressionThreadCount() const;
+
+  /*
+  Description:
+    Expert batch readers call BeginThreadCompressorReuseForExperts() on 
+    a thread before reading a sequence of archives on that thread and
+    EndThreadCompressorReuseForExperts() when they are finished.
+    In between, ReadCompressedBuffer() resets the zlib inflate stream
+    instead of ending it, and the zlib buffers of an archive destroyed 
+    on the thread are used again by the next archive that needs them. 
+    This avoids allocating zlib buffers for every compressed buffer
+    and every archive.
+  Remarks:
+    Calls may be nested. The thread's zlib buffers are freed when the 
+    outermost EndThreadCompressorReuseForExperts() is called.
+  */
+  static void BeginThreadCompressorReuseForExperts();
+  static void EndThreadCompressorReuseForExperts();
+
+  /*
+  Description:
+    Enable or disable geometry deduplication when writing the object table.
+  Parameters:
+    bDeduplicateGeometry - [in]
+      true:
+        Points, point clouds, curves, surfaces, breps, extrusions, meshes and 
+        SubDs are serialized and hashed with MYON_SHA1. When the serialized 
+        object is identical to one already written in the object table, the 
+        record saves a short reference to the earlier object instead of the
+        object. The record's attributes are always written.
+      false: 
+        Every object is written (default).
+  Remarks:
+    Readers that include this feature resolve references to the earlier
+    object and each unique object is decoded once. MYONX_Model::Read() and
+    Read3dmModelGeometryForExperts() with bManageGeometry = true and 
+    bManageAttributes = true share the decoded object between the components. Read3dmObject() returns a copy.
+    WARNING: Earlier versions of opennurbs, and every application built with
+    them, silently discard the objects in referencing records. No error is
+    reported and those objects are lost when the archive is read or saved
+    again by those applications. Only enable deduplication when every reader
+    of the archive is known to support references.
+  */
+  void SetDeduplicateGeometry(
+    bool bDeduplicateGeometry
+  );
+
+  /*
+  Returns:
+    The value set by SetDeduplicateGeometry().
+  */
+  bool DeduplicateGeometry() const;
+
+  /*
+  Description:
+    Expert user function to keep unknown user data in the memory of this 
+    archive instead of copying it into MYON_UnknownUserData::m_buffer.
+  Parameters:
+    archive_memory_owner - [in]
+      Keeps the memory returned by ReadByteView() valid. Typically this is
+      the std::shared_ptr that manages this MYON_BinaryMappedFile.
+      Pass an empty shared_ptr to copy unknown user data (default).
+  Remarks:
+    When the owner is set and ReadByteView() is supported, user data whose
+    class is not available is read into an MYON_UnknownUserDataReference
+    that references the bytes in this archive. No heap buffer is allocated
+    and the bytes are written directly to the destination archive when
+    the object is saved.
+    Set an empty owner when reading is finished. Otherwise an owner that
+    manages this archive is never released.
+  */
+  void SetUnknownUserDataReferenceOwner(
+    const std::shared_ptr<const void>& archive_memory_owner
+    );
+
+  /*
+  Returns:
+    The owner set by SetUnknownUserDataReferenceOwner().
+  */
+  const std::shared_ptr<const void>& UnknownUserDataReferenceOwner() const;
+
+  /*
+  Description:
+    Enable or disable compact storage of mesh vertex arrays.
+  Parameters:
+    mesh_quantization_tolerance - [in]
+      > 0:
+        MYON_Mesh::Write() quantizes vertex locations to the mesh's bounding
+        box using 16 or 21 bits per coordinate, whichever is the fewest bits 
+        that keep every vertex within mesh_quantization_tolerance of its
+        full precision location. Vertex normals are octahedron encoded with
+        16 bits per component and texture coordinates are saved as half 
+        floats when every value round trips within 1/2048.
+        An array that cannot be compacted within these bounds is saved with
+        full precision.
+      0 or MYON_UNSET_VALUE: 
+        Meshes are saved with full precision (default).
+  Remarks:
+    Compact meshes do not save double precision vertices and can only be 
+    read by opennurbs versions that include this feature. Earlier versions
+    fail to read the mesh. Compact storage is used only in version 6 and
+    later archives.
+  */
+  void SetMeshQuantizationTolerance(
+    double mesh_quantization_tolerance
+  );
+
+  /*
+  Returns:
+    The value set by SetMeshQuantizationTolerance().
+  */
+  double MeshQuantizationTolerance() const;
+
+  /*
+  Description:
+    Enable or disable compact storage of mesh face arrays.
+  Parameters:
+    bCompactMeshFaces - [in]
+      true:
+        MYON_Mesh::Write() saves m_F[] as compressed streams of short 
+        codes that refer to recently used vertices and small index 
+        differences. Faces are saved in their current order. Call
+        MYON_Mesh::OptimizeFaceOrderForVertexCache() first to get the
+        smallest face arrays.
+      false:
+        Faces are saved as 1, 2 or 4 byte indices (default).
+  Remarks:
+    Compact face arrays can only be read by opennurbs versions that 
+    include this feature. Earlier versions fail to read the mesh.
+    Compact storage is used only in version 6 and later archives.
+  */
+  void SetCompactMeshFaces(
+    bool bCompactMeshFaces
+  );
+
+  /*
+  Returns:
+    The value set by SetCompactMeshFaces().
+  */
+  bool CompactMeshFaces() const;
+
+  enum : unsigned int
+  {
+    // Number of uncompressed bytes in each block of a buffer that is
+    // deflated on multiple threads.
+    CompressedBufferBlockSize = 0x100000
+  };
+
+  /*
+  Description:
+    Enable or disable profiling. While profiling is enabled, the archive
+    records the number of chunks, byte counts and elapsed times for
+    each chunk typecode and for each MYON_ClassId that is read or written.
+  Parameters:
+    bEnable - [in]
+      true: Discard anything previously recorded and start profiling.
+      false: Stop profiling. The recorded information is kept until
+             profiling is enabled again or the archive is destroyed.
+  Remarks:
+    Profiling reads a clock at the beginning and end of every chunk and
+    object, so it should not be enabled in production code.
+  */
+  void EnableProfiling(
+    bool bEnable
+  );
+
+  /*
+  Returns:
+    True if profiling is enabled.
+  */
+  bool ProfilingEnabled() const;
+
+  /*
+  Description:
+    Print the information recorded while profiling was enabled.
+    For each chunk typecode and each MYON_ClassId the report lists
+    the count, bytes, total seconds (including nested chunks or objects),
+    self seconds (excluding nested chunks or objects) and the seconds
+    spent in WriteCompressedBuffer()/ReadCompressedBuffer().
+  Parameters:
+    text_log - [in]
+  Remarks:
+    Objects decoded on other threads by Decode3dmDeferredObject() are
+    included, so the sum of the times can exceed the elapsed time.
+    Total seconds of a typecode that nests inside itself count the nested
+    chunks more than once.
+  */
+  void DumpProfile(
+    MYON_TextLog& text_log
+  ) const;
+
 
   /*
   Description:
@@ -3214,6 +3801,37 @@ public:
   bool Read3dmSettings(
         class MYON_3dmSettings&
         );
+
+  /*
+  Description:
+    Writes the settings table with a TCODE_SETTINGS_MODEL_GEOMETRY_BBOX
+    record that saves the bounding box of the model geometry. Readers
+    that do not know about the record skip it.
+  Parameters:
+    settings - [in]
+    model_geometry_bbox - [in]
+      If model_geometry_bbox is not valid, no bounding box is saved.
+  */
+  bool Write3dmSettings(
+    const class MYON_3dmSettings& settings,
+    const MYON_BoundingBox& model_geometry_bbox
+    );
+
+  /*
+  Description:
+    Reads the settings table and the bounding box saved by
+    Write3dmSettings(settings,model_geometry_bbox).
+  Parameters:
+    settings - [out]
+    model_geometry_bbox - [out]
+      If not nullptr, the saved bounding box is returned here.
+      If the archive does not have a saved bounding box,
+      MYON_BoundingBox::UnsetBoundingBox is returned.
+  */
+  bool Read3dmSettings(
+    class MYON_3dmSettings& settings,
+    MYON_BoundingBox* model_geometry_bbox
+    );
   
   /*
   Returns:
@@ -3650,6 +4268,53 @@ public:
          const MYON_Object&,
          const MYON_3dmObjectAttributes* // optional
          );
+
+  /*
+  Description:
+    Expert user function used to write the object table on multiple threads.
+    Serializes the TCODE_OPENNURBS_CLASS chunk that Write3dmObject() would
+    write for object into encoded_object. Only points, point clouds, curves,
+    surfaces, breps, extrusions, meshes and SubDs are encoded, because they
+    do not reference the archive's component tables when they are written.
+  Parameters:
+    object - [in]
+    encoded_object - [out]
+  Returns:
+    True if the object was encoded. False if the object's type cannot be
+    encoded or writing failed. In either case, Write3dmObjectForExperts()
+    writes the object on the calling thread.
+  Remarks:
+    This archive is not modified and Encode3dmObject() may be called on 
+    different objects from multiple threads at the same time.
+  */
+  bool Encode3dmObject(
+    const MYON_Object& object,
+    MYON_3dmEncodedObject& encoded_object
+    ) const;
+
+  /*
+  Description:
+    Works like Write3dmObject() except the serialized object in 
+    encoded_object is copied into the archive. If encoded_object is
+    empty, the object is serialized on the calling thread.
+  Parameters:
+    object - [in]
+      The object passed to Encode3dmObject().
+    attributes - [in]
+      optional
+    encoded_object - [in]
+      Value set by Encode3dmObject() or empty. 
+  Returns:
+    True if successful.
+  Remarks:
+    Records are written in the order Write3dmObjectForExperts() is called.
+  */
+  bool Write3dmObjectForExperts(
+    const MYON_Object& object,
+    const MYON_3dmObjectAttributes* attributes,
+    const MYON_3dmEncodedObject& encoded_object
+    );
+
   bool EndWrite3dmObjectTable();
 
   bool BeginRead3dmObjectTable();
@@ -3677,6 +4342,10 @@ public:
   Parameters:
     bManageGeometry - [in]
       true: model_geometry will reference count and delete the MYON_Geometry pointer.
+        When the record references geometry saved earlier in the object table
+        (see SetDeduplicateGeometry()) and bManageAttributes is true, the geometry
+        is shared with the other components that reference it and 
+        ExclusiveGeometry() returns nullptr.
       false: The caller must delete the MYON_Geometry pointer.
     bManageAttributes - [in]
       true: model_geometry will reference count and delete the MYON_3dmObjectAttributes pointer.
@@ -3720,7 +4389,133 @@ public:
     unsigned int object_filter = 0
     );
 
+  /*
+  Description:
+    Expert user function used to decode the object table on multiple threads.
+    Works like Read3dmObject() except the object is returned in deferred_object.
+    Objects that can be decoded without referencing this archive's component
+    tables (points, curves, surfaces, breps, extrusions, meshes and SubDs) are
+    not decoded. Their serialized bytes are saved in deferred_object and 
+    Decode3dmDeferredObject() decodes them later.
+  Parameters:
+    attributes - [out]
+      If not nullptr, then attributes are returned here
+    object_filter - [in]
+      optional filter made by setting MYON::object_type bits
+    deferred_object - [out]
+  Returns:
+     0 at end of object table
+     1 if the record is read. Call Finish3dmDeferredObject() to get the object.
+     2 if object is skipped because it does not match filter
+    -1 if file is corrupt
+  Remarks:
+    Finish3dmDeferredObject() must be called in the order that the records
+    were read, because it updates the archive's manifest.
+  */
+  int Read3dmObjectForExperts(
+    MYON_3dmObjectAttributes* attributes,
+    unsigned int object_filter,
+    MYON_3dmDeferredObject& deferred_object
+    );
+
+  /*
+  Description:
+    Decodes an object saved by Read3dmObjectForExperts().
+    This archive is not modified and Decode3dmDeferredObject() may be 
+    called on different deferred objects from multiple threads at the 
+    same time.
+  Returns:
+    True if the object was decoded.
+  */
+  bool Decode3dmDeferredObject(
+    MYON_3dmDeferredObject& deferred_object
+    ) const;
+
+  /*
+  Description:
+    Completes reading an object table record started by Read3dmObjectForExperts().
+    If the object has not been decoded, it is decoded on the calling thread.
+  Parameters:
+    deferred_object - [in]
+    model_object - [out]
+      The caller must delete the returned object.
+      If deferred_object.SharedObject() is not empty, a copy of the shared
+      object is returned. Callers that use the shared object get it before 
+      calling Finish3dmDeferredObject() and pass nullptr.
+    attributes - [in/out]
+      attributes returned by Read3dmObjectForExperts().
+  Returns:
+     1 if object is read
+     3 if the object's class is not registered
+    -1 if file is corrupt
+  */
+  int Finish3dmDeferredObject(
+    MYON_3dmDeferredObject& deferred_object,
+    MYON_Object** model_object,
+    MYON_3dmObjectAttributes* attributes
+    );
+
+  /*
+  Description:
+    Completes reading an object table record started by Read3dmObjectForExperts()
+    without decoding the object. The attributes and the archive's manifest are
+    updated exactly as Finish3dmDeferredObject() does. Use Create3dmDeferredObject() 
+    to decode the object later.
+  Parameters:
+    deferred_object - [in]
+      deferred_object.DecodePending() must be true.
+    attributes - [in/out]
+      attributes returned by Read3dmObjectForExperts().
+  Returns:
+     1 if the record is finished.
+    -1 if deferred_object is not pending or attributes is nullptr.
+  */
+  int Finish3dmDeferredObjectAttributes(
+    MYON_3dmDeferredObject& deferred_object,
+    MYON_3dmObjectAttributes* attributes
+    );
+
+  /*
+  Description:
+    Decodes an object whose record was completed by Finish3dmDeferredObjectAttributes().
+    The archive must exist until the object is decoded, but its read position
+    does not matter. This archive is not modified and Create3dmDeferredObject()
+    may be called on different deferred objects from multiple threads at the 
+    same time.
+  Parameters:
+    deferred_object - [in]
+    attributes - [in]
+      attributes returned by Finish3dmDeferredObjectAttributes().
+  Returns:
+    The object created by operator new. The caller must delete the returned object.
+    nullptr if the object cannot be decoded.
+  */
+  MYON_Object* Create3dmDeferredObject(
+    MYON_3dmDeferredObject& deferred_object,
+    const MYON_3dmObjectAttributes* attributes
+    ) const;
+
 private:
+  int Internal_Read3dmObject(
+    MYON_Object** model_object,
+    MYON_3dmObjectAttributes* attributes,
+    unsigned int object_filter,
+    MYON_3dmDeferredObject* deferred_object,
+    std::shared_ptr<MYON_Object>* shared_object
+    );
+
+  bool Internal_Write3dmObject(
+    const MYON_Object& object,
+    const MYON_3dmObjectAttributes* attributes,
+    const MYON_3dmEncodedObject* encoded_object
+    );
+
+  // model_object is nullptr when decoding the object is deferred
+  void Internal_Finish3dmObject(
+    MYON_Object** model_object,
+    MYON_3dmObjectAttributes* attributes
+    );
+
   /*
   Description:
     In rare cases one object must be converted into another.
@@ -3914,6 +4709,69 @@ public:
            size_t* // sizeof_archive
            );
 
+  // Description:
+  //   Writes a TCODE_ENDOFFILE chunk after a section that is
+  //   appended to an existing 3dm archive.  The chunk does not go
+  //   through the table sequence used by Write3dmEndMark(), so it
+  //   can be written to an archive that only contains the appended
+  //   section.
+  //
+  // Parameters:
+  //   sizeof_preceding_archive - [in]
+  //     number of bytes in the archive the section is appended to.
+  //     The file length saved in the end mark is this value plus
+  //     the number of bytes written to this archive.
+  //
+  // Returns:
+  //   true if successful, false if unable to write to archive.
+  bool Write3dmAppendedEndMark(
+    MYON__UINT64 sizeof_preceding_archive
+    );
+
+  // Description:
+  //   Reads the TCODE_ENDOFFILE chunk written by Write3dmAppendedEndMark().
+  //
+  // Parameters:
+  //   sizeof_archive - [out] number of bytes in the archive
+  //
+  // Returns:
+  //   true if successful, false if unable to find or read
+  //   a TCODE_ENDOFFILE chunk.
+  bool Read3dmAppendedEndMark(
+    size_t* sizeof_archive
+    );
+
+  // Returns:
+  //   True if the next chunk is a TCODE_APPENDED_CHANGES_TABLE chunk.
+  //   False at the end of the archive and for every other chunk.
+  bool AtAppended3dmChanges();
+
+  // Description:
+  //   Skips the table at the current position without reading
+  //   its records. The record chunks are counted and then
+  //   skipped by seeking past them.
+  //
+  // Parameters:
+  //   table - [in]
+  //     bitmap_table, texture_mapping_table, material_table,
+  //     linetype_table, layer_table, group_table, text_style_table,
+  //     dimension_style_table, light_table, hatchpattern_table,
+  //     instance_definition_table, object_table or historyrecord_table.
+  //     Tables must be skipped in the order they appear in 3dm archives.
+  //   record_count - [out]
+  //     If not nullptr, the number of records in the table is returned here.
+  //
+  // Returns:
+  //   True if successful. A table the archive does not contain is
+  //   skipped with a record count of zero.
+  //
+  // Remarks:
+  //   Version 1 archives do not have tables and cannot be skipped.
+  bool Skip3dmTable(
+    MYON_3dmArchiveTableType table,
+    unsigned int* record_count
+    );
+
   ///////////////////////////////////////////////////////////////////
   ///////////////////////////////////////////////////////////////////
   // Low level tools to  Write/Read chunks. See opennurbs_3dm.h for details
@@ -4395,7 +5253,33 @@ protected:
   */
   virtual size_t Internal_ReadOverride( size_t, void* ) = 0; 
 
+  /*
+  Description:
+    Archives whose contents are in memory override this function
+    so ReadByteView() can return a pointer to the contents instead
+    of copying them.
+  Returns:
+    A pointer to count bytes at the current position and the position
+    is advanced by count (like Internal_ReadOverride()).
+    nullptr if a view is not available. In this case the position 
+    must not be changed.
+  Remarks:
+    The default implementation returns nullptr.
+  */
+  virtual const void* Internal_ReadViewOverride( size_t count );
+
 private:
+  /*
+  Description:
+    ReadByteView() and ReadInflate() use this function.
+  Parameters:
+    count - [in] number of bytes to view.
+    bChunkBoundaryError - [out]
+      True if count bytes are not in the current chunk. The error
+      has been reported and the caller should not try ReadByte().
+  */
+  const void* Internal_ReadByteView( size_t count, bool& bChunkBoundaryError );
+
   /*
   Description:
     Works like the C runtrim fwrite().
@@ -4828,6 +5712,7 @@ public:
 private:
   class MYON_CompressorImplementation* m_compressor = nullptr;
   class MYON_CompressorImplementation& Compressor();
+  void Internal_ReleaseCompressor();
 
   // returns number of bytes written
   size_t WriteDeflate(
@@ -4838,6 +5723,16 @@ private:
         size_t,  // sizeof uncompressed input data
         void* // buffer to hold uncompressed data
         );
+  // returns number of bytes written
+  size_t WriteBlockDeflate(
+        size_t,         // sizeof uncompressed input data
+        const void*,    // uncompressed input data
+        unsigned int    // thread count
+        );
+  bool ReadBlockInflate(
+        size_t,  // sizeof uncompressed input data
+        void*    // buffer to hold uncompressed data
+        );
   bool CompressionInit();
   void CompressionEnd();
 
@@ -4877,6 +5772,45 @@ private:
 
   bool m_bUseBufferCompression = true;
 
+  // See SetCompressionThreadCount()
+  unsigned int m_compression_thread_count = 1;
+
+  // See SetDeduplicateGeometry()
+  bool m_bDeduplicateGeometry = false;
+  class MYON_3dmObjectDeduplication* m_deduplication = nullptr;
+  bool Internal_Write3dmObjectReference(
+    MYON__UINT64 source_offset,
+    size_t sizeof_source
+    );
+  int Internal_Read3dmObjectReference(
+    MYON_Object** model_object,
+    std::shared_ptr<MYON_Object>* shared_object
+    );
+
+  // See SetUnknownUserDataReferenceOwner()
+#pragma MYON_PRAGMA_WARNING_PUSH
+#pragma MYON_PRAGMA_WARNING_DISABLE_MSC( 4251 ) 
+  // C4251: ... needs to have dll-interface to be used by clients of class ...
+  // m_unknown_user_data_reference_owner is private and all code that manages it is explicitly implemented in the DLL.
+  std::shared_ptr<const void> m_unknown_user_data_reference_owner;
+#pragma MYON_PRAGMA_WARNING_POP
+
+  // See SetMeshQuantizationTolerance()
+  double m_mesh_quantization_tolerance = 0.0;
+
+  // See SetCompactMeshFaces()
+  bool m_bCompactMeshFaces = false;
+
+  // See EnableProfiling()
+  class MYON_BinaryArchiveProfile* m_profile = nullptr;
+  bool m_bProfilingEnabled = false;
+  void Internal_ProfileBeginChunk();
+  void Internal_ProfileEndChunk();
+  void Internal_ProfileBeginObject();
+  void Internal_ProfileEndObject(const MYON_ClassId* class_id, MYON__UINT64 byte_count);
+  void Internal_ProfileBeginCompression();
+  void Internal_ProfileEndCompression();
+
   bool m_bReservedA = false;
   bool m_bReservedB = false;
   bool m_bReservedC = false;
@@ -5471,6 +6405,39 @@ public:
          int=16384 // capacity of memory buffer
          );
 
+  /*
+  Description:
+    Read the file in large blocks instead of calling fread() for every
+    small ReadInt(), ReadDouble() and chunk header read.
+    Call EnableReadBuffer() immediately after constructing
+    the MYON_BinaryFile in read mode.
+  Parameters:
+    buffer_capacity - [in]
+      Size of each block in bytes. 0 disables read buffering.
+    bReadAhead - [in]
+      If true, one background thread is started for this file and it 
+      reads the block after the one being parsed, so parsing rarely waits
+      on file I/O. The thread is stopped when read buffering is disabled.
+      If false (default), blocks are read on the calling thread.
+  Returns:
+    True if read buffering is enabled.
+  Remarks:
+    While read buffering is enabled, the FILE* passed to the constructor
+    must not be used by anything else. Call EnableReadBuffer(0) or destroy
+    the MYON_BinaryFile before closing the FILE*. EnableReadBuffer(0)
+    positions the FILE* at CurrentPosition().
+  */
+  bool EnableReadBuffer(
+    size_t buffer_capacity = 0x400000,
+    bool bReadAhead = false
+    );
+
+  /*
+  Returns:
+    True if EnableReadBuffer() has enabled read buffering.
+  */
+  bool ReadBufferIsEnabled() const;
+
   /*
   Returns:
     True if a file stream is open (nullptr != m_fp).
@@ -5495,6 +6462,10 @@ private:
   size_t m_memory_buffer_ptr = 0;
   unsigned char* m_memory_buffer = nullptr;
 
+  // if m_read_buffer is not nullptr, then Read() copies from
+  // blocks read by EnableReadBuffer()'s block reader.
+  class MYON_BinaryFileReadBuffer* m_read_buffer = nullptr;
+
 private:
   // prohibit default construction, copy construction, and operator=
   MYON_BinaryFile() = delete;
@@ -5502,6 +6473,101 @@ private:
   MYON_BinaryFile& operator=(const MYON_BinaryFile&) = delete;
 };
 
+class MYON_CLASS MYON_BinaryMappedFile : public MYON_BinaryArchive
+{
+public:
+  /*
+  Description:
+    Create an MYON_BinaryArchive that reads an ordinary file by mapping
+    the entire file into memory. Reads are served directly from the
+    mapping and ReadByteView() hands out pointers into the mapping, 
+    so compressed and uncompressed chunk payloads are not copied 
+    through fread() and intermediate buffers.
+  Parameters:
+    archive_mode - [in]
+      MYON::archive_mode::read or MYON::archive_mode::read3dm.
+      Writing is not supported.
+    file_system_path - [in]
+      path to file being read.
+  Remarks:
+    Use FileIsMapped() to determine if the file was successfully mapped.
+    If it was not, use MYON_BinaryFile to read the file.
+  */
+  MYON_BinaryMappedFile(
+    MYON::archive_mode archive_mode, 
+    const wchar_t* file_system_path
+    );
+
+  /*
+  Description:
+    Create an MYON_BinaryArchive that reads an ordinary file by mapping
+    the entire file into memory.
+  Parameters:
+    archive_mode - [in]
+      MYON::archive_mode::read or MYON::archive_mode::read3dm.
+    file_system_path - [in]
+      path to file being read.
+  */
+  MYON_BinaryMappedFile(
+    MYON::archive_mode archive_mode, 
+    const char* file_system_path
+    );
+
+  ~MYON_BinaryMappedFile();
+
+  /*
+  Returns:
+    True if the file is mapped into memory.
+  */
+  bool FileIsMapped() const;
+
+  /*
+  Returns:
+    Number of bytes in the mapped file.
+  */
+  MYON__UINT64 SizeOfFile() const;
+
+  /*
+  Description:
+    Unmaps the file. Any pointers returned by ReadByteView() 
+    are no longer valid.
+  */
+  void UnmapFile();
+
+protected:
+  // MYON_BinaryArchive overrides
+  MYON__UINT64 Internal_CurrentPositionOverride() const override;
+  bool Internal_SeekFromCurrentPositionOverride(int byte_offset) override;
+  bool Internal_SeekToStartOverride() override;
+
+public:
+  // MYON_BinaryArchive overrides
+  bool AtEnd() const override;
+
+protected:
+  // MYON_BinaryArchive overrides
+  size_t Internal_ReadOverride( size_t, void* ) override; // return actual number of bytes read (like fread())
+  const void* Internal_ReadViewOverride( size_t ) override;
+  size_t Internal_WriteOverride( size_t, const void* ) override;
+  bool Flush() override;
+
+private:
+  bool Internal_MapFile( FILE* fp );
+
+  const unsigned char* m_view = nullptr;
+  MYON__UINT64 m_sizeof_view = 0;
+  MYON__UINT64 m_view_position = 0;
+
+  // Windows file mapping object handle
+  void* m_mapping_handle = nullptr;
+
+private:
+  // prohibit default construction, copy construction, and operator=
+  MYON_BinaryMappedFile() = delete;
+  MYON_BinaryMappedFile(const MYON_BinaryMappedFile&) = delete;
+  MYON_BinaryMappedFile& operator=(const MYON_BinaryMappedFile&) = delete;
+};
+
 class MYON_CLASS MYON_BinaryArchiveBuffer : public MYON_BinaryArchive
 {
 public:
@@ -5623,6 +6689,7 @@ public:
 protected:
   // MYON_BinaryArchive overrides
   size_t Internal_ReadOverride( size_t, void* ) override; // return actual number of bytes read (like fread())
+  const void* Internal_ReadViewOverride( size_t ) override;
   size_t Internal_WriteOverride( size_t, const void* ) override;
   bool Flush() override;
 
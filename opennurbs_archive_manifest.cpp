@@ -21,6 +21,9 @@
 #error MYON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// std::map is used by MYON_ComponentManifestImpl::UnusedName()
+#include <map>
+
 bool MYON_NameHash::IsValidAndNotEmpty() const
 {
   return (
@@ -1085,6 +1088,13 @@ public:
     return false;
   }
 
+  void ReserveCapacityForAdditionalItems(
+    unsigned int item_count
+    )
+  {
+    ReserveItemCapacity(ItemCount() + item_count);
+  }
+
   const MYON_ComponentManifestHash32TableItem* FirstManifestItemWithName(
     MYON_ModelComponent::Type component_type,
     const MYON_NameHash& name_hash
@@ -1188,6 +1198,13 @@ public:
     return MYON_Hash32Table::ItemCount();
   }
 
+  void ReserveCapacityForAdditionalItems(
+    unsigned int item_count
+    )
+  {
+    ReserveItemCapacity(ItemCount() + item_count);
+  }
+
   const MYON_ComponentManifestHash32TableItem* AddManifestItem(
     const class MYON_ComponentManifestItem_PRIVATE* manifest_item
     )
@@ -2960,6 +2977,14 @@ public:
     MYON_ComponentManifestItem_PRIVATE* item
     );
 
+  void ReserveCapacityForAdditionalItems(
+    unsigned int item_count
+    )
+  {
+    if (m_bIndexedComponent)
+      m_item_list.Reserve(m_item_list.Count() + item_count);
+  }
+
   void IncrementDeletedCount()
   {
     m_deleted_item_count++;
@@ -3458,6 +3483,18 @@ public:
     return m_manifest_content_version_number;
   }
 
+  void PrepareForConcurrentReaders()
+  {
+    m_component_serial_number_map.PrepareForConcurrentReaders();
+  }
+
+  unsigned int AddItems(
+    const MYON_ComponentManifestItem* items,
+    unsigned int item_count,
+    bool bResolveIdAndNameCollisions,
+    MYON_SimpleArray<MYON_ComponentManifestItem>* manifest_items
+    );
+
 private:
   mutable MYON__UINT64 m_manifest_content_version_number = 0;
 
@@ -3522,6 +3559,37 @@ private:
 
   // Hash table used for system components that require unique names
   MYON_ComponentNameHash32Table m_system_name_hash_table;
+
+private:
+  // UnusedName() tries "base_name 01", "base_name 02", ... until it finds an 
+  // unused name. The runs of suffixes found to be in use are saved so later
+  // searches with the same base name skip them. Adding items cannot make a
+  // name available, so the cache is cleared only when items are removed,
+  // deleted or renamed.
+  // UnusedName() is const and may be called from several threads on an
+  // immutable manifest (for example, an MYONX_Model snapshot), so the cache
+  // is only accessed while m_unused_name_suffix_cache_mutex is locked.
+  class UnusedNameSuffixRun
+  {
+  public:
+    // Every suffix from m_suffix0 to m_suffix1 is in use.
+    unsigned int m_suffix0 = 0;
+    unsigned int m_suffix1 = 0;
+  };
+
+  class NameHashLess
+  {
+  public:
+    bool operator()(const MYON_NameHash& a, const MYON_NameHash& b) const
+    {
+      return MYON_NameHash::Compare(a, b) < 0;
+    }
+  };
+
+  mutable std::map<MYON_NameHash, UnusedNameSuffixRun, NameHashLess> m_unused_name_suffix_cache[MYON_ComponentManifestImpl::TableCount];
+  mutable std::mutex m_unused_name_suffix_cache_mutex;
+
+  void Internal_ClearUnusedNameSuffixCache();
 };
 
 int MYON_ComponentManifestImpl_TableCount(void)
@@ -3570,6 +3638,67 @@ MYON_ComponentManifestItem_PRIVATE* MYON_ComponentManifestImpl::AllocateItem(
   return manifest_item;
 }
 
+void MYON_ComponentManifestImpl::Internal_ClearUnusedNameSuffixCache()
+{
+  std::lock_guard<std::mutex> lock(m_unused_name_suffix_cache_mutex);
+  for (unsigned int i = 0; i < MYON_ComponentManifestImpl::TableCount; i++)
+    m_unused_name_suffix_cache[i].clear();
+}
+
+unsigned int MYON_ComponentManifestImpl::AddItems(
+  const MYON_ComponentManifestItem* items,
+  unsigned int item_count,
+  bool bResolveIdAndNameCollisions,
+  MYON_SimpleArray<MYON_ComponentManifestItem>* manifest_items
+  )
+{
+  if (nullptr == items || 0 == item_count)
+    return 0;
+
+  // Size the index lists and hash tables for the final item count
+  // so they are not grown and rehashed while the items are added.
+  unsigned int type_item_count[MYON_ComponentManifestImpl::TableCount] = {};
+  unsigned int unique_name_count = 0;
+  unsigned int nonunique_name_count = 0;
+  for (unsigned int i = 0; i < item_count; i++)
+  {
+    const MYON_ModelComponent::Type component_type = items[i].ComponentType();
+    const unsigned int type_index = static_cast<unsigned int>(component_type);
+    if (type_index >= MYON_ComponentManifestImpl::TableCount)
+      continue;
+    type_item_count[type_index]++;
+    if (MYON_ModelComponent::UniqueNameRequired(component_type) || MYON_ModelComponent::Type::Image == component_type)
+      unique_name_count++;
+    else if (items[i].NameHash().IsValidAndNotEmpty())
+      nonunique_name_count++;
+  }
+  for (unsigned int i = 0; i < MYON_ComponentManifestImpl::TableCount; i++)
+  {
+    if (0 != type_item_count[i])
+      m_table_index[i].ReserveCapacityForAdditionalItems(type_item_count[i]);
+  }
+  m_manifest_id_hash_table.ReserveCapacityForAdditionalItems(item_count);
+  m_unique_name_hash_table.ReserveCapacityForAdditionalItems(unique_name_count);
+  m_nonunique_name_hash_table.ReserveCapacityForAdditionalItems(nonunique_name_count);
+  if (nullptr != manifest_items)
+    manifest_items->Reserve(manifest_items->Count() + item_count);
+
+  unsigned int added_count = 0;
+  for (unsigned int i = 0; i < item_count; i++)
+  {
+    const MYON_ComponentManifestItem_PRIVATE* manifest_item 
+      = (MYON_ModelComponent::Type::Unset == items[i].ComponentType())
+      ? nullptr
+      : AddItem(items[i], items[i].NameHash().ParentId(), bResolveIdAndNameCollisions, nullptr, nullptr);
+    if (nullptr != manifest_item)
+      added_count++;
+    if (nullptr != manifest_items)
+      manifest_items->Append((nullptr != manifest_item) ? *manifest_item : MYON_ComponentManifestItem::UnsetItem);
+  }
+
+  return added_count;
+}
+
 void MYON_ComponentManifestImpl::DeallocateItem(
   MYON_ComponentManifestItem_PRIVATE* item
   )
@@ -3691,6 +3820,23 @@ const MYON_wString MYON_ComponentManifestImpl::UnusedName(
       suffix_separator = L" ";
   }
 
+  // Skip suffixes a previous search found to be in use.
+  MYON_wString suffix_prefix(local_base_name);
+  suffix_prefix += suffix_separator;
+  const MYON_NameHash suffix_prefix_hash = MYON_NameHash::Create(MYON_nil_uuid, suffix_prefix, bIgnoreCase);
+  std::map<MYON_NameHash, UnusedNameSuffixRun, NameHashLess>& suffix_cache = m_unused_name_suffix_cache[static_cast<unsigned int>(component_type)];
+  UnusedNameSuffixRun suffix_run;
+  suffix_run.m_suffix0 = suffix0 + 1;
+  {
+    std::lock_guard<std::mutex> lock(m_unused_name_suffix_cache_mutex);
+    const auto it = suffix_cache.find(suffix_prefix_hash);
+    if (it != suffix_cache.end() && it->second.m_suffix0 <= suffix_run.m_suffix0 && suffix_run.m_suffix0 <= it->second.m_suffix1)
+    {
+      suffix_run.m_suffix0 = it->second.m_suffix0;
+      suffix0 = it->second.m_suffix1;
+    }
+  }
+
   const unsigned int index_limit = IndexLimit(component_type);
   const unsigned int item_count = ActiveAndDeletedItemCountImpl(component_type);
   const int max_attempt_count = ((index_limit >= item_count) ? index_limit : item_count) + 20;
@@ -3723,6 +3869,12 @@ const MYON_wString MYON_ComponentManifestImpl::UnusedName(
         continue;
       if ( m_system_name_hash_table.NameInUse(component_type, name_hash, bIgnoreParentId) )
         continue;
+      if (0 == pass && suffix0 > suffix_run.m_suffix0)
+      {
+        suffix_run.m_suffix1 = suffix0 - 1;
+        std::lock_guard<std::mutex> lock(m_unused_name_suffix_cache_mutex);
+        suffix_cache[suffix_prefix_hash] = suffix_run;
+      }
       if (suffix_value)
         *suffix_value = suffix0;
       return unused_component_name;
@@ -4138,6 +4290,7 @@ const MYON_ComponentManifestItem_PRIVATE* MYON_ComponentManifestImpl::ChangeItem
   }
 
   m_manifest_content_version_number++;
+  Internal_ClearUnusedNameSuffixCache();
   item->m_name_hash = new_name_hash;
   if ( new_name_hash.IsValidAndNotEmpty() )
     name_hash_table.AddManifestItem(item);
@@ -4224,6 +4377,7 @@ bool MYON_ComponentManifestImpl::RemoveItem(
 
   MYON_ComponentManifestItem_PRIVATE* item = const_cast<MYON_ComponentManifestItem_PRIVATE*>(manifest_item);
   m_manifest_content_version_number++;
+  Internal_ClearUnusedNameSuffixCache();
   MYON_ComponentManifestTableIndex* table_index = TableIndexFromType(item->m_component_type);
   if (nullptr != table_index)
     table_index->RemoveItem(item);
@@ -4245,6 +4399,7 @@ bool MYON_ComponentManifestImpl::RemoveAllItems(
   MYON_ComponentManifestTableIndex* table_index = TableIndexFromType(component_type);
   if (nullptr == table_index)
     return false;
+  Internal_ClearUnusedNameSuffixCache();
   MYON_ComponentManifestItem_PRIVATE* next_item = const_cast<MYON_ComponentManifestItem_PRIVATE*>(table_index->FirstItem());
   MYON_ComponentNameHash32Table& name_hash_table = ComponentNameHash32Table(component_type);
   while (nullptr != next_item)
@@ -4290,6 +4445,7 @@ const MYON_ComponentManifestItem_PRIVATE* MYON_ComponentManifestImpl::DeleteItem
   if (item->m_name_hash.IsValidAndNotEmpty())
   {
     // remove name;
+    Internal_ClearUnusedNameSuffixCache();
     if (MYON_ModelComponent::UniqueNameRequired(item->m_component_type))
     {
       m_unique_name_hash_table.RemoveManifestItem(item);
@@ -4535,6 +4691,11 @@ MYON__UINT64 MYON_ComponentManifest::ManifestContentVersionNumber() const
     : 0;
 }
 
+void MYON_ComponentManifest::PrepareForConcurrentReaders()
+{
+  Impl()->PrepareForConcurrentReaders();
+}
+
 unsigned int MYON_ComponentManifest::ItemCount() const
 {
   return (nullptr == m_impl) ? 0 : m_impl->ItemCountImpl();
@@ -4683,6 +4844,22 @@ const class MYON_ComponentManifestItem& MYON_ComponentManifest::AddComponentToMa
   return (nullptr != manifest_item) ? *manifest_item : MYON_ComponentManifestItem::UnsetItem;
 }
 
+unsigned int MYON_ComponentManifest::AddComponentsToManifest(
+  const MYON_SimpleArray<MYON_ComponentManifestItem>& items,
+  bool bResolveIdAndNameCollisions,
+  MYON_SimpleArray<MYON_ComponentManifestItem>* manifest_items
+  )
+{
+  if (items.Count() <= 0)
+    return 0;
+  return Impl()->AddItems(
+    items.Array(),
+    items.UnsignedCount(),
+    bResolveIdAndNameCollisions,
+    manifest_items
+    );
+}
+
 const MYON_ComponentManifestItem_PRIVATE* MYON_ComponentManifestImpl::AddSystemItem(
   const MYON_ComponentManifestItem& item
   )
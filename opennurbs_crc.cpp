@@ -119,6 +119,182 @@ MYON__UINT16 MYON_CRC16( MYON__UINT16 current_remainder, size_t count, const voi
   return current_remainder;
 }
 
+////////////////////////////////////////////////////////////////
+//
+// Hardware assisted 32 bit CRC.
+//
+// On x86-64 the carry-less multiply instruction (PCLMULQDQ) is used to
+// fold 64 bytes at a time. CPU support is tested at runtime.
+// On ARMv8 the CRC32 instructions are used when the compiler targets 
+// processors that have them.
+//
+// These functions work on the inverted remainder, like the byte-wise
+// table loop in MYON_CRC32().
+//
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(MYON_COMPILER_MSC) || defined(MYON_COMPILER_CLANG) || defined(MYON_COMPILER_GNU))
+#define MYON_CRC32_PCLMUL
+#if defined(MYON_COMPILER_MSC)
+#include <intrin.h>
+#define MYON_CRC32_PCLMUL_TARGET
+#else
+#include <immintrin.h>
+#include <cpuid.h>
+#define MYON_CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_FEATURE_CRC32) || defined(MYON_COMPILER_MSC))
+#define MYON_CRC32_ARMV8
+#if defined(MYON_COMPILER_MSC)
+#include <intrin.h>
+#else
+#include <arm_acle.h>
+#endif
+#endif
+
+#if defined(MYON_CRC32_PCLMUL)
+
+static bool Internal_CRC32_HasPCLMUL()
+{
+  // CPUID leaf 1 ECX bit 1 = PCLMULQDQ, bit 19 = SSE4.1
+  unsigned int ecx = 0;
+#if defined(MYON_COMPILER_MSC)
+  int info[4] = {};
+  __cpuid(info, 1);
+  ecx = (unsigned int)info[2];
+#else
+  unsigned int eax = 0, ebx = 0, edx = 0;
+  if (0 == __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    ecx = 0;
+#endif
+  return (0 != (ecx & (1u << 1)) && 0 != (ecx & (1u << 19)));
+}
+
+/*
+Returns:
+  Inverted remainder.
+Remarks:
+  count must be >= 64 and a multiple of 16.
+*/
+MYON_CRC32_PCLMUL_TARGET
+static MYON__UINT32 Internal_CRC32_PCLMUL(MYON__UINT32 crc, size_t count, const unsigned char* b)
+{
+  // Folding constants for the reflected polynomial 0xedb88320.
+  // See Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+  alignas(16) static const MYON__UINT64 k1k2[2] = { 0x0154442bd4ULL, 0x01c6e41596ULL };
+  alignas(16) static const MYON__UINT64 k3k4[2] = { 0x01751997d0ULL, 0x00ccaa009eULL };
+  alignas(16) static const MYON__UINT64 k5[2] = { 0x0163cd6124ULL, 0x0000000000ULL };
+  alignas(16) static const MYON__UINT64 poly[2] = { 0x01db710641ULL, 0x01f7011641ULL };
+
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+  x1 = _mm_loadu_si128((const __m128i*)(b + 0x00));
+  x2 = _mm_loadu_si128((const __m128i*)(b + 0x10));
+  x3 = _mm_loadu_si128((const __m128i*)(b + 0x20));
+  x4 = _mm_loadu_si128((const __m128i*)(b + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+  x0 = _mm_load_si128((const __m128i*)k1k2);
+  b += 64;
+  count -= 64;
+
+  // fold 64 bytes at a time
+  while (count >= 64)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+    y5 = _mm_loadu_si128((const __m128i*)(b + 0x00));
+    y6 = _mm_loadu_si128((const __m128i*)(b + 0x10));
+    y7 = _mm_loadu_si128((const __m128i*)(b + 0x20));
+    y8 = _mm_loadu_si128((const __m128i*)(b + 0x30));
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+    b += 64;
+    count -= 64;
+  }
+
+  // fold the 4 accumulators into 128 bits
+  x0 = _mm_load_si128((const __m128i*)k3k4);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // fold remaining 16 byte blocks
+  while (count >= 16)
+  {
+    x2 = _mm_loadu_si128((const __m128i*)b);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    b += 16;
+    count -= 16;
+  }
+
+  // fold 128 bits to 64 bits
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+  x1 = _mm_srli_si128(x1, 8);
+  x1 = _mm_xor_si128(x1, x2);
+  x0 = _mm_loadl_epi64((const __m128i*)k5);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, x3);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits
+  x0 = _mm_load_si128((const __m128i*)poly);
+  x2 = _mm_and_si128(x1, x3);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+  x2 = _mm_and_si128(x2, x3);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return (MYON__UINT32)_mm_extract_epi32(x1, 1);
+}
+
+#endif
+
+#if defined(MYON_CRC32_ARMV8)
+/*
+Returns:
+  Inverted remainder.
+*/
+static MYON__UINT32 Internal_CRC32_ARMV8(MYON__UINT32 crc, size_t count, const unsigned char* b)
+{
+  while (count > 0 && 0 != (((MYON__UINT_PTR)b) & 7))
+  {
+    crc = __crc32b(crc, *b++);
+    count--;
+  }
+  while (count >= 8)
+  {
+    MYON__UINT64 u;
+    memcpy(&u, b, 8);
+    crc = __crc32d(crc, u);
+    b += 8;
+    count -= 8;
+  }
+  while (count > 0)
+  {
+    crc = __crc32b(crc, *b++);
+    count--;
+  }
+  return crc;
+}
+#endif
+
 MYON__UINT32 MYON_CRC32( MYON__UINT32 current_remainder, size_t count, const void* p )
 {
   /*
@@ -225,6 +401,29 @@ MYON__UINT32 MYON_CRC32( MYON__UINT32 current_remainder, size_t count, const voi
     0x2d02ef8d
   };
 
+  /*
+  MYON_CRC32_SLICE_TABLE.m_table[k][i] is the remainder of byte i 
+  followed by k zero bytes. Used to process 8 bytes per step.
+  */
+  static const struct Internal_CRC32SliceTable
+  {
+    Internal_CRC32SliceTable(const MYON__UINT32* zlib_table)
+    {
+      for (int i = 0; i < 256; i++)
+        m_table[0][i] = zlib_table[i];
+      for (int k = 1; k < 8; k++)
+      {
+        for (int i = 0; i < 256; i++)
+          m_table[k][i] = (m_table[k - 1][i] >> 8) ^ m_table[0][m_table[k - 1][i] & 0xff];
+      }
+    }
+    MYON__UINT32 m_table[8][256];
+  } MYON_CRC32_SLICE_TABLE(MYON_CRC32_ZLIB_TABLE);
+
+#if defined(MYON_CRC32_PCLMUL)
+  static const bool bHasPCLMUL = Internal_CRC32_HasPCLMUL();
+#endif
+
   if ( count > 0 && p ) 
   {
     const unsigned char* b = (const unsigned char*)p;
@@ -255,6 +454,33 @@ MYON__UINT32 MYON_CRC32( MYON__UINT32 current_remainder, size_t count, const voi
     ////    }
     ////#endif
 
+#if defined(MYON_CRC32_PCLMUL)
+    if (count >= 64 && bHasPCLMUL)
+    {
+      const size_t count16 = count & ~((size_t)15);
+      current_remainder = Internal_CRC32_PCLMUL(current_remainder, count16, b);
+      b += count16;
+      count -= count16;
+    }
+#elif defined(MYON_CRC32_ARMV8)
+    current_remainder = Internal_CRC32_ARMV8(current_remainder, count, b);
+    b += count;
+    count = 0;
+#endif
+
+    // slicing-by-8
+    const MYON__UINT32(*T)[256] = MYON_CRC32_SLICE_TABLE.m_table;
+    while (count >= 8)
+    {
+      current_remainder ^= ((MYON__UINT32)b[0]) | (((MYON__UINT32)b[1]) << 8) | (((MYON__UINT32)b[2]) << 16) | (((MYON__UINT32)b[3]) << 24);
+      current_remainder =
+        T[7][current_remainder & 0xff] ^ T[6][(current_remainder >> 8) & 0xff]
+        ^ T[5][(current_remainder >> 16) & 0xff] ^ T[4][current_remainder >> 24]
+        ^ T[3][b[4]] ^ T[2][b[5]] ^ T[1][b[6]] ^ T[0][b[7]];
+      b += 8;
+      count -= 8;
+    }
+
     while(count--) 
     {
       current_remainder = MYON_CRC32_ZLIB_TABLE[((int)current_remainder ^ (*b++)) & 0xff] ^ (current_remainder >> 8);
@@ -270,6 +496,66 @@ MYON__UINT32 MYON_CRC32( MYON__UINT32 current_remainder, size_t count, const voi
   return current_remainder;
 }
 
+/*
+Returns:
+  a(x)*b(x) modulo the CRC-32 polynomial. 
+  Polynomials are reflected: x^0 is the high bit.
+*/
+static MYON__UINT32 Internal_CRC32_MultModP(MYON__UINT32 a, MYON__UINT32 b)
+{
+  MYON__UINT32 m = ((MYON__UINT32)1) << 31;
+  MYON__UINT32 p = 0;
+  for (;;)
+  {
+    if (0 != (a & m))
+    {
+      p ^= b;
+      if (0 == (a & (m - 1)))
+        break;
+    }
+    m >>= 1;
+    b = (0 != (b & 1)) ? ((b >> 1) ^ 0xedb88320) : (b >> 1);
+  }
+  return p;
+}
+
+/*
+Returns:
+  x^(n*2^k) modulo the CRC-32 polynomial.
+*/
+static MYON__UINT32 Internal_CRC32_X2NModP(MYON__UINT64 n, unsigned int k)
+{
+  // x2n_table[i] = x^(2^i) modulo the CRC-32 polynomial
+  static const struct Internal_CRC32X2NTable
+  {
+    Internal_CRC32X2NTable()
+    {
+      MYON__UINT32 p = ((MYON__UINT32)1) << 30; // x^1
+      m_table[0] = p;
+      for (int i = 1; i < 32; i++)
+        m_table[i] = p = Internal_CRC32_MultModP(p, p);
+    }
+    MYON__UINT32 m_table[32];
+  } x2n_table;
+
+  MYON__UINT32 p = ((MYON__UINT32)1) << 31; // x^0
+  while (0 != n)
+  {
+    if (0 != (n & 1))
+      p = Internal_CRC32_MultModP(x2n_table.m_table[k & 31], p);
+    n >>= 1;
+    k++;
+  }
+  return p;
+}
+
+MYON__UINT32 MYON_CRC32_Combine( MYON__UINT32 crc1, MYON__UINT32 crc2, MYON__UINT64 sizeof_buffer2 )
+{
+  // Same as zlib's crc32_combine(). 
+  // Multiplying by x^(8*sizeof_buffer2) appends sizeof_buffer2 zero bytes to crc1.
+  return Internal_CRC32_MultModP(Internal_CRC32_X2NModP(sizeof_buffer2, 3), crc1) ^ crc2;
+}
+
 
 /*
 Description:
@@ -77,6 +77,11 @@ Description:
   out there and the argument order was switched to match that used by
   the legacy MYON_CRC16().
 
+  Buffers are processed 8 bytes at a time using slicing-by-8 tables.
+  On x86-64 processors with the PCLMULQDQ instruction and on ARMv8
+  builds that target the CRC32 instructions, long buffers are
+  processed by the hardware.
+
 Parameters:
   current_remainder - [in]
   sizeof_buffer - [in]  number of bytes in buffer
@@ -113,6 +118,31 @@ MYON__UINT32 MYON_CRC32(
          const void* buffer
          );
 
+/*
+Description:
+  Combines the 32 bit CRCs of two adjacent buffers.
+
+Parameters:
+  crc1 - [in]  
+    MYON_CRC32(crc_seed, sizeof_buffer1, buffer1)
+  crc2 - [in]
+    MYON_CRC32(0, sizeof_buffer2, buffer2)
+  sizeof_buffer2 - [in]
+
+Returns:
+  The value of MYON_CRC32(crc1, sizeof_buffer2, buffer2).
+
+Remarks:
+  Use MYON_CRC32_Combine() when blocks of a buffer are hashed on
+  different threads or in any order.
+*/
+MYON_DECL
+MYON__UINT32 MYON_CRC32_Combine(
+         MYON__UINT32 crc1,
+         MYON__UINT32 crc2,
+         MYON__UINT64 sizeof_buffer2
+         );
+
 /*
 zlib.h -- interface of the 'zlib' general purpose compression library
 version 1.1.3, July 9th, 1998
@@ -2832,20 +2832,22 @@ bool JoinCurveEndArray::Create(const MYON_SimpleArray<MYON_Curve*>& Curves,
   if (!bGotOne)
     return false;
 
-  MYON_RTree Tree;
-
+  MYON_SimpleArray<MYON_RTreeLeaf> Leaves(2*m_CurveCount);
   for (int i=0; i<m_CurveCount; i++){
     for (int j=0; j<2; j++){
       const JoinCurveEnd& J = m_Ends[j][i];
       if (J.m_cid < 0)
         continue;
-      double min[3], max[3];
+      MYON_RTreeLeaf& Leaf = Leaves.AppendNew();
       for (int k=0; k<3; k++)
-        min[k] = max[k] = J.m_P[k];
-      if (!Tree.Insert(min, max, (void*)&J))
-        return false;
+        Leaf.m_rect.m_min[k] = Leaf.m_rect.m_max[k] = J.m_P[k];
+      Leaf.m_id = (MYON__INT_PTR)&J;
     }
   }
+
+  MYON_RTree Tree;
+  if (!Tree.CreatePacked(Leaves.Array(), Leaves.UnsignedCount(), 1))
+    return false;
   JoinTreeContext JTC;
   JTC.bCheckDot = bCheckDot;
   JTC.bPreserveDirection = bPreserveDirection;
@@ -22,6 +22,12 @@
 #error MYON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// std::map is used by MYONX_Model::AppendChanges()
+#include <map>
+
+// std::condition_variable is used by MYONX_Model::ReadFiles()
+#include <condition_variable>
+
 const MYONX_ErrorCounter MYONX_ErrorCounter::operator+ (
   const MYONX_ErrorCounter& rhs
   )
@@ -316,11 +322,65 @@ public:
   MYON_XMLNode* GetPostEffectSectionNode(MYON_XMLNode& model_node, MYON_PostEffect::Types type) const;
   static void RemoveAllEmbeddedFiles(MYONX_Model& model);
   static bool GetEntireRDKDocument(const MYONX_Model_UserData& docud, MYON_wString& xml, MYONX_Model* model);
+  bool ReadModelGeometryTable(MYON_BinaryArchive& archive, unsigned int object_filter);
+  bool ReadDeferredModelGeometryTable(unsigned int object_filter);
+  bool ReadMappedFile(const std::shared_ptr<MYON_BinaryArchive>& archive_sp, unsigned int table_filter,
+                      unsigned int model_object_type_filter, MYON_TextLog* error_log);
 
 public:
   MYONX_Model& m_model;
   MYON__UINT64 m_model_content_version_number = 0;
   MYON_ClassArray<MYONX_Model::MYONX_ModelComponentList> m_mcr_lists;
+
+  // See MYONX_Model::SetDeferGeometryReading().
+  bool m_bDeferGeometryReading = false;
+
+  // See MYONX_Model::SetReferenceUnknownUserData().
+  bool m_bReferenceUnknownUserData = false;
+  // Archive being read by ReadWithDeferredGeometry().
+  std::shared_ptr<MYON_BinaryArchive> m_deferred_geometry_archive_sp;
+
+public:
+  // See MYONX_Model::AppendChanges().
+  void SetAppendBaseline(int archive_3dm_version, MYON__UINT64 file_length);
+  void ClearAppendBaseline();
+  bool WriteAppendedChanges(MYON_BinaryArchive& archive, unsigned int& change_count) const;
+  bool ReadAppendedChanges(MYON_BinaryArchive& archive);
+
+  class AppendBaselineItem
+  {
+  public:
+    MYON_ModelComponent::Type m_component_type = MYON_ModelComponent::Type::Unset;
+    MYON__UINT64 m_runtime_serial_number = 0;
+    MYON__UINT64 m_content_version_number = 0;
+  };
+
+  class UuidLess
+  {
+  public:
+    bool operator()(const MYON_UUID& a, const MYON_UUID& b) const
+    {
+      return MYON_UuidCompare(&a, &b) < 0;
+    }
+  };
+
+  // The components in the file at the time it was last read or written.
+  std::map<MYON_UUID, AppendBaselineItem, UuidLess> m_append_baseline;
+  // Components passed to MYONX_Model::MarkComponentChanged().
+  MYON_UuidList m_append_marked_ids;
+  bool m_bAppendBaselineIsSet = false;
+  int m_append_baseline_3dm_version = 0;
+  MYON__UINT64 m_append_baseline_file_length = 0;
+  unsigned int m_appended_changes_count = 0;
+
+public:
+  // See MYONX_Model::CreateSnapshot().
+  static bool CopyManifest(const MYON_ComponentManifest& src, MYON_ComponentManifest& dst);
+
+  // True if the model was created by MYONX_Model::CreateSnapshot().
+  bool m_bIsSnapshot = false;
+  // Serializes the bounding box cache updates of a snapshot.
+  MYON_SleepLock m_snapshot_bbox_lock;
 };
 
 MYON_InternalXMLImpl::~MYON_InternalXMLImpl()
@@ -473,6 +533,8 @@ void MYONX_Model::Reset()
     delete m_model_user_string_list;
     m_model_user_string_list = nullptr;
   }
+
+  m_private->ClearAppendBaseline();
 }
 
 void MYONX_Model::Internal_ComponentTypeBoundingBox(
@@ -501,11 +563,12 @@ void MYONX_Model::Internal_ComponentTypeBoundingBox(
       if (nullptr != attributes && attributes->IsInstanceDefinitionObject())
         continue;
 
-      const MYON_Geometry* geometry = model_geometry->Geometry(nullptr);
-      if (nullptr == geometry)
+      // Deferred geometry is created the first time its bounding box is needed.
+      const MYON_BoundingBox geometry_bbox = model_geometry->GeometryBoundingBox();
+      if (false == geometry_bbox.IsValid())
         continue;
 
-      local_bbox.Union(geometry->BoundingBox());
+      local_bbox.Union(geometry_bbox);
     }
     bbox = local_bbox;
   }
@@ -514,12 +577,25 @@ void MYONX_Model::Internal_ComponentTypeBoundingBox(
 
 MYON_BoundingBox MYONX_Model::ModelGeometryBoundingBox() const
 {
+  if (m_private->m_bIsSnapshot)
+  {
+    // Snapshots may be read from multiple threads.
+    MYON_SleepLockGuard guard(m_private->m_snapshot_bbox_lock);
+    Internal_ComponentTypeBoundingBox(MYON_ModelComponent::Type::ModelGeometry,m_model_geometry_bbox);
+    return m_model_geometry_bbox;
+  }
   Internal_ComponentTypeBoundingBox(MYON_ModelComponent::Type::ModelGeometry,m_model_geometry_bbox);
   return m_model_geometry_bbox;
 }
 
 MYON_BoundingBox MYONX_Model::RenderLightBoundingBox() const
 {
+  if (m_private->m_bIsSnapshot)
+  {
+    MYON_SleepLockGuard guard(m_private->m_snapshot_bbox_lock);
+    Internal_ComponentTypeBoundingBox(MYON_ModelComponent::Type::RenderLight,m_render_light_bbox);
+    return m_render_light_bbox;
+  }
   Internal_ComponentTypeBoundingBox(MYON_ModelComponent::Type::RenderLight,m_render_light_bbox);
   return m_render_light_bbox;
 }
@@ -1823,7 +1899,11 @@ MYON_ModelComponentReference MYONX_Model::Internal_AddModelComponent(
       MYON_ModelGeometryComponent* geometry_component = MYON_ModelGeometryComponent::Cast(model_component);
       if (nullptr != geometry_component)
       {
-        const MYON_Light* light = MYON_Light::Cast(geometry_component->Geometry(nullptr));
+        // Deferred geometry is never a light and is not created here.
+        const MYON_Light* light
+          = geometry_component->GeometryIsDeferred()
+          ? nullptr
+          : MYON_Light::Cast(geometry_component->Geometry(nullptr));
         if (nullptr != light)
         {
           if (id != light->m_light_id)
@@ -2215,6 +2295,9 @@ int MYON__CIndexPair::CompareOldAndNewIndex( const MYON__CIndexPair* a, const MY
 
 bool MYONX_Model::Read(const char* filename, MYON_TextLog* error_log)
 {
+  if (DeferGeometryReading() || ReferenceUnknownUserData())
+    return Read(filename, 0, 0, error_log);
+
   bool rc = false;
 
   if (nullptr != filename)
@@ -2223,7 +2306,9 @@ bool MYONX_Model::Read(const char* filename, MYON_TextLog* error_log)
     if ( 0 != fp )
     {
       MYON_BinaryFile file(MYON::archive_mode::read3dm,fp);
+      file.EnableReadBuffer();
       rc = Read(file, error_log);
+      file.EnableReadBuffer(0);
       MYON::CloseFile(fp);
     }
   }
@@ -2233,6 +2318,9 @@ bool MYONX_Model::Read(const char* filename, MYON_TextLog* error_log)
 
 bool MYONX_Model::Read(const wchar_t* filename, MYON_TextLog* error_log)
 {
+  if (DeferGeometryReading() || ReferenceUnknownUserData())
+    return Read(filename, 0, 0, error_log);
+
   bool rc = false;
 
   if (nullptr != filename)
@@ -2241,7 +2329,9 @@ bool MYONX_Model::Read(const wchar_t* filename, MYON_TextLog* error_log)
     if ( 0 != fp )
     {
       MYON_BinaryFile file(MYON::archive_mode::read3dm,fp);
+      file.EnableReadBuffer();
       rc = Read(file, error_log);
+      file.EnableReadBuffer(0);
       MYON::CloseFile(fp);
     }
   }
@@ -2672,17 +2762,22 @@ bool MYONX_Model::IncrementalReadBegin(
   return (0 == archive.CriticalErrorCount());
 }
 
-bool MYONX_Model::IncrementalReadModelGeometry(
+static bool Internal_SeekInObjectTable(
   MYON_BinaryArchive& archive,
-  bool bManageModelGeometryComponent,
-  bool bManageGeometry,
-  bool bManageAttributes,
-  unsigned int object_filter,
-  MYON_ModelComponentReference& model_component_reference
+  MYON__UINT64 offset
   )
 {
-  model_component_reference = MYON_ModelComponentReference::Empty;
+  // SeekFromStart() cannot be used inside the object table chunk.
+  const MYON__UINT64 pos = archive.CurrentPosition();
+  return (offset >= pos)
+    ? archive.SeekForward(offset - pos)
+    : archive.SeekBackward(pos - offset);
+}
 
+static bool Internal_BeginIncrementalReadModelGeometry(
+  MYON_BinaryArchive& archive
+  )
+{
   MYON_3dmArchiveTableType active_table = archive.Active3dmTable();
   if (MYON_3dmArchiveTableType::Unset == active_table)
   {
@@ -2744,6 +2839,23 @@ bool MYONX_Model::IncrementalReadModelGeometry(
     }
   }
 
+  return true;
+}
+
+bool MYONX_Model::IncrementalReadModelGeometry(
+  MYON_BinaryArchive& archive,
+  bool bManageModelGeometryComponent,
+  bool bManageGeometry,
+  bool bManageAttributes,
+  unsigned int object_filter,
+  MYON_ModelComponentReference& model_component_reference
+  )
+{
+  model_component_reference = MYON_ModelComponentReference::Empty;
+
+  if (false == Internal_BeginIncrementalReadModelGeometry(archive))
+    return false;
+
   for(;;)
   {
     MYON_ModelGeometryComponent* model_geometry = nullptr;
@@ -2776,156 +2888,1431 @@ bool MYONX_Model::IncrementalReadModelGeometry(
   return true;
 }
 
-bool MYONX_Model::IncrementalReadFinish(
-    MYON_BinaryArchive& archive,
-    bool bManageComponents,
-    unsigned int table_filter,
-    MYON_TextLog* error_log
-    )
+bool MYONX_Model::IncrementalReadModelGeometry(
+  MYON_BinaryArchive& archive,
+  const MYON_3dmObjectTableIndexItem* index_item,
+  bool bManageModelGeometryComponent,
+  bool bManageGeometry,
+  bool bManageAttributes,
+  MYON_ModelComponentReference& model_component_reference
+  )
 {
-  int rc;
+  model_component_reference = MYON_ModelComponentReference::Empty;
 
-  const bool bResolveIdAndNameConflicts = true;
-  const bool bUpdateComponentIdentification = true;
+  if (nullptr == index_item || 0 == index_item->m_record_offset)
+  {
+    MYON_ERROR("Invalid index_item parameter.");
+    return false;
+  }
 
-  if ( 0 == table_filter )
-    table_filter = 0xFFFFFFFF; // read everything
+  if (MYON_nil_uuid != index_item->m_id)
+  {
+    // The object may have been read already.
+    model_component_reference = ComponentFromId(MYON_ModelComponent::Type::ModelGeometry, index_item->m_id);
+    if (false == model_component_reference.IsEmpty())
+      return true;
+  }
 
-  // STEP 16: Read history table
-  if ( archive.BeginRead3dmHistoryRecordTable() )
+  if (false == Internal_BeginIncrementalReadModelGeometry(archive))
+    return false;
+
+  if (false == Internal_SeekInObjectTable(archive, index_item->m_record_offset))
   {
-    if ( 0 != (static_cast<unsigned int>(MYON_3dmArchiveTableType::historyrecord_table) & table_filter) )
+    MYON_ERROR("Unable to seek to object table record.");
+    return false;
+  }
+
+  MYON_ModelGeometryComponent* model_geometry = nullptr;
+  const int rc = archive.Read3dmModelGeometryForExperts(bManageGeometry, bManageAttributes, &model_geometry, 0);
+  if (1 != rc || nullptr == model_geometry)
+  {
+    if (nullptr != model_geometry)
+      delete model_geometry;
+    MYON_ERROR("Unable to read object table record.");
+    return false;
+  }
+
+  if (MYON_nil_uuid != index_item->m_id && index_item->m_id != model_geometry->Id())
+  {
+    delete model_geometry;
+    MYON_ERROR("The object table index does not match the archive.");
+    return false;
+  }
+
+  model_component_reference = AddModelComponentForExperts(model_geometry, bManageModelGeometryComponent, true, true);
+  if (model_component_reference.IsEmpty())
+  {
+    delete model_geometry;
+    return false;
+  }
+
+  return true;
+}
+
+bool MYONX_Model::IncrementalReadSkipModelGeometry(
+  MYON_BinaryArchive& archive,
+  const MYON_3dmObjectTableIndex& index
+  )
+{
+  if (false == Internal_BeginIncrementalReadModelGeometry(archive))
+    return false;
+
+  if (0 == index.EndOfTableOffset() || false == Internal_SeekInObjectTable(archive, index.EndOfTableOffset()))
+  {
+    MYON_ERROR("Unable to seek to the end of the object table.");
+    return false;
+  }
+
+  // The next chunk is the end of table marker and IncrementalReadModelGeometry()
+  // finishes reading the object table.
+  MYON_ModelComponentReference model_component_reference;
+  if (false == IncrementalReadModelGeometry(archive, true, true, true, 0, model_component_reference))
+    return false;
+
+  return model_component_reference.IsEmpty();
+}
+
+static std::atomic<unsigned int> MYONX_Model_ReadThreadCount(1);
+
+void MYONX_Model::SetReadThreadCount(
+  unsigned int thread_count
+  )
+{
+  MYONX_Model_ReadThreadCount = thread_count;
+}
+
+unsigned int MYONX_Model::ReadThreadCount()
+{
+  return MYONX_Model_ReadThreadCount;
+}
+
+static std::atomic<unsigned int> MYONX_Model_WriteThreadCount(1);
+
+void MYONX_Model::SetWriteThreadCount(
+  unsigned int thread_count
+  )
+{
+  MYONX_Model_WriteThreadCount = thread_count;
+}
+
+unsigned int MYONX_Model::WriteThreadCount()
+{
+  return MYONX_Model_WriteThreadCount;
+}
+
+unsigned int MYONX_Model::ReadFiles(
+  const MYON_ClassArray< MYON_wString >& file_names,
+  MYON_SimpleArray< MYONX_Model* >& models,
+  unsigned int thread_count,
+  const MYONX_Model* model_settings,
+  MYON_ProgressReporter* progress_reporter,
+  MYON_Terminator* terminator,
+  MYON_TextLog* error_log
+  )
+{
+  models.SetCount(0);
+  const int file_count = file_names.Count();
+  if (file_count <= 0)
+    return 0;
+  models.Reserve(file_count);
+  models.SetCount(file_count);
+  models.Zero();
+
+  // Errors are logged per file and copied to error_log in file order.
+  MYON_ClassArray< MYON_wString > file_errors(file_count);
+  file_errors.SetCount(file_count);
+
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+  int done_count = 0;
+  std::atomic<int> next_file(0);
+  std::atomic<bool> bCancel(false);
+  std::atomic<unsigned int> read_count(0);
+
+  auto read_file = [&](int i)
+  {
+    MYON_TextLog file_log(file_errors[i]);
+    MYONX_Model* model = new MYONX_Model();
+    if (nullptr != model_settings)
     {
-      for(;;) 
-      {
-        MYON_HistoryRecord* pHistoryRecord = nullptr;
-        rc = archive.Read3dmHistoryRecord(pHistoryRecord);
-        if ( rc == 0 )
-          break; // end of history record table
-        if ( rc < 0 ) 
-          break;
-        if ( AddModelComponentForExperts(pHistoryRecord,bManageComponents,bResolveIdAndNameConflicts,bUpdateComponentIdentification).IsEmpty() )
-        {
-          delete pHistoryRecord;
-          continue;
-        }
-      }
+      model->SetDeferGeometryReading(model_settings->DeferGeometryReading());
+      model->SetReferenceUnknownUserData(model_settings->ReferenceUnknownUserData());
     }
-    
-    // If BeginRead3dmHistoryRecordTable() returns true, 
-    // then you MUST call EndRead3dmHistoryRecordTable().
-    if ( !archive.EndRead3dmHistoryRecordTable() )
+    if (model->Read(static_cast<const wchar_t*>(file_names[i]), &file_log))
     {
-      return false;
+      models[i] = model;
+      read_count++;
     }
-  }
+    else
+    {
+      delete model;
+    }
+  };
 
-  // STEP 17: OPTIONAL - Read user tables as anonymous goo
-  // If you develop a plug-ins or application that uses OpenNURBS files,
-  // you can store anything you want in a user table.
-  for(;;)
+  auto read_files = [&]()
   {
-    if ( archive.Archive3dmVersion() <= 1 )
+    MYON_BinaryArchive::BeginThreadCompressorReuseForExperts();
+    for (int i = next_file++; i < file_count && false == bCancel; i = next_file++)
     {
-      // no user tables in version 1 archives.
-      break;
+      read_file(i);
+      std::lock_guard<std::mutex> lock(done_mutex);
+      done_count++;
+      done_cv.notify_one();
     }
+    MYON_BinaryArchive::EndThreadCompressorReuseForExperts();
+  };
+
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+  const unsigned int worker_count
+    = (thread_count <= 1 || MYON_Terminator::TerminationRequested(terminator))
+    ? 0U
+    : (((unsigned int)file_count < thread_count) ? (unsigned int)file_count : thread_count);
 
+  MYON_SimpleArray< std::thread* > workers(worker_count);
+  for (unsigned int i = 0; i < worker_count; i++)
+  {
+    try
     {
-      MYON__UINT32 tcode = 0;
-      MYON__INT64 big_value = 0;
-      if ( !archive.PeekAt3dmBigChunkType(&tcode,&big_value) )
-        break;
-      if ( TCODE_USER_TABLE != tcode )
-        break;
+      workers.Append(new std::thread(read_files));
     }
-    MYON_UUID plugin_id = MYON_nil_uuid;
-    bool bGoo = false;
-    int usertable_3dm_version = 0;
-    unsigned int usertable_opennurbs_version = 0;
-    if ( !archive.BeginRead3dmUserTable( plugin_id, &bGoo, &usertable_3dm_version, &usertable_opennurbs_version ) )
+    catch (const std::system_error&)
     {
-      // attempt to skip bogus user table
-      const MYON__UINT64 pos0 = archive.CurrentPosition();
-      MYON__UINT32 tcode = 0;
-      MYON__INT64 big_value = 0;
-      if  ( !archive.BeginRead3dmBigChunk(&tcode,&big_value) )
-        break;
-      if ( !archive.EndRead3dmChunk() )
-        break;
-      const MYON__UINT64 pos1 = archive.CurrentPosition();
-      if (pos1 <= pos0)
-        break;
-      if ( TCODE_USER_TABLE != tcode )
-        break;
-
-      continue; // skip this bogus user table
+      // No more threads are available.
+      break;
     }
+  }
 
-    if ( 
-      nullptr == m_model_user_string_list
-      && plugin_id == MYON_CLASS_ID(MYON_DocumentUserStringList) 
-      )
+  MYON_ProgressReporter::ReportProgress(progress_reporter, 0.0);
+  if (0 == workers.Count())
+  {
+    // The calling thread reads the files.
+    MYON_BinaryArchive::BeginThreadCompressorReuseForExperts();
+    for (int i = 0; i < file_count; i++)
     {
-      // Read the document user strings (key-value pairs) as
-      // a user table with plug-in id = MYON_CLASS_ID(MYON_DocumentUserStringList)
-      MYON_Object* p = 0;
-      archive.ReadObject(&p);
-      m_model_user_string_list = MYON_DocumentUserStringList::Cast(p);
-      if ( 0 == m_model_user_string_list )
+      if (MYON_Terminator::TerminationRequested(terminator))
+        break;
+      read_file(i);
+      MYON_ProgressReporter::ReportProgress(progress_reporter, i + 1, file_count);
+    }
+    MYON_BinaryArchive::EndThreadCompressorReuseForExperts();
+  }
+  else
+  {
+    // The calling thread reports progress and checks for termination
+    // while the workers read the files.
+    std::unique_lock<std::mutex> lock(done_mutex);
+    int reported_count = 0;
+    while (reported_count < file_count)
+    {
+      done_cv.wait_for(lock, std::chrono::milliseconds(100));
+      if (reported_count != done_count)
       {
-        MYON_ERROR("The document user string information in the file is damaged.");
-        if ( 0 != p )
-          delete p;
-          p = 0;
+        reported_count = done_count;
+        MYON_ProgressReporter::ReportProgress(progress_reporter, reported_count, file_count);
       }
-    } 
-    else if ( 0 != (static_cast<unsigned int>(MYON_3dmArchiveTableType::user_table) & table_filter) )
-    {
-      // read user data tables as anonymous goo
-      MYONX_Model_UserData* model_ud = new MYONX_Model_UserData();
-      model_ud->m_uuid = plugin_id;
-      model_ud->m_usertable_3dm_version = usertable_3dm_version;
-      model_ud->m_usertable_opennurbs_version = usertable_opennurbs_version;
-      if ( !archive.Read3dmAnonymousUserTable( usertable_3dm_version, usertable_opennurbs_version, model_ud->m_goo ) )
+      if (MYON_Terminator::TerminationRequested(terminator))
       {
-        delete model_ud;
+        // Files that were started are finished when the workers are joined.
+        bCancel = true;
         break;
       }
-      m_userdata_table.Append(model_ud);
     }
-
-    // If BeginRead3dmObjectTable() returns true, 
-    // then you MUST call EndRead3dmUserTable().
-    if ( !archive.EndRead3dmUserTable() )
+    lock.unlock();
+    for (int i = 0; i < workers.Count(); i++)
     {
-      break;
+      workers[i]->join();
+      delete workers[i];
     }
   }
 
-  // STEP 18: OPTIONAL - check for end mark
-  size_t file_length = 0;
-  if ( !archive.Read3dmEndMark(&file_length) )
+  if (nullptr != error_log)
   {
-    if ( archive.Archive3dmVersion() != 1 ) 
+    for (int i = 0; i < file_count; i++)
     {
-      // some v1 files are missing end-of-archive markers
+      if (file_errors[i].IsEmpty())
+        continue;
+      error_log->Print(L"%ls:\n", static_cast<const wchar_t*>(file_names[i]));
+      error_log->PushIndent();
+      error_log->PrintString(file_errors[i]);
+      error_log->PopIndent();
     }
   }
-  else
-    m_3dm_file_byte_count = file_length;
-  return (0 == archive.CriticalErrorCount());
-}
 
+  return read_count;
+}
 
-bool MYONX_Model::Read( 
-    const char* filename,
-    unsigned int table_filter,
-    unsigned int model_object_type_filter,
-    MYON_TextLog* error_log
-    )
+bool MYONX_ModelPrivate::ReadModelGeometryTable(
+  MYON_BinaryArchive& archive,
+  unsigned int object_filter
+  )
 {
-  const MYON_wString wfilename_buffer(filename);
+  const bool bManageComponents = true;
+  const bool bManageGeometry = true;
+  const bool bManageAttributes = true;
+
+  if (&archive == m_deferred_geometry_archive_sp.get() && archive.Archive3dmVersion() > 1)
+    return ReadDeferredModelGeometryTable(object_filter);
+
+  unsigned int thread_count = MYONX_Model::ReadThreadCount();
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+
+  if (thread_count <= 1 || archive.Archive3dmVersion() <= 1)
+  {
+    for (;;)
+    {
+      MYON_ModelComponentReference model_geometry_reference;
+
+      if (!m_model.IncrementalReadModelGeometry(archive, bManageComponents, bManageGeometry, bManageAttributes,
+                                                object_filter, model_geometry_reference))
+        return false; // Catastrophic error.
+
+      if (model_geometry_reference.IsEmpty())
+        break; // No more geometry.
+    }
+    return true;
+  }
+
+  if (false == archive.BeginRead3dmObjectTable())
+  {
+    MYON_ERROR("Geoemtry table cannot be read from archive.");
+    return false;
+  }
+
+  // The object table is read in batches. A sequential pass reads the 
+  // attributes and the serialized objects of a batch of records, the
+  // objects are decoded on thread_count threads, and then the objects
+  // are added to the model in the order they appear in the archive.
+  // The batch limits bound the memory used by serialized objects.
+  const size_t batch_size_limit = 64 * 1024 * 1024;
+  const int batch_count_limit = 4096;
+
+  MYON_SimpleArray< MYON_3dmDeferredObject* > records(batch_count_limit);
+  MYON_SimpleArray< MYON_3dmObjectAttributes* > attributes(batch_count_limit);
+
+  bool rc = true;
+  bool bEndOfTable = false;
+  bool bAddRecords = true;
+  while (false == bEndOfTable)
+  {
+    // sequential pass
+    int batch_count = 0;
+    size_t batch_size = 0;
+    while (batch_count < batch_count_limit && batch_size < batch_size_limit)
+    {
+      if (batch_count == records.Count())
+      {
+        records.Append(new MYON_3dmDeferredObject());
+        attributes.Append(nullptr);
+      }
+      MYON_3dmObjectAttributes* record_attributes = new MYON_3dmObjectAttributes();
+      const int read_rc = archive.Read3dmObjectForExperts(record_attributes, object_filter, *records[batch_count]);
+      if (1 != read_rc)
+      {
+        delete record_attributes;
+        if (2 == read_rc)
+          continue; // item was intentionally skipped.
+        // end of object table or error reading
+        if (read_rc < 0)
+          rc = false;
+        bEndOfTable = true;
+        break;
+      }
+      attributes[batch_count] = record_attributes;
+      batch_size += records[batch_count]->SizeOfSerializedObject();
+      batch_count++;
+    }
+
+    // parallel pass
+    const unsigned int worker_count
+      = (batch_count <= 1)
+      ? 0U
+      : (((unsigned int)batch_count < thread_count) ? (unsigned int)batch_count : thread_count) - 1U;
+    if (worker_count > 0)
+    {
+      std::atomic<int> next_record(0);
+      const MYON_BinaryArchive& source_archive = archive;
+      auto decode = [&]()
+      {
+        for (int i = next_record++; i < batch_count; i = next_record++)
+          source_archive.Decode3dmDeferredObject(*records[i]);
+      };
+      MYON_SimpleArray< std::thread* > workers(worker_count);
+      for (unsigned int i = 0; i < worker_count; i++)
+      {
+        try
+        {
+          workers.Append(new std::thread(decode));
+        }
+        catch (const std::system_error&)
+        {
+          // No more threads are available.
+          // The calling thread decodes the remaining records.
+          break;
+        }
+      }
+      decode();
+      for (int i = 0; i < workers.Count(); i++)
+      {
+        workers[i]->join();
+        delete workers[i];
+      }
+    }
+
+    // Add the objects to the model in archive order. When the sequential
+    // pass fails, the records it read before the failure are still added.
+    for (int i = 0; i < batch_count; i++)
+    {
+      MYON_3dmObjectAttributes* record_attributes = attributes[i];
+      attributes[i] = nullptr;
+      if (false == bAddRecords)
+      {
+        records[i]->Destroy();
+        delete record_attributes;
+        continue;
+      }
+
+      // Records that reference an earlier object share its geometry.
+      const std::shared_ptr<MYON_Object> shared = (bManageGeometry && bManageAttributes) ? records[i]->SharedObject() : std::shared_ptr<MYON_Object>();
+      MYON_Object* object = nullptr;
+      const int finish_rc = archive.Finish3dmDeferredObject(*records[i], (nullptr == shared.get()) ? &object : nullptr, record_attributes);
+      MYON_Geometry* geometry = MYON_Geometry::Cast(object);
+      if (1 == finish_rc && nullptr != shared.get())
+      {
+        const std::shared_ptr<MYON_Geometry> geometry_sp(shared, MYON_Geometry::Cast(shared.get()));
+        MYON_ModelGeometryComponent* model_geometry = MYON_ModelGeometryComponent::CreateSharedForExperts(geometry_sp, record_attributes, nullptr);
+        if (nullptr == model_geometry)
+          delete record_attributes;
+        else if (m_model.AddModelComponentForExperts(model_geometry, bManageComponents, true, true).IsEmpty())
+          delete model_geometry;
+      }
+      else if (1 == finish_rc && nullptr != geometry)
+      {
+        MYON_ModelGeometryComponent* model_geometry = MYON_ModelGeometryComponent::CreateForExperts(bManageGeometry, geometry, bManageAttributes, record_attributes, nullptr);
+        if (m_model.AddModelComponentForExperts(model_geometry, bManageComponents, true, true).IsEmpty())
+          delete model_geometry;
+      }
+      else
+      {
+        delete object;
+        delete record_attributes;
+        if (finish_rc < 0)
+        {
+          // Stop reading like IncrementalReadModelGeometry() does.
+          rc = false;
+          bEndOfTable = true;
+          bAddRecords = false;
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < records.Count(); i++)
+    delete records[i];
+
+  // If BeginRead3dmObjectTable() returns true, 
+  // then you MUST call EndRead3dmObjectTable().
+  archive.EndRead3dmObjectTable();
+
+  return rc;
+}
+
+class MYONX_ModelDeferredGeometry : public MYON_DeferredModelGeometry
+{
+public:
+  MYONX_ModelDeferredGeometry(
+    const std::shared_ptr<MYON_BinaryArchive>& archive_sp,
+    MYON_3dmDeferredObject* record
+    )
+    : m_archive_sp(archive_sp)
+    , m_record(record)
+  {}
+
+  ~MYONX_ModelDeferredGeometry()
+  {
+    delete m_record;
+  }
+
+protected:
+  MYON_Geometry* Internal_CreateGeometry() override
+  {
+    MYON_Geometry* geometry = nullptr;
+    if (nullptr != m_archive_sp.get() && nullptr != m_record)
+    {
+      // Deferred object types do not use attributes when they are converted.
+      MYON_Object* object = m_archive_sp->Create3dmDeferredObject(*m_record, nullptr);
+      geometry = MYON_Geometry::Cast(object);
+      if (nullptr == geometry && nullptr != object)
+        delete object;
+    }
+    delete m_record;
+    m_record = nullptr;
+    // The archive is closed when all deferred geometry has been created.
+    m_archive_sp.reset();
+    return geometry;
+  }
+
+private:
+  std::shared_ptr<MYON_BinaryArchive> m_archive_sp;
+  MYON_3dmDeferredObject* m_record = nullptr;
+};
+
+bool MYONX_ModelPrivate::ReadDeferredModelGeometryTable(
+  unsigned int object_filter
+  )
+{
+  MYON_BinaryArchive& archive = *m_deferred_geometry_archive_sp;
+
+  if (false == archive.BeginRead3dmObjectTable())
+  {
+    MYON_ERROR("Geoemtry table cannot be read from archive.");
+    return false;
+  }
+
+  const bool bManageComponents = true;
+  bool rc = true;
+  for (;;)
+  {
+    MYON_3dmDeferredObject* record = new MYON_3dmDeferredObject();
+    MYON_3dmObjectAttributes* attributes = new MYON_3dmObjectAttributes();
+    MYON_ModelGeometryComponent* model_geometry = nullptr;
+    const int read_rc = archive.Read3dmObjectForExperts(attributes, object_filter, *record);
+    if (1 == read_rc)
+    {
+      if (record->DecodePending())
+      {
+        // The object is decoded the first time its geometry is requested.
+        if (1 == archive.Finish3dmDeferredObjectAttributes(*record, attributes))
+        {
+          model_geometry = MYON_ModelGeometryComponent::CreateDeferredForExperts(
+            new MYONX_ModelDeferredGeometry(m_deferred_geometry_archive_sp, record), 
+            attributes, 
+            nullptr
+          );
+          record = nullptr;
+          attributes = nullptr;
+        }
+        else
+          rc = false;
+      }
+      else
+      {
+        // Objects that reference the archive's component tables are decoded now.
+        // Records that reference an earlier object share its geometry.
+        const std::shared_ptr<MYON_Object> shared = record->SharedObject();
+        MYON_Object* object = nullptr;
+        const int finish_rc = archive.Finish3dmDeferredObject(*record, (nullptr == shared.get()) ? &object : nullptr, attributes);
+        MYON_Geometry* geometry = MYON_Geometry::Cast(object);
+        if (1 == finish_rc && nullptr != shared.get())
+        {
+          const std::shared_ptr<MYON_Geometry> geometry_sp(shared, MYON_Geometry::Cast(shared.get()));
+          model_geometry = MYON_ModelGeometryComponent::CreateSharedForExperts(geometry_sp, attributes, nullptr);
+          if (nullptr != model_geometry)
+            attributes = nullptr;
+        }
+        else if (1 == finish_rc && nullptr != geometry)
+        {
+          model_geometry = MYON_ModelGeometryComponent::CreateForExperts(true, geometry, true, attributes, nullptr);
+          attributes = nullptr;
+        }
+        else
+        {
+          delete object;
+          if (finish_rc < 0)
+            rc = false;
+        }
+      }
+    }
+    delete record;
+    delete attributes;
+
+    if (nullptr != model_geometry && m_model.AddModelComponentForExperts(model_geometry, bManageComponents, true, true).IsEmpty())
+      delete model_geometry;
+
+    if (read_rc < 0)
+      rc = false;
+    if (false == rc || (1 != read_rc && 2 != read_rc))
+      break; // end of object table or error reading
+  }
+
+  // If BeginRead3dmObjectTable() returns true, 
+  // then you MUST call EndRead3dmObjectTable().
+  archive.EndRead3dmObjectTable();
+
+  return rc;
+}
+
+bool MYONX_ModelPrivate::ReadMappedFile(
+  const std::shared_ptr<MYON_BinaryArchive>& archive_sp,
+  unsigned int table_filter,
+  unsigned int model_object_type_filter,
+  MYON_TextLog* error_log
+  )
+{
+  if (m_bDeferGeometryReading)
+    m_deferred_geometry_archive_sp = archive_sp;
+  if (m_bReferenceUnknownUserData)
+    archive_sp->SetUnknownUserDataReferenceOwner(archive_sp);
+  const bool rc = m_model.Read(*archive_sp, table_filter, model_object_type_filter, error_log);
+  // The archive cannot own itself after reading is finished.
+  archive_sp->SetUnknownUserDataReferenceOwner(std::shared_ptr<const void>());
+  m_deferred_geometry_archive_sp.reset();
+  return rc;
+}
+
+void MYONX_Model::SetDeferGeometryReading(
+  bool bDeferGeometryReading
+  )
+{
+  m_private->m_bDeferGeometryReading = bDeferGeometryReading;
+}
+
+bool MYONX_Model::DeferGeometryReading() const
+{
+  return m_private->m_bDeferGeometryReading;
+}
+
+void MYONX_Model::SetReferenceUnknownUserData(
+  bool bReferenceUnknownUserData
+  )
+{
+  m_private->m_bReferenceUnknownUserData = bReferenceUnknownUserData;
+}
+
+bool MYONX_Model::ReferenceUnknownUserData() const
+{
+  return m_private->m_bReferenceUnknownUserData;
+}
+
+// Component types saved by MYONX_Model::AppendChanges() in table order.
+static const MYON_ModelComponent::Type Internal_AppendedChangesComponentTypes[] =
+{
+  MYON_ModelComponent::Type::Image,
+  MYON_ModelComponent::Type::TextureMapping,
+  MYON_ModelComponent::Type::Material,
+  MYON_ModelComponent::Type::LinePattern,
+  MYON_ModelComponent::Type::Layer,
+  MYON_ModelComponent::Type::Group,
+  MYON_ModelComponent::Type::DimStyle,
+  MYON_ModelComponent::Type::RenderLight,
+  MYON_ModelComponent::Type::HatchPattern,
+  MYON_ModelComponent::Type::InstanceDefinition,
+  MYON_ModelComponent::Type::ModelGeometry,
+  MYON_ModelComponent::Type::HistoryRecord
+};
+
+// Component types that are referenced by index from other components.
+static const MYON_ModelComponent::Type Internal_AppendedChangesReferencedTypes[] =
+{
+  MYON_ModelComponent::Type::Material,
+  MYON_ModelComponent::Type::LinePattern,
+  MYON_ModelComponent::Type::Layer,
+  MYON_ModelComponent::Type::Group,
+  MYON_ModelComponent::Type::HatchPattern
+};
+
+static MYON__UINT64 Internal_AppendedChangesReferenceKey(
+  MYON_ModelComponent::Type component_type,
+  int component_index
+  )
+{
+  return (((MYON__UINT64)static_cast<unsigned char>(component_type)) << 32) | ((MYON__UINT64)((MYON__UINT32)component_index));
+}
+
+void MYONX_ModelPrivate::SetAppendBaseline(
+  int archive_3dm_version,
+  MYON__UINT64 file_length
+  )
+{
+  m_append_baseline.clear();
+  for (size_t i = 0; i < sizeof(Internal_AppendedChangesComponentTypes) / sizeof(Internal_AppendedChangesComponentTypes[0]); i++)
+  {
+    const MYONX_ModelComponentReferenceLink* link = m_model.Internal_ComponentListConst(Internal_AppendedChangesComponentTypes[i]).m_first_mcr_link;
+    for ( /*empty init*/; nullptr != link; link = link->m_next)
+    {
+      const MYON_ModelComponent* model_component = link->m_mcr.ModelComponent();
+      if (nullptr == model_component || model_component->IsSystemComponent())
+        continue;
+      AppendBaselineItem& item = m_append_baseline[model_component->Id()];
+      item.m_component_type = model_component->ComponentType();
+      item.m_runtime_serial_number = model_component->RuntimeSerialNumber();
+      item.m_content_version_number = model_component->ContentVersionNumber();
+    }
+  }
+  m_append_marked_ids.Empty();
+  m_append_baseline_3dm_version = archive_3dm_version;
+  m_append_baseline_file_length = file_length;
+  m_bAppendBaselineIsSet = (archive_3dm_version >= 50 && file_length > 0);
+}
+
+void MYONX_ModelPrivate::ClearAppendBaseline()
+{
+  m_append_baseline.clear();
+  m_append_marked_ids.Empty();
+  m_bAppendBaselineIsSet = false;
+  m_append_baseline_3dm_version = 0;
+  m_append_baseline_file_length = 0;
+  m_appended_changes_count = 0;
+}
+
+bool MYONX_ModelPrivate::WriteAppendedChanges(
+  MYON_BinaryArchive& archive,
+  unsigned int& change_count
+  ) const
+{
+  change_count = 0;
+
+  // Components that were deleted or replaced by a component with a different type.
+  MYON_SimpleArray<const std::pair<const MYON_UUID, AppendBaselineItem>*> deleted;
+  for (const auto& baseline_item : m_append_baseline)
+  {
+    const MYON_ModelComponentReference mcr = m_model.ComponentFromId(baseline_item.second.m_component_type, baseline_item.first);
+    if (nullptr == mcr.ModelComponent())
+      deleted.Append(&baseline_item);
+  }
+
+  // Components that were added or modified.
+  MYON_SimpleArray<const MYON_ModelComponent*> changed;
+  for (size_t i = 0; i < sizeof(Internal_AppendedChangesComponentTypes) / sizeof(Internal_AppendedChangesComponentTypes[0]); i++)
+  {
+    const MYONX_ModelComponentReferenceLink* link = m_model.Internal_ComponentListConst(Internal_AppendedChangesComponentTypes[i]).m_first_mcr_link;
+    for ( /*empty init*/; nullptr != link; link = link->m_next)
+    {
+      const MYON_ModelComponent* model_component = link->m_mcr.ModelComponent();
+      if (nullptr == model_component || model_component->IsSystemComponent())
+        continue;
+      const auto it = m_append_baseline.find(model_component->Id());
+      if (
+        m_append_baseline.end() == it
+        || it->second.m_component_type != model_component->ComponentType()
+        || it->second.m_runtime_serial_number != model_component->RuntimeSerialNumber()
+        || it->second.m_content_version_number != model_component->ContentVersionNumber()
+        || m_append_marked_ids.FindUuid(model_component->Id())
+        )
+      {
+        changed.Append(model_component);
+      }
+    }
+  }
+
+  change_count = deleted.UnsignedCount() + changed.UnsignedCount();
+  if (0 == change_count)
+    return true;
+
+  // Component references are saved as runtime indices and converted
+  // to the reader's indices using the reference table.
+  archive.SetReferencedComponentIndexMapping(false);
+  archive.SetReferencedComponentIdMapping(false);
+
+  if (!archive.BeginWrite3dmChunk(TCODE_APPENDED_CHANGES_TABLE, 1, 0))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    if (!archive.WriteInt(MYON::Version()))
+      break;
+
+    // reference table
+    unsigned int reference_count = 0;
+    for (size_t i = 0; i < sizeof(Internal_AppendedChangesReferencedTypes) / sizeof(Internal_AppendedChangesReferencedTypes[0]); i++)
+      reference_count += m_model.Internal_ComponentListConst(Internal_AppendedChangesReferencedTypes[i]).m_count;
+    if (!archive.WriteInt(reference_count))
+      break;
+    bool bReferencesWritten = true;
+    for (size_t i = 0; i < sizeof(Internal_AppendedChangesReferencedTypes) / sizeof(Internal_AppendedChangesReferencedTypes[0]) && bReferencesWritten; i++)
+    {
+      const MYONX_ModelComponentReferenceLink* link = m_model.Internal_ComponentListConst(Internal_AppendedChangesReferencedTypes[i]).m_first_mcr_link;
+      for ( /*empty init*/; nullptr != link && bReferencesWritten; link = link->m_next)
+      {
+        const MYON_ModelComponent* model_component = link->m_mcr.ModelComponent();
+        bReferencesWritten
+          = archive.WriteInt(static_cast<unsigned int>(Internal_AppendedChangesReferencedTypes[i]))
+          && archive.WriteInt(nullptr != model_component ? model_component->Index() : MYON_UNSET_INT_INDEX)
+          && archive.WriteUuid(nullptr != model_component ? model_component->Id() : MYON_nil_uuid);
+      }
+    }
+    if (!bReferencesWritten)
+      break;
+
+    // changes
+    if (!archive.WriteInt(change_count))
+      break;
+
+    bool bChangesWritten = true;
+    for (unsigned int i = 0; i < deleted.UnsignedCount() && bChangesWritten; i++)
+    {
+      bChangesWritten = archive.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK, 1, 0);
+      if (!bChangesWritten)
+        break;
+      bChangesWritten
+        = archive.WriteInt(2) // 2 = deleted
+        && archive.WriteInt(static_cast<unsigned int>(deleted[i]->second.m_component_type))
+        && archive.WriteUuid(deleted[i]->first);
+      if (!archive.EndWrite3dmChunk())
+        bChangesWritten = false;
+    }
+
+    for (unsigned int i = 0; i < changed.UnsignedCount() && bChangesWritten; i++)
+    {
+      const MYON_ModelComponent* model_component = changed[i];
+      bChangesWritten = archive.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK, 1, 0);
+      if (!bChangesWritten)
+        break;
+      bChangesWritten
+        = archive.WriteInt(1) // 1 = added or modified
+        && archive.WriteInt(static_cast<unsigned int>(model_component->ComponentType()))
+        && archive.WriteUuid(model_component->Id());
+      const MYON_ModelGeometryComponent* model_geometry = MYON_ModelGeometryComponent::Cast(model_component);
+      if (bChangesWritten && nullptr != model_geometry)
+      {
+        const MYON_Geometry* geometry = model_geometry->Geometry(nullptr);
+        const MYON_3dmObjectAttributes* attributes = model_geometry->Attributes(nullptr);
+        bChangesWritten = (nullptr != geometry) && archive.WriteObject(geometry);
+        if (bChangesWritten)
+          bChangesWritten = archive.WriteBool(nullptr != attributes);
+        if (bChangesWritten && nullptr != attributes)
+          bChangesWritten = archive.WriteObject(attributes);
+      }
+      else if (bChangesWritten)
+        bChangesWritten = archive.WriteObject(model_component);
+      if (!archive.EndWrite3dmChunk())
+        bChangesWritten = false;
+    }
+    if (!bChangesWritten)
+      break;
+
+    rc = true;
+    break;
+  }
+
+  if (!archive.EndWrite3dmChunk())
+    rc = false;
+
+  return rc;
+}
+
+bool MYONX_ModelPrivate::ReadAppendedChanges(
+  MYON_BinaryArchive& archive
+  )
+{
+  int major_version = 0;
+  int minor_version = 0;
+  if (!archive.BeginRead3dmChunk(TCODE_APPENDED_CHANGES_TABLE, &major_version, &minor_version))
+    return false;
+
+  // The changes were written by AppendChanges() with component reference
+  // mapping disabled and the writer's opennurbs version.
+  const bool bReferencedComponentIndexMapping = archive.ReferencedComponentIndexMapping();
+  const bool bReferencedComponentIdMapping = archive.ReferencedComponentIdMapping();
+  const unsigned int archive_opennurbs_version = archive.ArchiveOpenNURBSVersion();
+  archive.SetReferencedComponentIndexMapping(false);
+  archive.SetReferencedComponentIdMapping(false);
+
+  // writer (component type, index) -> component id
+  std::map<MYON__UINT64, MYON_UUID> writer_references;
+  const auto ReaderIndex = [&](MYON_ModelComponent::Type component_type, int writer_index, int unset_index)
+  {
+    if (writer_index < 0)
+      return writer_index; // system component
+    const auto it = writer_references.find(Internal_AppendedChangesReferenceKey(component_type, writer_index));
+    if (writer_references.end() == it)
+      return unset_index;
+    const MYON_ModelComponent* model_component = m_model.ComponentFromId(component_type, it->second).ModelComponent();
+    return (nullptr != model_component) ? model_component->Index() : unset_index;
+  };
+
+  struct AppendedChange
+  {
+    int m_op = 0; // 1 = added or modified, 2 = deleted
+    MYON_ModelComponent::Type m_component_type = MYON_ModelComponent::Type::Unset;
+    MYON_UUID m_component_id = MYON_nil_uuid;
+    MYON_Object* m_object = nullptr;
+    MYON_Object* m_attributes = nullptr;
+  };
+  MYON_ClassArray<AppendedChange> changes;
+
+  bool rc = false;
+  for (;;)
+  {
+    if (1 != major_version)
+      break;
+
+    unsigned int writer_opennurbs_version = 0;
+    if (!archive.ReadInt(&writer_opennurbs_version))
+      break;
+    MYON_SetBinaryArchiveOpenNURBSVersion(archive, writer_opennurbs_version);
+
+    unsigned int reference_count = 0;
+    if (!archive.ReadInt(&reference_count))
+      break;
+    bool bReferencesRead = true;
+    for (unsigned int i = 0; i < reference_count && bReferencesRead; i++)
+    {
+      unsigned int component_type = 0;
+      int component_index = MYON_UNSET_INT_INDEX;
+      MYON_UUID component_id = MYON_nil_uuid;
+      bReferencesRead = archive.ReadInt(&component_type) && archive.ReadInt(&component_index) && archive.ReadUuid(component_id);
+      if (bReferencesRead)
+        writer_references[Internal_AppendedChangesReferenceKey(MYON_ModelComponent::ComponentTypeFromUnsigned(component_type), component_index)] = component_id;
+    }
+    if (!bReferencesRead)
+      break;
+
+    unsigned int change_count = 0;
+    if (!archive.ReadInt(&change_count))
+      break;
+
+    // The changes are read before any of them are applied so a section 
+    // that cannot be completely read does not change the model.
+    bool bChangesRead = true;
+    for (unsigned int i = 0; i < change_count && bChangesRead; i++)
+    {
+      int change_major_version = 0;
+      int change_minor_version = 0;
+      bChangesRead = archive.BeginRead3dmChunk(TCODE_ANONYMOUS_CHUNK, &change_major_version, &change_minor_version);
+      if (!bChangesRead)
+        break;
+
+      AppendedChange& change = changes.AppendNew();
+      unsigned int utype = 0;
+      bChangesRead = (1 == change_major_version) && archive.ReadInt(&change.m_op) && archive.ReadInt(&utype) && archive.ReadUuid(change.m_component_id);
+      change.m_component_type = MYON_ModelComponent::ComponentTypeFromUnsigned(utype);
+      if (bChangesRead && 1 == change.m_op)
+      {
+        bChangesRead = (1 == archive.ReadObject(&change.m_object));
+        if (bChangesRead && (MYON_ModelComponent::Type::ModelGeometry == change.m_component_type || MYON_ModelComponent::Type::RenderLight == change.m_component_type))
+        {
+          bool bHaveAttributes = false;
+          bChangesRead = archive.ReadBool(&bHaveAttributes);
+          if (bChangesRead && bHaveAttributes)
+            bChangesRead = (1 == archive.ReadObject(&change.m_attributes)) && nullptr != MYON_3dmObjectAttributes::Cast(change.m_attributes);
+          if (bChangesRead)
+            bChangesRead = (nullptr != MYON_Geometry::Cast(change.m_object));
+        }
+        else if (bChangesRead)
+          bChangesRead = (nullptr != MYON_ModelComponent::Cast(change.m_object));
+      }
+      if (!archive.EndRead3dmChunk())
+        bChangesRead = false;
+    }
+    if (!bChangesRead)
+      break;
+
+    rc = true;
+    break;
+  }
+
+  if (!archive.EndRead3dmChunk())
+    rc = false;
+
+  for (unsigned int i = 0; i < changes.UnsignedCount(); i++)
+  {
+    AppendedChange& change = changes[i];
+    if (false == rc)
+    {
+      delete change.m_object;
+      delete change.m_attributes;
+      continue;
+    }
+
+    const MYON_ModelComponent::Type component_type = change.m_component_type;
+    const MYON_UUID component_id = change.m_component_id;
+    MYON_ModelComponent* model_component = nullptr;
+    if (1 == change.m_op)
+    {
+      // Component references are converted when the change is applied
+      // because earlier changes in the section may add the referenced component.
+      if (MYON_ModelComponent::Type::ModelGeometry == component_type || MYON_ModelComponent::Type::RenderLight == component_type)
+      {
+        MYON_3dmObjectAttributes* object_attributes = MYON_3dmObjectAttributes::Cast(change.m_attributes);
+        if (nullptr != object_attributes)
+        {
+          object_attributes->m_layer_index = ReaderIndex(MYON_ModelComponent::Type::Layer, object_attributes->m_layer_index, 0);
+          object_attributes->m_linetype_index = ReaderIndex(MYON_ModelComponent::Type::LinePattern, object_attributes->m_linetype_index, -1);
+          object_attributes->m_material_index = ReaderIndex(MYON_ModelComponent::Type::Material, object_attributes->m_material_index, -1);
+          MYON_SimpleArray<int> group_list;
+          if (object_attributes->GetGroupList(group_list) > 0)
+          {
+            object_attributes->RemoveFromAllGroups();
+            for (int j = 0; j < group_list.Count(); j++)
+            {
+              const int group_index = ReaderIndex(MYON_ModelComponent::Type::Group, group_list[j], MYON_UNSET_INT_INDEX);
+              if (group_index >= 0)
+                object_attributes->AddToGroup(group_index);
+            }
+          }
+        }
+        MYON_Hatch* hatch = MYON_Hatch::Cast(change.m_object);
+        if (nullptr != hatch)
+          hatch->SetPatternIndex(ReaderIndex(MYON_ModelComponent::Type::HatchPattern, hatch->PatternIndex(), -1));
+        model_component = MYON_ModelGeometryComponent::CreateForExperts(true, change.m_object, true, object_attributes, nullptr);
+      }
+      else
+      {
+        model_component = MYON_ModelComponent::Cast(change.m_object);
+        MYON_Layer* layer = MYON_Layer::Cast(model_component);
+        if (nullptr != layer)
+        {
+          layer->SetLinetypeIndex(ReaderIndex(MYON_ModelComponent::Type::LinePattern, layer->LinetypeIndex(), -1));
+          layer->SetRenderMaterialIndex(ReaderIndex(MYON_ModelComponent::Type::Material, layer->RenderMaterialIndex(), -1));
+        }
+      }
+      change.m_object = nullptr;
+      change.m_attributes = nullptr;
+    }
+
+    const MYON_ModelComponentReference existing_mcr = m_model.ComponentFromId(component_type, component_id);
+    MYON_ModelComponent* existing_component = const_cast<MYON_ModelComponent*>(existing_mcr.ModelComponent());
+    if (2 == change.m_op)
+    {
+      if (nullptr != existing_component)
+        m_model.RemoveModelComponent(component_type, component_id);
+    }
+    else if (nullptr != model_component && component_type == model_component->ComponentType())
+    {
+      if (nullptr != existing_component)
+      {
+        // Modify the component in place so its index and its position 
+        // in the model do not change.
+        const int index = existing_component->Index();
+        if (existing_component->CopyFrom(static_cast<const MYON_Object*>(model_component)))
+        {
+          if (MYON_UNSET_INT_INDEX != index)
+            existing_component->SetIndex(index);
+          else
+            existing_component->ClearIndex();
+          existing_component->SetId(component_id);
+          m_model.m_manifest.ChangeComponentName(*existing_component);
+          m_model.Internal_IncrementModelContentVersionNumber();
+        }
+        delete model_component;
+      }
+      else if (m_model.AddModelComponentForExperts(model_component, true, true, true).IsEmpty())
+      {
+        delete model_component;
+      }
+      model_component = nullptr;
+    }
+    delete model_component;
+  }
+
+  MYON_SetBinaryArchiveOpenNURBSVersion(archive, archive_opennurbs_version);
+  archive.SetReferencedComponentIndexMapping(bReferencedComponentIndexMapping);
+  archive.SetReferencedComponentIdMapping(bReferencedComponentIdMapping);
+
+  m_model.m_model_geometry_bbox = MYON_BoundingBox::UnsetBoundingBox;
+  m_model.m_render_light_bbox = MYON_BoundingBox::UnsetBoundingBox;
+
+  return rc;
+}
+
+bool MYONX_Model::AppendChanges(
+  const char* filename,
+  MYON_TextLog* error_log
+  ) const
+{
+  const MYON_wString wfilename(filename);
+  return AppendChanges(static_cast<const wchar_t*>(wfilename), error_log);
+}
+
+bool MYONX_Model::AppendChanges(
+  const wchar_t* filename,
+  MYON_TextLog* error_log
+  ) const
+{
+  if (nullptr == filename || 0 == filename[0])
+    return false;
+
+  if (false == m_private->m_bAppendBaselineIsSet)
+  {
+    if (error_log)
+      error_log->Print("MYONX_Model::AppendChanges - the model was not completely read from or written to a file.\n");
+    return false;
+  }
+
+  MYON_Write3dmBufferArchive buffer_archive(0, 0, m_private->m_append_baseline_3dm_version, MYON::Version());
+  unsigned int change_count = 0;
+  if (false == m_private->WriteAppendedChanges(buffer_archive, change_count))
+  {
+    if (error_log)
+      error_log->Print("MYONX_Model::AppendChanges - unable to save changes.\n");
+    return false;
+  }
+  if (0 == change_count)
+    return true;
+
+  const MYON__UINT64 file_length = m_private->m_append_baseline_file_length;
+  if (false == buffer_archive.Write3dmAppendedEndMark(file_length) || 0 != buffer_archive.CriticalErrorCount())
+  {
+    if (error_log)
+      error_log->Print("MYONX_Model::AppendChanges - unable to save changes.\n");
+    return false;
+  }
+
+  FILE* fp = MYON::OpenFile(filename, L"r+b");
+  if (nullptr == fp)
+  {
+    if (error_log)
+      error_log->Print("MYONX_Model::AppendChanges - unable to open file.\n");
+    return false;
+  }
+
+  bool rc = false;
+  const MYON__UINT64 sizeof_changes = buffer_archive.SizeOfArchive();
+  if (
+    MYON_FileStream::SeekFromEnd(fp, 0) 
+    && file_length == (MYON__UINT64)MYON_FileStream::CurrentPosition(fp)
+    )
+  {
+    rc 
+      = sizeof_changes == MYON_FileStream::Write(fp, sizeof_changes, buffer_archive.Buffer())
+      && MYON_FileStream::Flush(fp);
+  }
+  else if (error_log)
+  {
+    error_log->Print("MYONX_Model::AppendChanges - the file was changed after the model was read or written.\n");
+  }
+  MYON::CloseFile(fp);
+
+  if (rc)
+  {
+    const unsigned int appended_changes_count = m_private->m_appended_changes_count + 1;
+    m_private->SetAppendBaseline(m_private->m_append_baseline_3dm_version, file_length + sizeof_changes);
+    m_private->m_appended_changes_count = appended_changes_count;
+  }
+  else
+  {
+    // The end of the file may be damaged. Write() must be called.
+    m_private->ClearAppendBaseline();
+  }
+
+  return rc;
+}
+
+void MYONX_Model::MarkComponentChanged(
+  MYON_UUID component_id
+  )
+{
+  if (m_manifest.ItemFromId(component_id).IsUnset())
+    return;
+  m_private->m_append_marked_ids.AddUuid(component_id, true);
+}
+
+unsigned int MYONX_Model::AppendedChangesCount() const
+{
+  return m_private->m_appended_changes_count;
+}
+
+bool MYONX_Model::CompactAppendedChanges(
+  const char* filename,
+  MYON_TextLog* error_log
+  ) const
+{
+  const MYON_wString wfilename(filename);
+  return CompactAppendedChanges(static_cast<const wchar_t*>(wfilename), error_log);
+}
+
+bool MYONX_Model::CompactAppendedChanges(
+  const wchar_t* filename,
+  MYON_TextLog* error_log
+  ) const
+{
+  const int version 
+    = m_private->m_bAppendBaselineIsSet 
+    ? m_private->m_append_baseline_3dm_version 
+    : m_3dm_file_version;
+  return Write(filename, version, error_log);
+}
+
+bool MYONX_ModelPrivate::CopyManifest(
+  const MYON_ComponentManifest& src,
+  MYON_ComponentManifest& dst
+  )
+{
+  dst.Reset();
+
+  bool rc = true;
+  for (unsigned int i = 0; i < int(MYON_ModelComponent::Type::NumOf); i++)
+  {
+    const MYON_ModelComponent::Type component_type = MYON_ModelComponent::ComponentTypeFromUnsigned(i);
+    if (MYON_ModelComponent::Type::Unset == component_type || MYON_ModelComponent::Type::Mixed == component_type)
+      continue;
+    const bool bIndexRequired = MYON_ModelComponent::IndexRequired(component_type);
+    for (const MYON_ComponentManifestItem* item = src.FirstItem(component_type); nullptr != item; item = src.NextItem(item))
+    {
+      if (item->IsSystemComponent())
+        continue;
+
+      if (bIndexRequired)
+      {
+        // Removed components leave unused indices in the source manifest.
+        // Add and remove placeholders so the copied items get the same indices.
+        while (dst.ComponentIndexLimit(component_type) < item->Index())
+        {
+          const MYON_UUID placeholder_id = MYON_CreateId();
+          MYON_wString placeholder_name;
+          MYON_UuidToString(placeholder_id, placeholder_name);
+          const MYON_ComponentManifestItem& placeholder = dst.AddComponentToManifest(
+            component_type,
+            0,
+            placeholder_id,
+            MYON_NameHash::Create(MYON_nil_uuid, placeholder_name)
+          );
+          if (placeholder.IsUnset() || false == dst.RemoveComponent(placeholder_id))
+          {
+            MYON_ERROR("Unable to reserve a manifest index.");
+            return false;
+          }
+        }
+      }
+
+      const MYON_ComponentManifestItem& dst_item = dst.AddComponentToManifest(
+        component_type,
+        item->ComponentRuntimeSerialNumber(),
+        item->Id(),
+        item->NameHash()
+      );
+      if (dst_item.IsUnset() || (bIndexRequired && dst_item.Index() != item->Index()))
+      {
+        MYON_ERROR("Unable to copy manifest item.");
+        rc = false;
+        continue;
+      }
+      if (item->IsDeleted())
+        dst.DeleteComponent(item->Id());
+    }
+  }
+
+  return rc;
+}
+
+std::shared_ptr<const MYONX_Model> MYONX_Model::CreateSnapshot() const
+{
+  std::shared_ptr<MYONX_Model> snapshot_sp = std::make_shared<MYONX_Model>();
+  MYONX_Model& snapshot = *snapshot_sp;
+
+  snapshot.m_3dm_file_version = m_3dm_file_version;
+  snapshot.m_3dm_opennurbs_version = m_3dm_opennurbs_version;
+  snapshot.m_3dm_file_byte_count = m_3dm_file_byte_count;
+  snapshot.m_sStartSectionComments = m_sStartSectionComments;
+  snapshot.m_properties = m_properties;
+  snapshot.m_settings = m_settings;
+
+  snapshot.m_default_render_material = m_default_render_material;
+  snapshot.m_default_line_pattern = m_default_line_pattern;
+  snapshot.m_default_layer = m_default_layer;
+  snapshot.m_default_text_style = m_default_text_style;
+  snapshot.m_default_dimension_style = m_default_dimension_style;
+
+  for (unsigned int i = 0; i < m_userdata_table.UnsignedCount(); i++)
+  {
+    const MYONX_Model_UserData* ud = m_userdata_table[i];
+    if (nullptr != ud)
+      snapshot.m_userdata_table.Append(new MYONX_Model_UserData(*ud));
+  }
+
+  if (nullptr != m_model_user_string_list)
+    snapshot.m_model_user_string_list = MYON_DocumentUserStringList::Cast(m_model_user_string_list->Duplicate());
+
+  if (false == MYONX_ModelPrivate::CopyManifest(m_manifest, snapshot.m_manifest))
+    MYON_ERROR("The snapshot manifest is not a complete copy.");
+  snapshot.m_original_to_manifest_map = m_original_to_manifest_map;
+  snapshot.m_manifest_to_original_map = m_manifest_to_original_map;
+
+  for (int i = 0; i < m_private->m_mcr_lists.Count(); i++)
+  {
+    for (const MYONX_ModelComponentReferenceLink* link = m_private->m_mcr_lists[i].m_first_mcr_link; nullptr != link; link = link->m_next)
+      snapshot.Internal_AddModelComponentReference(link->m_mcr);
+  }
+  snapshot.m_private->m_model_content_version_number = m_private->m_model_content_version_number;
+
+  if (m_model_geometry_bbox.IsValid())
+    snapshot.m_model_geometry_bbox = m_model_geometry_bbox;
+  if (m_render_light_bbox.IsValid())
+    snapshot.m_render_light_bbox = m_render_light_bbox;
+
+  // Tidy the search structures so lookups on the snapshot never modify it.
+  snapshot.m_manifest.PrepareForConcurrentReaders();
+  snapshot.m_mcr_sn_map.PrepareForConcurrentReaders();
+  snapshot.m_private->m_bIsSnapshot = true;
+
+  return snapshot_sp;
+}
+
+bool MYONX_Model::IncrementalReadFinish(
+    MYON_BinaryArchive& archive,
+    bool bManageComponents,
+    unsigned int table_filter,
+    MYON_TextLog* error_log
+    )
+{
+  int rc;
+
+  const bool bResolveIdAndNameConflicts = true;
+  const bool bUpdateComponentIdentification = true;
+
+  if ( 0 == table_filter )
+    table_filter = 0xFFFFFFFF; // read everything
+
+  // STEP 16: Read history table
+  if ( archive.BeginRead3dmHistoryRecordTable() )
+  {
+    if ( 0 != (static_cast<unsigned int>(MYON_3dmArchiveTableType::historyrecord_table) & table_filter) )
+    {
+      for(;;) 
+      {
+        MYON_HistoryRecord* pHistoryRecord = nullptr;
+        rc = archive.Read3dmHistoryRecord(pHistoryRecord);
+        if ( rc == 0 )
+          break; // end of history record table
+        if ( rc < 0 ) 
+          break;
+        if ( AddModelComponentForExperts(pHistoryRecord,bManageComponents,bResolveIdAndNameConflicts,bUpdateComponentIdentification).IsEmpty() )
+        {
+          delete pHistoryRecord;
+          continue;
+        }
+      }
+    }
+    
+    // If BeginRead3dmHistoryRecordTable() returns true, 
+    // then you MUST call EndRead3dmHistoryRecordTable().
+    if ( !archive.EndRead3dmHistoryRecordTable() )
+    {
+      return false;
+    }
+  }
+
+  // STEP 17: OPTIONAL - Read user tables as anonymous goo
+  // If you develop a plug-ins or application that uses OpenNURBS files,
+  // you can store anything you want in a user table.
+  for(;;)
+  {
+    if ( archive.Archive3dmVersion() <= 1 )
+    {
+      // no user tables in version 1 archives.
+      break;
+    }
+
+    {
+      MYON__UINT32 tcode = 0;
+      MYON__INT64 big_value = 0;
+      if ( !archive.PeekAt3dmBigChunkType(&tcode,&big_value) )
+        break;
+      if ( TCODE_USER_TABLE != tcode )
+        break;
+    }
+    MYON_UUID plugin_id = MYON_nil_uuid;
+    bool bGoo = false;
+    int usertable_3dm_version = 0;
+    unsigned int usertable_opennurbs_version = 0;
+    if ( !archive.BeginRead3dmUserTable( plugin_id, &bGoo, &usertable_3dm_version, &usertable_opennurbs_version ) )
+    {
+      // attempt to skip bogus user table
+      const MYON__UINT64 pos0 = archive.CurrentPosition();
+      MYON__UINT32 tcode = 0;
+      MYON__INT64 big_value = 0;
+      if  ( !archive.BeginRead3dmBigChunk(&tcode,&big_value) )
+        break;
+      if ( !archive.EndRead3dmChunk() )
+        break;
+      const MYON__UINT64 pos1 = archive.CurrentPosition();
+      if (pos1 <= pos0)
+        break;
+      if ( TCODE_USER_TABLE != tcode )
+        break;
+
+      continue; // skip this bogus user table
+    }
+
+    if ( 
+      nullptr == m_model_user_string_list
+      && plugin_id == MYON_CLASS_ID(MYON_DocumentUserStringList) 
+      )
+    {
+      // Read the document user strings (key-value pairs) as
+      // a user table with plug-in id = MYON_CLASS_ID(MYON_DocumentUserStringList)
+      MYON_Object* p = 0;
+      archive.ReadObject(&p);
+      m_model_user_string_list = MYON_DocumentUserStringList::Cast(p);
+      if ( 0 == m_model_user_string_list )
+      {
+        MYON_ERROR("The document user string information in the file is damaged.");
+        if ( 0 != p )
+          delete p;
+          p = 0;
+      }
+    } 
+    else if ( 0 != (static_cast<unsigned int>(MYON_3dmArchiveTableType::user_table) & table_filter) )
+    {
+      // read user data tables as anonymous goo
+      MYONX_Model_UserData* model_ud = new MYONX_Model_UserData();
+      model_ud->m_uuid = plugin_id;
+      model_ud->m_usertable_3dm_version = usertable_3dm_version;
+      model_ud->m_usertable_opennurbs_version = usertable_opennurbs_version;
+      if ( !archive.Read3dmAnonymousUserTable( usertable_3dm_version, usertable_opennurbs_version, model_ud->m_goo ) )
+      {
+        delete model_ud;
+        break;
+      }
+      m_userdata_table.Append(model_ud);
+    }
+
+    // If BeginRead3dmObjectTable() returns true, 
+    // then you MUST call EndRead3dmUserTable().
+    if ( !archive.EndRead3dmUserTable() )
+    {
+      break;
+    }
+  }
+
+  // STEP 18: OPTIONAL - check for end mark
+  bool bAppendedChangesRead = true;
+  size_t file_length = 0;
+  if ( !archive.Read3dmEndMark(&file_length) )
+  {
+    if ( archive.Archive3dmVersion() != 1 ) 
+    {
+      // some v1 files are missing end-of-archive markers
+    }
+  }
+  else
+  {
+    m_3dm_file_byte_count = file_length;
+
+    // STEP 19: Replay changes saved by MYONX_Model::AppendChanges().
+    //          A section that cannot be read is not applied.
+    m_private->m_appended_changes_count = 0;
+    while (0xFFFFFFFF == table_filter && archive.AtAppended3dmChanges())
+    {
+      if (!m_private->ReadAppendedChanges(archive))
+      {
+        if (error_log)
+          error_log->Print("Unable to read changes appended to the file.\n");
+        bAppendedChangesRead = false;
+        break;
+      }
+      size_t appended_file_length = 0;
+      if (!archive.Read3dmAppendedEndMark(&appended_file_length))
+        break;
+      m_3dm_file_byte_count = appended_file_length;
+      m_private->m_appended_changes_count++;
+    }
+  }
+  return (bAppendedChangesRead && 0 == archive.CriticalErrorCount());
+}
+
+
+bool MYONX_Model::Read( 
+    const char* filename,
+    unsigned int table_filter,
+    unsigned int model_object_type_filter,
+    MYON_TextLog* error_log
+    )
+{
+  const MYON_wString wfilename_buffer(filename);
   const wchar_t* wfilename = static_cast< const wchar_t* >(wfilename_buffer);
   return Read(wfilename,table_filter,model_object_type_filter,error_log);
 }
@@ -2940,6 +4327,14 @@ bool MYONX_Model::Read(
   bool bCallReset = true;
   bool rc = false;
 
+  if ( 0 != filename && (DeferGeometryReading() || ReferenceUnknownUserData()) )
+  {
+    std::shared_ptr<MYON_BinaryMappedFile> mapped_file = std::make_shared<MYON_BinaryMappedFile>(MYON::archive_mode::read3dm, filename);
+    if (mapped_file->FileIsMapped())
+      return m_private->ReadMappedFile(mapped_file, table_filter, model_object_type_filter, error_log);
+    // When the file cannot be mapped, the geometry and unknown user data are read now.
+  }
+
   if ( 0 != filename )
   {
     FILE* fp = MYON::OpenFile(filename,L"rb");
@@ -2947,7 +4342,9 @@ bool MYONX_Model::Read(
     {
       bCallReset = false;
       MYON_BinaryFile file(MYON::archive_mode::read3dm,fp);
+      file.EnableReadBuffer();
       rc = Read(file, table_filter, model_object_type_filter, error_log);
+      file.EnableReadBuffer(0);
       MYON::CloseFile(fp);
     }
   }
@@ -2970,19 +4367,7 @@ bool MYONX_Model::Read(MYON_BinaryArchive& archive, unsigned int table_filter,
   // STEP 15: REQUIRED - Read object (geometry and annotation) table.
   if (0 == (static_cast<unsigned int>(MYON_3dmArchiveTableType::object_table) & table_filter))
   {
-    const bool bManageGeometry = true;
-    const bool bManageAttributes = true;
-    for (;;)
-    {
-      MYON_ModelComponentReference model_geometry_reference;
-
-      if (!IncrementalReadModelGeometry(archive, bManageComponents, bManageGeometry, bManageAttributes,
-                                        model_object_type_filter, model_geometry_reference))
-        break; // Catastrophic error.
-
-      if (model_geometry_reference.IsEmpty())
-        break; // No more geometry.
-    }
+    m_private->ReadModelGeometryTable(archive, model_object_type_filter);
 
     if (0 != archive.CriticalErrorCount())
       return false;
@@ -2999,6 +4384,14 @@ bool MYONX_Model::Read(MYON_BinaryArchive& archive, unsigned int table_filter,
   const int archive_3dm_version = archive.Archive3dmVersion();
   m_private->PopulateRDKComponents(archive_3dm_version);
 
+  if (0 == table_filter && 0 == model_object_type_filter)
+  {
+    // Changes can be appended to the file.
+    const unsigned int appended_changes_count = m_private->m_appended_changes_count;
+    m_private->SetAppendBaseline(archive_3dm_version, m_3dm_file_byte_count);
+    m_private->m_appended_changes_count = appended_changes_count;
+  }
+
   return true;
 }
 
@@ -3009,6 +4402,226 @@ bool MYONX_Model::Read(MYON_BinaryArchive& archive, MYON_TextLog* error_log)
   return Read(archive, table_filter, model_object_type_filter, error_log);
 }
 
+bool MYONX_ModelMetadata::Read(const char* filename, MYON_TextLog* error_log)
+{
+  const MYON_wString wfilename_buffer(filename);
+  const wchar_t* wfilename = static_cast< const wchar_t* >(wfilename_buffer);
+  return Read(wfilename, error_log);
+}
+
+bool MYONX_ModelMetadata::Read(const wchar_t* filename, MYON_TextLog* error_log)
+{
+  Reset();
+
+  bool rc = false;
+  if (nullptr != filename)
+  {
+    FILE* fp = MYON::OpenFile(filename, L"rb");
+    if (0 != fp)
+    {
+      // The read buffer is not enabled because most of the
+      // archive is skipped and buffering would read it anyway.
+      MYON_BinaryFile file(MYON::archive_mode::read3dm, fp);
+      rc = Read(file, error_log);
+      MYON::CloseFile(fp);
+    }
+  }
+
+  return rc;
+}
+
+bool MYONX_ModelMetadata::Read(MYON_BinaryArchive& archive, MYON_TextLog* error_log)
+{
+  Reset();
+
+  // REQUIRED - Read start section
+  if (!archive.Read3dmStartSection(&m_3dm_file_version, m_sStartSectionComments))
+  {
+    if (error_log) error_log->Print("MYONX_ModelMetadata::Read archive.Read3dmStartSection() failed.\n");
+    return false;
+  }
+
+  // REQUIRED - Read properties section
+  if (!archive.Read3dmProperties(m_properties))
+  {
+    if (error_log) error_log->Print("MYONX_ModelMetadata::Read archive.Read3dmProperties() failed.\n");
+    return false;
+  }
+
+  // version of opennurbs used to write the file.
+  m_3dm_opennurbs_version = archive.ArchiveOpenNURBSVersion();
+
+  // REQUIRED - Read setting section
+  if (!archive.Read3dmSettings(m_settings, &m_model_geometry_bbox))
+  {
+    if (error_log) error_log->Print("MYONX_ModelMetadata::Read archive.Read3dmSettings() failed.\n");
+    return false;
+  }
+
+  if (archive.Archive3dmVersion() <= 1)
+  {
+    // Version 1 archives do not have tables.
+    return (0 == archive.CriticalErrorCount());
+  }
+
+  // The tables are skipped in the order they are saved in 3dm archives.
+  const MYON_3dmArchiveTableType tables[] =
+  {
+    MYON_3dmArchiveTableType::bitmap_table,
+    MYON_3dmArchiveTableType::texture_mapping_table,
+    MYON_3dmArchiveTableType::material_table,
+    MYON_3dmArchiveTableType::linetype_table,
+    MYON_3dmArchiveTableType::layer_table,
+    MYON_3dmArchiveTableType::group_table,
+    MYON_3dmArchiveTableType::text_style_table,
+    MYON_3dmArchiveTableType::dimension_style_table,
+    MYON_3dmArchiveTableType::light_table,
+    MYON_3dmArchiveTableType::hatchpattern_table,
+    MYON_3dmArchiveTableType::instance_definition_table,
+    MYON_3dmArchiveTableType::object_table,
+    MYON_3dmArchiveTableType::historyrecord_table
+  };
+  for (size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); i++)
+  {
+    unsigned int record_count = 0;
+    if (!archive.Skip3dmTable(tables[i], &record_count))
+    {
+      if (error_log) error_log->Print("MYONX_ModelMetadata::Read archive.Skip3dmTable() failed.\n");
+      return false;
+    }
+    m_table_record_count[Internal_TableIndex(tables[i])] = record_count;
+  }
+
+  // OPTIONAL - Skip user tables
+  unsigned int user_table_count = 0;
+  for (;;)
+  {
+    MYON__UINT32 tcode = 0;
+    MYON__INT64 big_value = 0;
+    if (!archive.PeekAt3dmBigChunkType(&tcode, &big_value))
+      break;
+    if (TCODE_USER_TABLE != tcode)
+      break;
+    MYON_UUID plugin_id = MYON_nil_uuid;
+    bool bGoo = false;
+    int usertable_3dm_version = 0;
+    unsigned int usertable_opennurbs_version = 0;
+    if (!archive.BeginRead3dmUserTable(plugin_id, &bGoo, &usertable_3dm_version, &usertable_opennurbs_version))
+      break;
+    user_table_count++;
+    if (!archive.EndRead3dmUserTable())
+      break;
+  }
+  m_table_record_count[Internal_TableIndex(MYON_3dmArchiveTableType::user_table)] = user_table_count;
+
+  // OPTIONAL - check for end mark and appended changes
+  size_t file_length = 0;
+  if (archive.Read3dmEndMark(&file_length))
+  {
+    m_3dm_file_byte_count = file_length;
+    m_bHasAppendedChanges = archive.AtAppended3dmChanges();
+  }
+
+  return (0 == archive.CriticalErrorCount());
+}
+
+void MYONX_ModelMetadata::Reset()
+{
+  *this = MYONX_ModelMetadata();
+}
+
+unsigned int MYONX_ModelMetadata::Internal_TableIndex(MYON_3dmArchiveTableType table)
+{
+  const unsigned int bit = static_cast<unsigned int>(table);
+  for (unsigned int i = 0; i < MYONX_ModelMetadata::TableCount; i++)
+  {
+    if (bit == (1U << i))
+      return i;
+  }
+  return MYON_UNSET_UINT_INDEX;
+}
+
+unsigned int MYONX_ModelMetadata::TableRecordCount(MYON_3dmArchiveTableType table) const
+{
+  const unsigned int i = Internal_TableIndex(table);
+  return (i < MYONX_ModelMetadata::TableCount) ? m_table_record_count[i] : 0U;
+}
+
+const MYON_UnitSystem& MYONX_ModelMetadata::ModelUnitSystem() const
+{
+  return m_settings.m_ModelUnitsAndTolerances.m_unit_system;
+}
+
+const MYON_BoundingBox& MYONX_ModelMetadata::ModelGeometryBoundingBox() const
+{
+  return m_model_geometry_bbox;
+}
+
+bool MYONX_ModelMetadata::HasAppendedChanges() const
+{
+  return m_bHasAppendedChanges;
+}
+
+void MYONX_ModelMetadata::Dump(MYON_TextLog& dump) const
+{
+  dump.Print("Model metadata:\n");
+  dump.PushIndent();
+
+  dump.Print("3dm archive version: %d\n", m_3dm_file_version);
+  dump.Print("opennurbs version: %u\n", m_3dm_opennurbs_version);
+  dump.Print("File size: %llu bytes\n", (unsigned long long)m_3dm_file_byte_count);
+
+  const MYON_wString units = ModelUnitSystem().ToString();
+  dump.Print("Model units: %ls\n", static_cast<const wchar_t*>(units));
+
+  const MYON_BoundingBox& bbox = ModelGeometryBoundingBox();
+  if (bbox.IsValid())
+  {
+    dump.Print("Model geometry bounding box: ");
+    dump.Print(bbox.m_min);
+    dump.Print(" to ");
+    dump.Print(bbox.m_max);
+    dump.Print("\n");
+  }
+  else
+    dump.Print("Model geometry bounding box: not saved\n");
+
+  const MYON_WindowsBitmap& preview = m_properties.m_PreviewImage;
+  if (preview.IsEmpty())
+    dump.Print("Preview image: none\n");
+  else
+    dump.Print("Preview image: %d x %d\n", preview.Width(), preview.Height());
+
+  const struct
+  {
+    MYON_3dmArchiveTableType m_table;
+    const char* m_name;
+  } tables[] =
+  {
+    { MYON_3dmArchiveTableType::bitmap_table, "Bitmaps" },
+    { MYON_3dmArchiveTableType::texture_mapping_table, "Texture mappings" },
+    { MYON_3dmArchiveTableType::material_table, "Materials" },
+    { MYON_3dmArchiveTableType::linetype_table, "Linetypes" },
+    { MYON_3dmArchiveTableType::layer_table, "Layers" },
+    { MYON_3dmArchiveTableType::group_table, "Groups" },
+    { MYON_3dmArchiveTableType::text_style_table, "Text styles" },
+    { MYON_3dmArchiveTableType::dimension_style_table, "Dimension styles" },
+    { MYON_3dmArchiveTableType::light_table, "Lights" },
+    { MYON_3dmArchiveTableType::hatchpattern_table, "Hatch patterns" },
+    { MYON_3dmArchiveTableType::instance_definition_table, "Instance definitions" },
+    { MYON_3dmArchiveTableType::object_table, "Objects" },
+    { MYON_3dmArchiveTableType::historyrecord_table, "History records" },
+    { MYON_3dmArchiveTableType::user_table, "User tables" }
+  };
+  for (size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); i++)
+    dump.Print("%s: %u\n", tables[i].m_name, TableRecordCount(tables[i].m_table));
+
+  if (m_bHasAppendedChanges)
+    dump.Print("The file has appended changes that are not included in these counts.\n");
+
+  dump.PopIndent();
+}
+
 bool MYONX_Model::Write(const char* filename, int version, MYON_TextLog* error_log) const
 {
   bool rc = false;
@@ -3049,6 +4662,149 @@ bool MYONX_Model::Write(const wchar_t* filename, int version, MYON_TextLog* erro
 }
 
 bool MYONX_Model::Write(MYON_BinaryArchive& archive, int version, MYON_TextLog* error_log) const
+{
+  // Every model geometry component is written to the object table.
+  const bool bSaveModelGeometryBoundingBox = true;
+  if (!Internal_IncrementalWriteBegin(archive, version, bSaveModelGeometryBoundingBox, error_log))
+    return false;
+
+  unsigned int thread_count = MYONX_Model::WriteThreadCount();
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+
+  // OBJECT TABLE
+  bool ok = true;
+  const class MYONX_ModelComponentReferenceLink* link = Internal_ComponentListConst(MYON_ModelComponent::Type::ModelGeometry).m_first_mcr_link;
+  if (thread_count <= 1 || archive.Archive3dmVersion() < 3)
+  {
+    for ( /*empty init*/; nullptr != link; link = link->m_next)
+    {
+      if (!IncrementalWriteModelGeometry(archive, link->m_mcr, error_log))
+        ok = false;
+    }
+  }
+  else
+  {
+    // The object table is written in batches. The objects in a batch
+    // are serialized on thread_count threads and then the records are
+    // written to the archive in model order on the calling thread.
+    // The batch limits bound the memory used by serialized objects.
+    const size_t batch_size_limit = 64 * 1024 * 1024;
+    const int batch_count_limit = 4096;
+
+    MYON_SimpleArray< const MYONX_ModelComponentReferenceLink* > links(batch_count_limit);
+    MYON_SimpleArray< MYON_3dmEncodedObject* > records(batch_count_limit);
+
+    while (nullptr != link)
+    {
+      links.SetCount(0);
+      size_t batch_size = 0;
+      for ( /*empty init*/; nullptr != link && links.Count() < batch_count_limit && batch_size < batch_size_limit; link = link->m_next)
+      {
+        const MYON_ModelGeometryComponent* model_geometry = MYON_ModelGeometryComponent::Cast(link->m_mcr.ModelComponent());
+        const MYON_Geometry* geometry = (nullptr != model_geometry) ? model_geometry->Geometry(nullptr) : nullptr;
+        if (nullptr != geometry)
+          batch_size += geometry->SizeOf();
+        if (links.Count() == records.Count())
+          records.Append(new MYON_3dmEncodedObject());
+        links.Append(link);
+      }
+      const int batch_count = links.Count();
+
+      // parallel pass
+      const unsigned int worker_count
+        = (batch_count <= 1)
+        ? 0U
+        : (((unsigned int)batch_count < thread_count) ? (unsigned int)batch_count : thread_count) - 1U;
+      if (worker_count > 0)
+      {
+        std::atomic<int> next_record(0);
+        const MYON_BinaryArchive& target_archive = archive;
+        auto encode = [&]()
+        {
+          for (int i = next_record++; i < batch_count; i = next_record++)
+          {
+            const MYON_ModelGeometryComponent* model_geometry = MYON_ModelGeometryComponent::Cast(links[i]->m_mcr.ModelComponent());
+            const MYON_Geometry* geometry = (nullptr != model_geometry) ? model_geometry->Geometry(nullptr) : nullptr;
+            if (nullptr != geometry)
+              target_archive.Encode3dmObject(*geometry, *records[i]);
+          }
+        };
+        MYON_SimpleArray< std::thread* > workers(worker_count);
+        for (unsigned int i = 0; i < worker_count; i++)
+        {
+          try
+          {
+            workers.Append(new std::thread(encode));
+          }
+          catch (const std::system_error&)
+          {
+            // No more threads are available.
+            // The calling thread serializes the remaining objects.
+            break;
+          }
+        }
+        encode();
+        for (int i = 0; i < workers.Count(); i++)
+        {
+          workers[i]->join();
+          delete workers[i];
+        }
+      }
+
+      // write the records in model order
+      for (int i = 0; i < batch_count; i++)
+      {
+        const MYON_ModelGeometryComponent* model_geometry = MYON_ModelGeometryComponent::Cast(links[i]->m_mcr.ModelComponent());
+        const MYON_Geometry* geometry = (nullptr != model_geometry) ? model_geometry->Geometry(nullptr) : nullptr;
+        if (nullptr == geometry)
+        {
+          // IncrementalWriteModelGeometry() reports the error.
+          if (!IncrementalWriteModelGeometry(archive, links[i]->m_mcr, error_log))
+            ok = false;
+        }
+        else if (!archive.Write3dmObjectForExperts(*geometry, model_geometry->Attributes(nullptr), *records[i]))
+        {
+          if (error_log)
+            error_log->Print("MYONX_Model::Write archive.Write3dmObject() failed.\n");
+          ok = false;
+        }
+        records[i]->Destroy();
+      }
+    }
+
+    for (int i = 0; i < records.Count(); i++)
+      delete records[i];
+  }
+  if (!ok)
+  {
+    archive.EndWrite3dmObjectTable();
+    return false;
+  }
+
+  if (!IncrementalWriteFinish(archive, error_log))
+    return false;
+
+  // Changes can be appended to the archive.
+  m_private->ClearAppendBaseline();
+  m_private->SetAppendBaseline(archive.Archive3dmVersion(), archive.CurrentPosition());
+
+  return true;
+}
+
+bool MYONX_Model::IncrementalWriteBegin(MYON_BinaryArchive& archive, int version, MYON_TextLog* error_log) const
+{
+  // The objects written by IncrementalWriteModelGeometry() are not known
+  // when the settings are written, so no bounding box is saved.
+  return Internal_IncrementalWriteBegin(archive, version, false, error_log);
+}
+
+bool MYONX_Model::Internal_IncrementalWriteBegin(
+  MYON_BinaryArchive& archive, 
+  int version, 
+  bool bSaveModelGeometryBoundingBox, 
+  MYON_TextLog* error_log
+  ) const
 {
   m_private->UpdateRDKUserData(version);
 
@@ -3103,7 +4859,11 @@ bool MYONX_Model::Write(MYON_BinaryArchive& archive, int version, MYON_TextLog*
   }
 
   // SETTINGS SECTION
-  ok = archive.Write3dmSettings( m_settings );
+  // The geometry bounding box is saved with the settings so
+  // MYONX_ModelMetadata::Read() can get it without reading objects.
+  ok = bSaveModelGeometryBoundingBox
+    ? archive.Write3dmSettings( m_settings, ModelGeometryBoundingBox() )
+    : archive.Write3dmSettings( m_settings );
   if ( !ok )
   {
     // make sure m_settings is valid
@@ -3432,27 +5192,61 @@ bool MYONX_Model::Write(MYON_BinaryArchive& archive, int version, MYON_TextLog*
     if ( error_log) error_log->Print("MYONX_Model::Write archive.BeginWrite3dmObjectTable() failed.\n");
     return false;
   }
-  for( 
-    class MYONX_ModelComponentReferenceLink* link = Internal_ComponentListConst(MYON_ModelComponent::Type::ModelGeometry).m_first_mcr_link;
-    nullptr != link;
-    link = link->m_next
-    )
+
+  return true;
+}
+
+bool MYONX_Model::IncrementalWriteModelGeometry(
+  MYON_BinaryArchive& archive,
+  const MYON_Geometry& geometry,
+  const MYON_3dmObjectAttributes* attributes,
+  MYON_TextLog* error_log
+  ) const
+{
+  if (MYON_3dmArchiveTableType::object_table != archive.Active3dmTable())
   {
-    ok = archive.Write3dmModelGeometryComponent(link->m_mcr);
-    if ( !ok )
-    {
-      if ( error_log)
-        error_log->Print("MYONX_Model::Write archive.Write3dmModelGeometryComponent() failed.\n");
-    }
+    if ( error_log) error_log->Print("MYONX_Model::IncrementalWriteModelGeometry - IncrementalWriteBegin() was not called.\n");
+    return false;
+  }
+  const bool rc = archive.Write3dmObject(geometry, attributes);
+  if ( !rc )
+  {
+    if ( error_log)
+      error_log->Print("MYONX_Model::Write archive.Write3dmObject() failed.\n");
+  }
+  return rc;
+}
+
+bool MYONX_Model::IncrementalWriteModelGeometry(
+  MYON_BinaryArchive& archive,
+  const MYON_ModelComponentReference& model_geometry_reference,
+  MYON_TextLog* error_log
+  ) const
+{
+  if (MYON_3dmArchiveTableType::object_table != archive.Active3dmTable())
+  {
+    if ( error_log) error_log->Print("MYONX_Model::IncrementalWriteModelGeometry - IncrementalWriteBegin() was not called.\n");
+    return false;
+  }
+  const bool rc = archive.Write3dmModelGeometryComponent(model_geometry_reference);
+  if ( !rc )
+  {
+    if ( error_log)
+      error_log->Print("MYONX_Model::Write archive.Write3dmModelGeometryComponent() failed.\n");
   }
+  return rc;
+}
+
+bool MYONX_Model::IncrementalWriteFinish(MYON_BinaryArchive& archive, MYON_TextLog* error_log) const
+{
   if ( !archive.EndWrite3dmObjectTable() )
   {
     if ( error_log) 
       error_log->Print("MYONX_Model::Write archive.EndWrite3dmObjectTable() failed.\n");
     return false;
   }
-  if (!ok)
-    return false;
+
+  bool ok = true;
 
   // HISTORY RECORD TABLE
   if ( archive.Archive3dmVersion() >= 4 )
@@ -496,6 +496,224 @@ public:
     MYON_TextLog* error_log
     );
 
+  /*
+  Description:
+    Reads a single item from the model geometry table.
+
+  Parameters:
+    archive - [in]
+      MYONX_Model::IncrementalReadBegin() must have been called and
+      index.IsValidForArchive(archive) must have been true.
+    index_item - [in]
+      An item from an MYON_3dmObjectTableIndex created from this archive.
+      Items can be read in any order.
+    bManageModelGeometryComponent - [in]
+    bManageGeometry - [in]
+    bManageAttributes - [in]
+      See the other IncrementalReadModelGeometry() for details.
+    model_geometry_reference - [out]
+      A reference to the MYON_ModelGeometryComponent that was added to the model.
+      If the item was already read, the existing component is returned.
+  Returns:
+    True if successful.
+    False if the item could not be read or the item does not match the archive.
+  Remarks:
+    Call IncrementalReadSkipModelGeometry() before calling IncrementalReadFinish().
+  See Also:
+    MYON_3dmObjectTableIndex
+  */
+  bool IncrementalReadModelGeometry(
+    MYON_BinaryArchive& archive,
+    const class MYON_3dmObjectTableIndexItem* index_item,
+    bool bManageModelGeometryComponent,
+    bool bManageGeometry,
+    bool bManageAttributes,
+    MYON_ModelComponentReference& model_geometry_reference
+    );
+
+  /*
+  Description:
+    Skips the rest of the model geometry table so IncrementalReadFinish()
+    can be called.
+  Parameters:
+    archive - [in]
+    index - [in]
+      MYON_3dmObjectTableIndex created from this archive.
+  Returns:
+    True if successful.
+  */
+  bool IncrementalReadSkipModelGeometry(
+    MYON_BinaryArchive& archive,
+    const class MYON_3dmObjectTableIndex& index
+    );
+
+  /*
+  Description:
+    Set the maximum number of threads MYONX_Model::Read() uses to decode
+    the object table.
+  Parameters:
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: decode the object table on the calling thread (default).
+      > 1: use at most thread_count threads.
+  Remarks:
+    Points, curves, surfaces, breps, extrusions, meshes and SubDs are decoded
+    on worker threads and added to the model in the order they appear in the
+    archive. Every user data class attached to these objects, including
+    classes registered by plug-ins, must be able to read itself on any thread
+    at the same time as other objects are read. Only set a thread count other
+    than 1 when that is known to be true.
+    If worker threads cannot be created, the calling thread decodes the
+    object table.
+  */
+  static void SetReadThreadCount(
+    unsigned int thread_count
+    );
+
+  /*
+  Returns:
+    The value set by SetReadThreadCount().
+  */
+  static unsigned int ReadThreadCount();
+
+  /*
+  Description:
+    Set the maximum number of threads MYONX_Model::Write() uses to serialize
+    the object table.
+  Parameters:
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: serialize the object table on the calling thread (default).
+      > 1: use at most thread_count threads.
+  Remarks:
+    Points, curves, surfaces, breps, extrusions, meshes and SubDs are 
+    serialized on worker threads and written to the archive in model order.
+    Every user data class attached to these objects, including classes
+    registered by plug-ins, must be able to write itself on any thread at
+    the same time as other objects are written. Only set a thread count
+    other than 1 when that is known to be true.
+    If worker threads cannot be created, the calling thread serializes the
+    object table.
+  */
+  static void SetWriteThreadCount(
+    unsigned int thread_count
+    );
+
+  /*
+  Returns:
+    The value set by SetWriteThreadCount().
+  */
+  static unsigned int WriteThreadCount();
+
+  /*
+  Description:
+    Read a list of 3dm files into new models using a bounded set of 
+    worker threads.
+  Parameters:
+    file_names - [in]
+      full paths of the 3dm files to read.
+    models - [out]
+      models[i] is a new model read from file_names[i] or nullptr if
+      the file could not be read or reading was canceled before the file
+      was started. The caller must delete the models.
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: read the files on the calling thread.
+      > 1: use at most thread_count threads.
+    model_settings - [in]
+      nullptr or a model whose DeferGeometryReading() and 
+      ReferenceUnknownUserData() settings are used for every model.
+    progress_reporter - [in]
+      nullptr or a progress reporter. Progress is reported on the calling
+      thread as files are finished.
+    terminator - [in]
+      nullptr or a terminator. It is checked on the calling thread as files
+      are finished. After termination is requested, files that have not
+      been started are not read.
+    error_log - [out]
+      nullptr or a text log. Errors are logged in file order after all
+      files are read.
+  Returns:
+    Number of files that were read successfully.
+  Remarks:
+    Each worker thread reads one file at a time. The worker threads reuse
+    their zlib buffers from file to file. See 
+    MYON_BinaryArchive::BeginThreadCompressorReuseForExperts().
+    Every user data class in the files, including classes registered by 
+    plug-ins, must be able to read itself on any thread at the same time 
+    as other files are read. Only set a thread count other than 1 when 
+    that is known to be true.
+    If worker threads cannot be created, the calling thread reads the files.
+  */
+  static unsigned int ReadFiles(
+    const MYON_ClassArray< MYON_wString >& file_names,
+    MYON_SimpleArray< MYONX_Model* >& models,
+    unsigned int thread_count,
+    const MYONX_Model* model_settings,
+    MYON_ProgressReporter* progress_reporter,
+    MYON_Terminator* terminator,
+    MYON_TextLog* error_log
+    );
+
+  /*
+  Description:
+    Enable or disable deferred geometry reading. When it is enabled, 
+    the MYONX_Model::Read() functions that take a file name map the 
+    file into memory and points, curves, surfaces, breps, extrusions,
+    meshes and SubDs are not decoded while the file is read. Their 
+    attributes are read and the geometry is decoded the first time
+    MYON_ModelGeometryComponent::Geometry() or GeometryBoundingBox()
+    is called.
+  Parameters:
+    bDeferGeometryReading - [in]
+  Remarks:
+    This setting is not changed by Reset(). 
+    Reading from an MYON_BinaryArchive is never deferred.
+    The file stays mapped until all deferred geometry has been decoded or 
+    the model geometry components have been deleted.
+    Functions that use geometry or its bounding box, like 
+    ModelGeometryBoundingBox() and Write(), decode all deferred geometry.
+  See Also:
+    MYON_ModelGeometryComponent::GeometryIsDeferred()
+  */
+  void SetDeferGeometryReading(
+    bool bDeferGeometryReading
+    );
+
+  /*
+  Returns:
+    The value set by SetDeferGeometryReading(). The default is false.
+  */
+  bool DeferGeometryReading() const;
+
+  /*
+  Description:
+    Enable or disable referencing unknown user data. When it is enabled,
+    the MYONX_Model::Read() functions that take a file name map the file
+    into memory and user data whose class is not available is not copied.
+    Each item references its bytes in the mapped file and Write() copies
+    those bytes directly to the new archive.
+  Parameters:
+    bReferenceUnknownUserData - [in]
+  Remarks:
+    This setting is not changed by Reset().
+    The file stays mapped until all user data that references it has 
+    been deleted. Reading from an MYON_BinaryArchive never references 
+    unknown user data.
+  See Also:
+    MYON_UnknownUserDataReference
+    MYON_BinaryArchive::SetUnknownUserDataReferenceOwner()
+  */
+  void SetReferenceUnknownUserData(
+    bool bReferenceUnknownUserData
+    );
+
+  /*
+  Returns:
+    The value set by SetReferenceUnknownUserData(). The default is false.
+  */
+  bool ReferenceUnknownUserData() const;
+
   /*
   Description:
     Writes contents of this model to an openNURBS archive.
@@ -627,6 +845,226 @@ public:
     MYON_TextLog* error_log = nullptr
     ) const;
 
+  /*
+  Description:
+    Writes everything in this model up to the model geometry table and
+    begins the model geometry table.  Use IncrementalWriteBegin(),
+    IncrementalWriteModelGeometry() and IncrementalWriteFinish() when
+    the model geometry is too large to keep in an MYONX_Model.
+
+  Parameters:
+    archive - [in]
+      archive to write to
+    version - [in]
+      Version of the openNURBS archive to write.
+      See MYONX_Model::Write() for details.
+    error_log - [out]
+      any archive writing errors are logged here.
+
+  Returns:
+    True if everything before the model geometry table was written
+    and the model geometry table was begun.
+
+  Remarks:
+    The settings, layers, materials, instance definitions and other
+    components referenced by the model geometry must be added to this
+    model before IncrementalWriteBegin() is called.
+    Model geometry already in this model is not written by
+    IncrementalWriteBegin(). Pass it to IncrementalWriteModelGeometry()
+    if it should be saved.
+
+  Example:
+
+            MYONX_Model model;
+            ... // add layers, materials, instance definitions, ...
+            MYON_BinaryFile archive( MYON::archive_mode::write3dm, fp );
+            bool ok = model.IncrementalWriteBegin( archive, 0, error_log );
+            while ( ok && ... )
+            {
+              MYON_Mesh* mesh = ...;
+              MYON_3dmObjectAttributes attributes;
+              ...
+              ok = model.IncrementalWriteModelGeometry( archive, *mesh, &attributes, error_log );
+              delete mesh; // mesh is in the archive and no longer needed
+            }
+            ok = model.IncrementalWriteFinish( archive, error_log ) && ok;
+  */
+  bool IncrementalWriteBegin(
+    MYON_BinaryArchive& archive,
+    int version,
+    MYON_TextLog* error_log
+    ) const;
+
+  /*
+  Description:
+    Writes a single item to the model geometry table.
+
+  Parameters:
+    archive - [in]
+      MYONX_Model::IncrementalWriteBegin() must have been called.
+    geometry - [in]
+    attributes - [in]
+      optional object attributes. Layer, material and other indices
+      must refer to components in this model.
+    error_log - [out]
+      any archive writing errors are logged here.
+
+  Returns:
+    True if the item was written.
+
+  Remarks:
+    The geometry and attributes are serialized before this function
+    returns and the caller may delete them immediately. Nothing is
+    added to this model.
+  */
+  bool IncrementalWriteModelGeometry(
+    MYON_BinaryArchive& archive,
+    const MYON_Geometry& geometry,
+    const MYON_3dmObjectAttributes* attributes,
+    MYON_TextLog* error_log
+    ) const;
+
+  bool IncrementalWriteModelGeometry(
+    MYON_BinaryArchive& archive,
+    const MYON_ModelComponentReference& model_geometry_reference,
+    MYON_TextLog* error_log
+    ) const;
+
+  /*
+  Description:
+    Ends the model geometry table and writes everything in this model
+    that follows it.
+
+  Parameters:
+    archive - [in]
+      MYONX_Model::IncrementalWriteBegin() must have been called.
+    error_log - [out]
+      any archive writing errors are logged here.
+
+  Returns:
+    True if the rest of the archive and the end mark were written.
+  */
+  bool IncrementalWriteFinish(
+    MYON_BinaryArchive& archive,
+    MYON_TextLog* error_log
+    ) const;
+
+  /*
+  Description:
+    Appends the components that were added, modified or deleted since
+    this model was last read from or written to filename to the end of
+    the file. The time it takes is proportional to the size of the
+    changes, not to the size of the model.
+
+  Parameters:
+    filename - [in]
+      The file this model was last read from or written to.
+    error_log - [out]
+      any archive writing errors are logged here.
+
+  Returns:
+    True if the changes were appended or there were no changes.
+    False if the model was not completely read from or written to a
+    file, if the file was changed by something else, or if an error 
+    occurred. Call Write() when false is returned.
+
+  Remarks:
+    Images, texture mappings, materials, line patterns, layers, groups,
+    dimension styles, lights, hatch patterns, instance definitions,
+    model geometry and history records are appended. Changes to 
+    settings, properties, user tables, render content, embedded files
+    and post effects are saved by Write().
+
+    The changes are saved after the end mark of the file. MYONX_Model::Read()
+    replays them when the file is read. Each section is completely read
+    before any of its changes are applied. When a section cannot be read,
+    the model has the changes in the sections before it and Read() 
+    returns false. Applications built with an earlier version of opennurbs
+    stop at the first end mark and read the model as it was before the 
+    changes were appended.
+
+    Components are compared using their runtime serial number and 
+    content version number. Call MarkComponentChanged() after modifying
+    geometry or attributes in place.
+
+    Call CompactAppendedChanges() to rewrite the file without the 
+    appended sections.
+  */
+  bool AppendChanges(
+    const wchar_t* filename,
+    MYON_TextLog* error_log = nullptr
+    ) const;
+
+  bool AppendChanges(
+    const char* filename,
+    MYON_TextLog* error_log = nullptr
+    ) const;
+
+  /*
+  Description:
+    Mark a component so the next AppendChanges() saves it. 
+  Parameters:
+    component_id - [in]
+      Id of a component that was modified in a way that does not 
+      change its content version number, like editing the geometry
+      or attributes of a model geometry component in place.
+  */
+  void MarkComponentChanged(
+    MYON_UUID component_id
+    );
+
+  /*
+  Returns:
+    Number of change sections appended to the file this model was last
+    read from or written to.
+  */
+  unsigned int AppendedChangesCount() const;
+
+  /*
+  Description:
+    Rewrites filename with the current contents of this model and no
+    appended change sections.
+  Parameters:
+    filename - [in]
+      The file this model was last read from or written to.
+    error_log - [out]
+      any archive writing errors are logged here.
+  Returns:
+    True if the file was written.
+  Remarks:
+    The file is written with the 3dm version it was read with.
+  */
+  bool CompactAppendedChanges(
+    const wchar_t* filename,
+    MYON_TextLog* error_log = nullptr
+    ) const;
+
+  bool CompactAppendedChanges(
+    const char* filename,
+    MYON_TextLog* error_log = nullptr
+    ) const;
+
+  /*
+  Description:
+    Create an immutable snapshot of this model.
+  Returns:
+    A model that references the same components as this model and
+    can be read from multiple threads at the same time.
+  Remarks:
+    Creating a snapshot copies the component lists and manifest
+    but not the components. Adding or removing components from this
+    model after the snapshot is created does not change the snapshot.
+    Components modified in place are seen by the snapshot, so while
+    readers are using snapshots, change a component by removing it 
+    and adding a modified copy.
+
+    The const functions of the snapshot, including component iterators,
+    component searches by id, index, name and runtime serial number,
+    the Manifest() searches and the bounding box functions, may be called 
+    from multiple threads at the same time.
+  */
+  std::shared_ptr<const MYONX_Model> CreateSnapshot() const;
+
   /////////////////////////////////////////////////////////////////////
   //
   // BEGIN model definitions
@@ -1389,6 +1827,14 @@ private:
   void Internal_RemoveModelComponentReferenceLink(
     class MYONX_ModelComponentReferenceLink* mcr_link
     );
+  // When bSaveModelGeometryBoundingBox is true, the model's geometry
+  // is the entire object table and its bounding box is saved.
+  bool Internal_IncrementalWriteBegin(
+    MYON_BinaryArchive& archive,
+    int version,
+    bool bSaveModelGeometryBoundingBox,
+    MYON_TextLog* error_log
+    ) const;
   // A map used to lookup by serial number.
   MYON_SerialNumberMap m_mcr_sn_map;
   MYON_FixedSizePool m_mcr_link_fsp;
@@ -1625,6 +2071,125 @@ private:
   class MYON_DocumentUserStringList* m_model_user_string_list = nullptr;
 };
 
+/*
+Description:
+  MYONX_ModelMetadata gets the information a file browser or asset
+  indexer needs from a 3dm archive without reading the model.
+  The start section, properties (including the preview image) and
+  settings (including the unit system) are read. The remaining
+  tables are skipped by seeking past their records, so geometry and
+  other table records are never decoded.
+*/
+class MYON_CLASS MYONX_ModelMetadata
+{
+public:
+  MYONX_ModelMetadata() = default;
+  ~MYONX_ModelMetadata() = default;
+  MYONX_ModelMetadata(const MYONX_ModelMetadata&) = default;
+  MYONX_ModelMetadata& operator=(const MYONX_ModelMetadata&) = default;
+
+  /*
+  Description:
+    Reads the metadata from a 3dm archive.
+  Parameters:
+    filename - [in]
+    archive - [in]
+      The archive must be positioned at the start of the 3dm archive.
+    error_log - [out]
+      any archive reading errors are logged here.
+  Returns:
+    True if the start section, properties and settings were read and
+    every table was skipped. When false is returned, the information
+    read before the error is kept.
+  Remarks:
+    Table record counts are not available for version 1 archives.
+  */
+  bool Read(
+    const char* filename,
+    MYON_TextLog* error_log
+    );
+
+  bool Read(
+    const wchar_t* filename,
+    MYON_TextLog* error_log
+    );
+
+  bool Read(
+    MYON_BinaryArchive& archive,
+    MYON_TextLog* error_log
+    );
+
+  void Reset();
+
+  void Dump(
+    MYON_TextLog& dump
+    ) const;
+
+  /*
+  Parameters:
+    table - [in]
+      A table from bitmap_table to user_table.
+  Returns:
+    Number of records in the table. For the user_table,
+    the number of user tables is returned.
+  */
+  unsigned int TableRecordCount(
+    MYON_3dmArchiveTableType table
+    ) const;
+
+  /*
+  Returns:
+    The model unit system saved in m_settings.
+  */
+  const MYON_UnitSystem& ModelUnitSystem() const;
+
+  /*
+  Returns:
+    The model geometry bounding box saved by MYONX_Model::Write().
+    Files written with MYONX_Model::IncrementalWriteBegin() or by
+    other applications do not save this bounding box and an unset
+    bounding box is returned.
+  Remarks:
+    When HasAppendedChanges() is true, the bounding box does not
+    include the changes appended to the file.
+  */
+  const MYON_BoundingBox& ModelGeometryBoundingBox() const;
+
+  /*
+  Returns:
+    True if MYONX_Model::AppendChanges() saved changes after the end of
+    the archive. The table record counts do not include those changes.
+  */
+  bool HasAppendedChanges() const;
+
+public:
+  // 3dm archive version and the version of opennurbs that wrote it
+  int m_3dm_file_version = 0;
+  unsigned int m_3dm_opennurbs_version = 0;
+
+  // number of bytes in the archive saved in the end mark
+  MYON__UINT64 m_3dm_file_byte_count = 0;
+
+  MYON_String m_sStartSectionComments;
+
+  // properties include the preview image
+  MYON_3dmProperties m_properties;
+
+  // settings include the units and tolerances
+  MYON_3dmSettings m_settings;
+
+private:
+  static unsigned int Internal_TableIndex(MYON_3dmArchiveTableType table);
+
+  enum : unsigned int
+  {
+    TableCount = 18
+  };
+  unsigned int m_table_record_count[TableCount] = {};
+  MYON_BoundingBox m_model_geometry_bbox = MYON_BoundingBox::UnsetBoundingBox;
+  bool m_bHasAppendedChanges = false;
+};
+
 class MYON_CLASS MYONX_ModelComponentIterator
 {
 public:
@@ -129,14 +129,18 @@ void MYON_Hash32Table::Internal_AdjustTableCapacity(
   MYON__UINT32 item_count
   )
 {
-  const MYON__UINT32 max_capacity = 256 * 1024;
-  const MYON__UINT32 target_list_length = 8;
+  // Tables with millions of items (large model manifests) need enough
+  // capacity to keep the lists short.
+  const MYON__UINT32 max_capacity = 4 * 1024 * 1024;
+  const MYON__UINT32 target_list_length = 4;
   if (m_hash_table_capacity < max_capacity && item_count/target_list_length >= m_hash_table_capacity)
   {
     MYON__UINT32 hash_table_capacity = m_hash_table_capacity;
     if (hash_table_capacity < 64)
       hash_table_capacity = 64;
-    while (hash_table_capacity < max_capacity && item_count/target_list_length > hash_table_capacity)
+    // The capacity must increase, otherwise the table would be
+    // rebuilt with the same capacity on every call.
+    while (hash_table_capacity < max_capacity && item_count/target_list_length >= hash_table_capacity)
       hash_table_capacity *= 2;
 
     size_t sizeof_hash_table = hash_table_capacity*sizeof(m_hash_table[0]);
@@ -248,6 +252,14 @@ bool MYON_Hash32Table::RemoveItem(
   return false;
 }
 
+void MYON_Hash32Table::ReserveItemCapacity(
+  unsigned int item_count
+  )
+{
+  if ( item_count > m_item_count )
+    Internal_AdjustTableCapacity(item_count);
+}
+
 unsigned int MYON_Hash32Table::RemoveAllItems()
 {
   const unsigned int removed_item_count = m_item_count;
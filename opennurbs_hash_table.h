@@ -179,6 +179,20 @@ public:
   */
   unsigned int ItemCount() const;
 
+  /*
+  Description:
+    Size the hash table for item_count items so adding items does not 
+    rehash the table until the item count exceeds item_count.
+  Parameters:
+    item_count - [in]
+      Expected number of items.
+  Remarks:
+    Use when a large number of items will be added at once.
+  */
+  void ReserveItemCapacity(
+    unsigned int item_count
+    );
+
   bool IsValid() const;
 
 private:
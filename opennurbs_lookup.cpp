@@ -813,12 +813,113 @@ struct MYON_SerialNumberMap::SN_ELEMENT* MYON_SerialNumberMap::LastElement() con
   return e;
 }
 
+struct MYON_SerialNumberMap::SN_ELEMENT* MYON_SerialNumberMap::Internal_FindElementReadOnly(
+  MYON__UINT64 sn,
+  bool& bMapIsTidy
+  ) const
+{
+  bMapIsTidy = true;
+
+  if ( m_maxsn < sn || sn <= 0 )
+    return 0;
+
+  if ( sn <= m_sn_block0.m_sn1 && m_sn_block0.m_sn0 <= sn )
+  {
+    if ( !m_sn_block0.m_sorted || m_sn_block0.NeedsToBeCulled() )
+    {
+      bMapIsTidy = false;
+      return 0;
+    }
+    SN_ELEMENT* e = m_sn_block0.BinarySearchBlockHelper(sn);
+    if (e)
+      return e;
+  }
+
+  size_t i = (size_t)m_snblk_list_count;
+  class MYON_SN_BLOCK* const* eblk_array = m_snblk_list;
+  while (i > 0)
+  {
+    size_t j = i/2;
+    class MYON_SN_BLOCK* eblk = eblk_array[j];
+    if ( eblk->NeedsToBeCulled() )
+    {
+      bMapIsTidy = false;
+      return 0;
+    }
+    if ( sn < eblk->m_sn0 )
+    {
+      i = j;
+    }
+    else if ( sn > eblk->m_sn1 )
+    {
+      j++;
+      eblk_array += j;
+      i -= j;
+    }
+    else
+    {
+      return eblk->BinarySearchBlockHelper(sn);
+    }
+  }
+
+  return 0;
+}
+
 struct MYON_SerialNumberMap::SN_ELEMENT* MYON_SerialNumberMap::FindSerialNumber(MYON__UINT64 sn) const
 {
-  struct SN_ELEMENT* e = const_cast<MYON_SerialNumberMap*>(this)->FindElementHelper(sn);
+  // Searching a tidy map does not modify it, which permits
+  // concurrent readers after PrepareForConcurrentReaders() is called.
+  bool bMapIsTidy = true;
+  struct SN_ELEMENT* e = Internal_FindElementReadOnly(sn, bMapIsTidy);
+  if ( false == bMapIsTidy )
+    e = const_cast<MYON_SerialNumberMap*>(this)->FindElementHelper(sn);
   return ( (e && e->m_sn_active) ? e : 0);
 }
 
+void MYON_SerialNumberMap::PrepareForConcurrentReaders()
+{
+  if ( m_sn_block0.m_count > 0 && (!m_sn_block0.m_sorted || m_sn_block0.NeedsToBeCulled()) )
+  {
+    // memory location for specific elements will be changed.
+    // This will make the hash table invalid.
+    Internal_HashTableInvalidate();
+    if ( m_sn_block0.m_purged > 0 )
+    {
+      m_sn_count -= m_sn_block0.m_purged;
+      m_sn_purged -= m_sn_block0.m_purged;
+      m_sn_block0.CullBlockHelper();
+    }
+    if ( !m_sn_block0.m_sorted && m_sn_block0.m_count > 0 )
+      m_sn_block0.SortBlockHelper();
+  }
+
+  for ( MYON__UINT64 i = 0; i < m_snblk_list_count; /*empty iterator*/ )
+  {
+    class MYON_SN_BLOCK* eblk = m_snblk_list[i];
+    if ( eblk->NeedsToBeCulled() )
+    {
+      Internal_HashTableInvalidate();
+      m_sn_count -= eblk->m_purged;
+      m_sn_purged -= eblk->m_purged;
+      eblk->CullBlockHelper();
+      if ( 0 == eblk->m_count )
+      {
+        // put empty block at the end of the list
+        for ( MYON__UINT64 j = i+1; j < m_snblk_list_count; j++ )
+          m_snblk_list[j-1] = m_snblk_list[j];
+        m_snblk_list_count--;
+        m_snblk_list[m_snblk_list_count] = eblk;
+        continue;
+      }
+    }
+    i++;
+  }
+  UpdateMaxSNHelper();
+
+  if ( m_active_id_count > 0 && 0 == m_bHashTableIsValid )
+    Internal_HashTableBuild();
+}
+
 struct MYON_SerialNumberMap::SN_ELEMENT* MYON_SerialNumberMap::FindId(MYON_UUID id) const
 {
   if ( m_active_id_count > 0 && IdIsNotNil(&id) && IdIsNotEqual(&id,&m_inactive_id) )
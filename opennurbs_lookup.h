@@ -326,6 +326,19 @@ public:
   */
   void EmptyList();
 
+  /*
+  Description:
+    Sorts and culls every serial number block and builds the id
+    hash table.
+  Remarks:
+    FindSerialNumber() and FindId() may tidy the map while they search.
+    After calling PrepareForConcurrentReaders(), and until the map is
+    modified, FindSerialNumber(), FindId(), FirstElement() and 
+    LastElement() do not modify the map and may be called from 
+    multiple threads at the same time.
+  */
+  void PrepareForConcurrentReaders();
+
   /*
   Description:
     Returns true if the map is valid.  Returns false if the
@@ -378,6 +391,11 @@ private:
 
 private:
   struct SN_ELEMENT* FindElementHelper(MYON__UINT64 sn);
+
+  // Searches without modifying the map. If a block that must be
+  // searched needs to be sorted or culled, bMapIsTidy is set to false
+  // and nullptr is returned.
+  struct SN_ELEMENT* Internal_FindElementReadOnly(MYON__UINT64 sn, bool& bMapIsTidy) const;
   void UpdateMaxSNHelper();
   void GarbageCollectHelper();
   MYON__UINT64 GarbageCollectMoveHelper(MYON_SN_BLOCK* dst,MYON_SN_BLOCK* src);
@@ -490,6 +490,11 @@ unsigned int MYON_Mesh::SizeOf() const
     sz += sizeof(*m_partition);
     sz += m_partition->m_part.SizeOfArray();
   }
+  if (nullptr != m_mesh_tree)
+  {
+    sz += sizeof(*m_mesh_tree);
+    sz += (unsigned int)m_mesh_tree->SizeOf();
+  }
   return sz;
 }
 
@@ -1554,6 +1559,275 @@ void MYON_Mesh::Dump( MYON_TextLog& dump ) const
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+//
+// MYON_MeshCompactFaceArray saves m_F[] in the compact format enabled by
+// MYON_BinaryArchive::SetCompactMeshFaces().
+//
+// Each face is saved as four codes, one per MYON_MeshFace.vi[] element.
+// A code refers to one of the 16 most recently used vertices, the next
+// unused vertex index, a zig-zag varint difference from the previous
+// vertex index, or (for vi[3]) repeats vi[2] of a triangle. The code and
+// difference streams are saved as separate compressed buffers.
+//
+
+class MYON_MeshCompactFaceArray
+{
+public:
+  /*
+  Description:
+    Writes the face array header int (0) and the compact face chunk.
+  */
+  static bool Write(
+    const MYON_Mesh& mesh,
+    unsigned int fcount,
+    MYON_BinaryArchive& file
+    );
+
+  /*
+  Description:
+    Reads the compact face chunk saved by Write(). The header int has
+    already been read.
+  */
+  static bool Read(
+    MYON_Mesh& mesh,
+    unsigned int fcount,
+    MYON_BinaryArchive& file
+    );
+
+private:
+  enum : unsigned char
+  {
+    // 0 to 15 = index into the recent vertex queue
+    RecentVertexCount = 16,
+    NextVertexCode = 16,
+    DeltaVertexCode = 17,
+    TriangleCode = 18
+  };
+
+  // Recently used vertex indices. The newest vertex is at recent[(head-1)&15].
+  class RecentVertices
+  {
+  public:
+    unsigned int Find(unsigned int vi) const
+    {
+      for (unsigned int k = 0; k < RecentVertexCount; k++)
+      {
+        if (vi == m_vi[(m_head - 1U - k) & (RecentVertexCount - 1U)])
+          return k;
+      }
+      return RecentVertexCount;
+    }
+
+    unsigned int Get(unsigned int k) const
+    {
+      return m_vi[(m_head - 1U - k) & (RecentVertexCount - 1U)];
+    }
+
+    void Push(unsigned int vi)
+    {
+      m_vi[m_head & (RecentVertexCount - 1U)] = vi;
+      m_head++;
+    }
+
+  private:
+    unsigned int m_vi[RecentVertexCount] = {
+      MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX,
+      MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX,
+      MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX,
+      MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX, MYON_UNSET_UINT_INDEX
+    };
+    unsigned int m_head = 0;
+  };
+};
+
+bool MYON_MeshCompactFaceArray::Write(
+  const MYON_Mesh& mesh,
+  unsigned int fcount,
+  MYON_BinaryArchive& file
+  )
+{
+  if (fcount > mesh.m_F.UnsignedCount())
+    return false;
+
+  MYON_SimpleArray<unsigned char> codes(4 * fcount);
+  MYON_SimpleArray<unsigned char> deltas(fcount);
+  RecentVertices recent;
+  unsigned int next_vi = 0;
+  unsigned int prev_vi = 0;
+
+  for (unsigned int fi = 0; fi < fcount; fi++)
+  {
+    const unsigned int* fvi = (const unsigned int*)mesh.m_F[fi].vi;
+    for (unsigned int j = 0; j < 4; j++)
+    {
+      const unsigned int vi = fvi[j];
+      if (3 == j && vi == fvi[2])
+      {
+        codes.Append(TriangleCode);
+        continue;
+      }
+      const unsigned int k = recent.Find(vi);
+      if (k < RecentVertexCount)
+      {
+        codes.Append((unsigned char)k);
+      }
+      else
+      {
+        if (vi == next_vi)
+        {
+          codes.Append(NextVertexCode);
+        }
+        else
+        {
+          codes.Append(DeltaVertexCode);
+          const MYON__INT32 d = (MYON__INT32)(vi - prev_vi);
+          MYON__UINT32 z = (((MYON__UINT32)d) << 1) ^ ((MYON__UINT32)(d >> 31));
+          while (z >= 0x80U)
+          {
+            deltas.Append((unsigned char)(z | 0x80U));
+            z >>= 7;
+          }
+          deltas.Append((unsigned char)z);
+        }
+        recent.Push(vi);
+      }
+      if (vi >= next_vi)
+        next_vi = vi + 1;
+      prev_vi = vi;
+    }
+  }
+
+  bool rc = file.WriteInt(0); // i_size 0 = compact face array
+  if (rc) rc = file.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK, 1, 0);
+  if (rc)
+  {
+    rc = file.WriteCompressedBuffer(codes.UnsignedCount(), codes.Array());
+    if (rc) rc = file.WriteCompressedBuffer(deltas.UnsignedCount(), deltas.Array());
+    if (!file.EndWrite3dmChunk())
+      rc = false;
+  }
+  return rc;
+}
+
+bool MYON_MeshCompactFaceArray::Read(
+  MYON_Mesh& mesh,
+  unsigned int fcount,
+  MYON_BinaryArchive& file
+  )
+{
+  int major_version = 0;
+  int minor_version = 0;
+  if (!file.BeginRead3dmChunk(TCODE_ANONYMOUS_CHUNK, &major_version, &minor_version))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    if (1 != major_version)
+      break;
+
+    size_t sizeof_codes = 0;
+    if (!file.ReadCompressedBufferSize(&sizeof_codes))
+      break;
+    if (sizeof_codes != 4 * ((size_t)fcount))
+    {
+      MYON_ERROR("MYON_Mesh::Read - compact face array code count is wrong.");
+      break;
+    }
+    MYON_SimpleArray<unsigned char> codes((int)sizeof_codes);
+    bool bFailedCRC = false;
+    if (sizeof_codes > 0 && !file.ReadCompressedBuffer(sizeof_codes, codes.Array(), &bFailedCRC))
+      break;
+
+    size_t sizeof_deltas = 0;
+    if (!file.ReadCompressedBufferSize(&sizeof_deltas))
+      break;
+    MYON_SimpleArray<unsigned char> deltas((int)sizeof_deltas);
+    if (sizeof_deltas > 0 && !file.ReadCompressedBuffer(sizeof_deltas, deltas.Array(), &bFailedCRC))
+      break;
+
+    mesh.m_F.SetCapacity(fcount);
+    mesh.m_F.SetCount(fcount);
+
+    const unsigned char* code = codes.Array();
+    const unsigned char* delta = deltas.Array();
+    const unsigned char* delta_end = delta + sizeof_deltas;
+    RecentVertices recent;
+    unsigned int next_vi = 0;
+    unsigned int prev_vi = 0;
+    bool bValid = true;
+    for (unsigned int fi = 0; fi < fcount && bValid; fi++)
+    {
+      unsigned int* fvi = (unsigned int*)mesh.m_F[fi].vi;
+      for (unsigned int j = 0; j < 4; j++)
+      {
+        const unsigned char c = *code++;
+        unsigned int vi;
+        if (c < RecentVertexCount)
+        {
+          vi = recent.Get(c);
+        }
+        else if (NextVertexCode == c)
+        {
+          vi = next_vi;
+          recent.Push(vi);
+        }
+        else if (DeltaVertexCode == c)
+        {
+          MYON__UINT32 z = 0;
+          unsigned int shift = 0;
+          for (;;)
+          {
+            if (delta >= delta_end || shift > 28)
+            {
+              bValid = false;
+              break;
+            }
+            const unsigned char b = *delta++;
+            z |= ((MYON__UINT32)(b & 0x7FU)) << shift;
+            if (0 == (b & 0x80U))
+              break;
+            shift += 7;
+          }
+          if (!bValid)
+            break;
+          vi = prev_vi + ((z >> 1) ^ (0U - (z & 1U)));
+          recent.Push(vi);
+        }
+        else if (TriangleCode == c && 3 == j)
+        {
+          vi = fvi[2];
+        }
+        else
+        {
+          bValid = false;
+          break;
+        }
+        fvi[j] = vi;
+        if (vi >= next_vi)
+          next_vi = vi + 1;
+        prev_vi = vi;
+      }
+    }
+
+    if (!bValid)
+    {
+      MYON_ERROR("MYON_Mesh::Read - compact face array is not valid.");
+      mesh.m_F.SetCount(0);
+      break;
+    }
+
+    rc = true;
+    break;
+  }
+
+  if (!file.EndRead3dmChunk())
+    rc = false;
+
+  return rc;
+}
+
 bool MYON_Mesh::WriteFaceArray( int vcount, int fcount, MYON_BinaryArchive& file ) const
 {
   unsigned char  cvi[4];
@@ -1640,6 +1914,9 @@ bool MYON_Mesh::ReadFaceArray( int vcount, int fcount, MYON_BinaryArchive& file
       rc = file.ReadInt( 4, m_F[i].vi );
     }
     break;
+  case 0:
+    // See MYON_BinaryArchive::SetCompactMeshFaces()
+    return MYON_MeshCompactFaceArray::Read(*this, (unsigned int)fcount, file);
   }
   m_F.SetCount(i);
 
@@ -1955,29 +2232,545 @@ bool WriteMeshDoublePrecisionVertices(
 
   bool rc = false;
 
-  for (;;)
-  {
-    const unsigned int dVcount = dV.UnsignedCount();
-    if (!file.WriteInt(dVcount))
+  for (;;)
+  {
+    const unsigned int dVcount = dV.UnsignedCount();
+    if (!file.WriteInt(dVcount))
+      break;
+    if (0 == dVcount)
+    {
+      rc = true;
+      break;
+    }
+
+    const MYON::endian e = file.Endian();
+    if (e == MYON::endian::big_endian)
+    {
+      file.ToggleByteOrder(dVcount * 3, 8, dV.Array(), (void*)dV.Array());
+    }
+    if (!file.WriteCompressedBuffer(dVcount*sizeof(MYON_3dPoint), dV.Array()))
+      break;
+    if (e == MYON::endian::big_endian)
+    {
+      file.ToggleByteOrder(dVcount * 3, 8, dV.Array(), (void*)dV.Array());
+    }
+
+    rc = true;
+    break;
+  }
+
+  if ( !file.EndWrite3dmChunk() )
+    rc = false;
+
+  return rc;
+}
+
+static
+bool ReadMeshDoublePrecisionVertices( 
+  MYON_BinaryArchive& file, 
+  MYON_SimpleArray<MYON_3dPoint>& dV 
+  )
+{
+  dV.SetCount(0);
+
+  int major_version = 0;
+  int minor_version = 0;
+  if ( !file.BeginRead3dmChunk(TCODE_ANONYMOUS_CHUNK,&major_version,&minor_version) )
+    return false;
+
+  bool rc = false;
+  for(;;)
+  {
+    if (1 != major_version)
+      break;
+
+    unsigned int dVcount = 0;
+    if (!file.ReadInt(&dVcount))
+      break;
+
+    if (0 == dVcount)
+    {
+      rc = true;
+      break;
+    }
+
+    size_t sz = 0;
+    if (!file.ReadCompressedBufferSize( &sz ))
+      break;
+
+    if (sz != ((size_t)dVcount)*sizeof(MYON_3dPoint))
+    {
+      MYON_ERROR("Compressed double precision vertex point buffer size is wrong.");
+      break;
+    }
+
+    dV.SetCapacity(dVcount);
+    dV.SetCount(dVcount);
+    MYON_3dPoint* a = dV.Array();
+    if (nullptr == a || dVcount != dV.UnsignedCount())
+    {
+      MYON_ERROR("Unable to allocate double precision vertex point array.");
+      break;
+    }
+    
+    bool bFailedCRC = 0;
+    if (!file.ReadCompressedBuffer( sz, a, &bFailedCRC))
+      break;
+
+    rc = true;
+    break;
+  }
+
+  if (!rc)
+    dV.SetCount(0);
+  if ( !file.EndRead3dmChunk() )
+    rc = false;
+
+  return rc;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// MYON_MeshCompactVertexArrays saves m_V[], m_N[] and m_T[] in the compact
+// format enabled by MYON_BinaryArchive::SetMeshQuantizationTolerance().
+//
+// Vertex locations are quantized to the vertex bounding box with 16 or 21
+// bits per coordinate and saved as zig-zag encoded differences between
+// consecutive vertices. Unit normals are octahedron encoded with 16 bits
+// per component. Texture coordinates are saved as half floats. Each array
+// that cannot be compacted within its bound is saved with full precision.
+//
+
+template <class T>
+static bool Internal_WriteCompactMeshArray(
+  MYON_BinaryArchive& file,
+  const MYON_SimpleArray<T>& a,
+  unsigned int count,
+  unsigned int sizeof_value
+  )
+{
+  // count is 0 or a.UnsignedCount()
+  // sizeof_value is the size of the scalars in T (2, 4 or 8 bytes)
+  const size_t sizeof_buffer = ((size_t)count)*sizeof(T);
+  if (MYON::endian::big_endian == file.Endian() && sizeof_buffer > 0)
+  {
+    // 3dm archives are always in little endian byte order.
+    MYON_SimpleArray<T> tmp(count);
+    tmp.Append(count, a.Array());
+    file.ToggleByteOrder((int)(sizeof_buffer/sizeof_value), sizeof_value, tmp.Array(), (void*)tmp.Array());
+    return file.WriteCompressedBuffer(sizeof_buffer, tmp.Array());
+  }
+  return file.WriteCompressedBuffer(sizeof_buffer, a.Array());
+}
+
+template <class T>
+static bool Internal_ReadCompactMeshArray(
+  MYON_BinaryArchive& file,
+  unsigned int count,
+  unsigned int sizeof_value,
+  MYON_SimpleArray<T>& a
+  )
+{
+  // The saved array is empty or has count elements.
+  a.SetCount(0);
+  size_t sizeof_buffer = 0;
+  if (!file.ReadCompressedBufferSize(&sizeof_buffer))
+    return false;
+  if (0 == sizeof_buffer)
+    return true;
+  if (sizeof_buffer != ((size_t)count)*sizeof(T))
+  {
+    MYON_ERROR("MYON_Mesh::Read - compact vertex array buffer size is wrong.");
+    return false;
+  }
+  a.SetCapacity(count);
+  if (nullptr == a.Array())
+    return false;
+  bool bFailedCRC = false;
+  if (!file.ReadCompressedBuffer(sizeof_buffer, a.Array(), &bFailedCRC))
+    return false;
+  a.SetCount(count);
+  if (MYON::endian::big_endian == file.Endian())
+    file.ToggleByteOrder((int)(sizeof_buffer/sizeof_value), sizeof_value, a.Array(), (void*)a.Array());
+  return true;
+}
+
+static MYON__UINT16 Internal_FloatToHalf(float f)
+{
+  // IEEE 754 binary16 with round to nearest even.
+  MYON__UINT32 x = 0;
+  memcpy(&x, &f, sizeof(x));
+  const MYON__UINT32 sign = (x >> 16) & 0x8000U;
+  const MYON__UINT32 exponent = (x >> 23) & 0xFFU;
+  MYON__UINT32 mantissa = x & 0x7FFFFFU;
+
+  if (0xFFU == exponent)
+    return (MYON__UINT16)(sign | 0x7C00U | (0 != mantissa ? 0x200U : 0U)); // infinity or nan
+
+  const int e = ((int)exponent) - 127 + 15;
+  if (e >= 31)
+    return (MYON__UINT16)(sign | 0x7C00U); // overflow
+
+  if (e <= 0)
+  {
+    // subnormal half
+    if (e < -10)
+      return (MYON__UINT16)sign;
+    mantissa |= 0x800000U;
+    const unsigned int shift = (unsigned int)(14 - e);
+    MYON__UINT32 h = mantissa >> shift;
+    const MYON__UINT32 remainder = mantissa & ((1U << shift) - 1U);
+    const MYON__UINT32 halfway = 1U << (shift - 1U);
+    if (remainder > halfway || (remainder == halfway && 0 != (h & 1U)))
+      h++;
+    return (MYON__UINT16)(sign | h);
+  }
+
+  MYON__UINT32 h = sign | (((MYON__UINT32)e) << 10) | (mantissa >> 13);
+  const MYON__UINT32 remainder = mantissa & 0x1FFFU;
+  if (remainder > 0x1000U || (0x1000U == remainder && 0 != (h & 1U)))
+    h++; // a carry into the exponent is the correct result
+  return (MYON__UINT16)h;
+}
+
+static float Internal_HalfToFloat(MYON__UINT16 h)
+{
+  const unsigned int exponent = (h >> 10) & 0x1FU;
+  const unsigned int mantissa = h & 0x3FFU;
+  float f;
+  if (0 == exponent)
+    f = ldexpf((float)mantissa, -24);
+  else if (31 == exponent)
+    f = (0 == mantissa) ? MYON_FLT_PINF : MYON_FLT_QNAN;
+  else
+    f = ldexpf((float)(0x400U | mantissa), ((int)exponent) - 25);
+  return (0 != (h & 0x8000U)) ? -f : f;
+}
+
+static void Internal_OctahedronEncode(const MYON_3fVector& N, MYON__INT16 oct[2])
+{
+  double x = N.x;
+  double y = N.y;
+  const double z = N.z;
+  const double d = fabs(x) + fabs(y) + fabs(z);
+  if (d > 0.0)
+  {
+    x /= d;
+    y /= d;
+  }
+  if (z < 0.0)
+  {
+    const double fx = (1.0 - fabs(y))*(x >= 0.0 ? 1.0 : -1.0);
+    const double fy = (1.0 - fabs(x))*(y >= 0.0 ? 1.0 : -1.0);
+    x = fx;
+    y = fy;
+  }
+  oct[0] = (MYON__INT16)floor(x*32767.0 + 0.5);
+  oct[1] = (MYON__INT16)floor(y*32767.0 + 0.5);
+}
+
+static const MYON_3fVector Internal_OctahedronDecode(const MYON__INT16 oct[2])
+{
+  double x = ((double)oct[0]) / 32767.0;
+  double y = ((double)oct[1]) / 32767.0;
+  const double z = 1.0 - fabs(x) - fabs(y);
+  if (z < 0.0)
+  {
+    const double fx = (1.0 - fabs(y))*(x >= 0.0 ? 1.0 : -1.0);
+    const double fy = (1.0 - fabs(x))*(y >= 0.0 ? 1.0 : -1.0);
+    x = fx;
+    y = fy;
+  }
+  MYON_3dVector N(x, y, z);
+  N.Unitize();
+  return MYON_3fVector(N);
+}
+
+class MYON_MeshCompactVertexArrays
+{
+public:
+  /*
+  Returns:
+    True if at least one of mesh.m_V[], mesh.m_N[] or mesh.m_T[] 
+    can be compacted. 
+  */
+  bool Encode(
+    const MYON_Mesh& mesh,
+    double tolerance
+    );
+
+  /*
+  Description:
+    Writes the arrays set by Encode() followed by mesh.m_K[] and mesh.m_C[]
+    in an anonymous chunk.
+  */
+  bool Write(
+    const MYON_Mesh& mesh,
+    MYON_BinaryArchive& file
+    ) const;
+
+  /*
+  Description:
+    Reads the chunk saved by Write().
+  */
+  static bool Read(
+    MYON_Mesh& mesh,
+    unsigned int vcount,
+    MYON_BinaryArchive& file
+    );
+
+private:
+  // Vertex normals within this distance of the decoded normal are octahedron encoded.
+  static constexpr double NormalTolerance = 1.0 / 4096.0;
+  // Texture coordinates within this distance of the decoded half float are saved as half floats.
+  static constexpr double TextureCoordinateTolerance = 1.0 / 2048.0;
+
+  bool Internal_QuantizeVertices(
+    const MYON_Mesh& mesh,
+    double tolerance,
+    unsigned int bits
+    );
+
+  // 0 = full precision, 16 or 21 = bits per quantized coordinate
+  unsigned char m_vertex_bits = 0;
+  MYON_3dPoint m_vertex_origin = MYON_3dPoint::Origin;
+  MYON_3dVector m_vertex_scale = MYON_3dVector::ZeroVector;
+  // 16 bits per coordinate: all x values, then all y values, then all z values.
+  MYON_SimpleArray<MYON__UINT16> m_V16;
+  // 21 bits per coordinate: x | y << 21 | z << 42 
+  MYON_SimpleArray<MYON__UINT64> m_V21;
+
+  // two octahedron coordinates per vertex normal
+  MYON_SimpleArray<MYON__INT16> m_N16;
+
+  // two half floats per texture coordinate
+  MYON_SimpleArray<MYON__UINT16> m_T16;
+};
+
+bool MYON_MeshCompactVertexArrays::Internal_QuantizeVertices(
+  const MYON_Mesh& mesh,
+  double tolerance,
+  unsigned int bits
+  )
+{
+  m_vertex_bits = 0;
+  m_V16.SetCount(0);
+  m_V21.SetCount(0);
+
+  const unsigned int vcount = mesh.m_V.UnsignedCount();
+  const bool bDoublePrecision = mesh.HasSynchronizedDoubleAndSinglePrecisionVertices();
+
+  MYON_BoundingBox bbox = MYON_BoundingBox::EmptyBoundingBox;
+  if (bDoublePrecision)
+    bbox.Set(mesh.m_dV, false);
+  else
+    bbox.Set(mesh.m_V, false);
+  if (false == bbox.IsValid())
+    return false;
+
+  const MYON__UINT32 mask = (1U << bits) - 1U;
+  const MYON__UINT32 sign_bit = 1U << (bits - 1U);
+  const double qmax = (double)mask;
+  double origin[3], scale[3];
+  for (int k = 0; k < 3; k++)
+  {
+    origin[k] = bbox.m_min[k];
+    const double d = bbox.m_max[k] - bbox.m_min[k];
+    scale[k] = (d > 0.0) ? d / qmax : 0.0;
+    if (0.5*scale[k] > tolerance)
+      return false; // quantization step is too coarse
+  }
+
+  if (16 == bits)
+    m_V16.SetCapacity(3 * vcount);
+  else
+    m_V21.SetCapacity(vcount);
+
+  MYON__UINT32 prev[3] = { 0, 0, 0 };
+  MYON__UINT32 zigzag[3] = { 0, 0, 0 };
+  for (unsigned int vi = 0; vi < vcount; vi++)
+  {
+    const MYON_3dPoint P = bDoublePrecision ? mesh.m_dV[vi] : MYON_3dPoint(mesh.m_V[vi]);
+    for (int k = 0; k < 3; k++)
+    {
+      double q = (scale[k] > 0.0) ? floor((P[k] - origin[k]) / scale[k] + 0.5) : 0.0;
+      if (q < 0.0)
+        q = 0.0;
+      else if (q > qmax)
+        q = qmax;
+      // The reader decodes the same float.
+      const float decoded = (float)(origin[k] + q*scale[k]);
+      if (!(fabs(((double)decoded) - P[k]) <= tolerance))
+        return false;
+      const MYON__UINT32 qi = (MYON__UINT32)q;
+      const MYON__UINT32 delta = (qi - prev[k]) & mask;
+      const MYON__INT32 s = (0 != (delta & sign_bit)) ? ((MYON__INT32)delta) - ((MYON__INT32)(mask + 1U)) : (MYON__INT32)delta;
+      zigzag[k] = (s >= 0) ? (((MYON__UINT32)s) << 1) : ((((MYON__UINT32)(-s)) << 1) - 1U);
+      prev[k] = qi;
+    }
+    if (16 == bits)
+    {
+      // temporarily interleaved, made planar below
+      m_V16.Append((MYON__UINT16)zigzag[0]);
+      m_V16.Append((MYON__UINT16)zigzag[1]);
+      m_V16.Append((MYON__UINT16)zigzag[2]);
+    }
+    else
+    {
+      m_V21.Append(((MYON__UINT64)zigzag[0]) | (((MYON__UINT64)zigzag[1]) << 21) | (((MYON__UINT64)zigzag[2]) << 42));
+    }
+  }
+
+  if (16 == bits)
+  {
+    // Planar storage keeps similar bytes together for zlib.
+    MYON_SimpleArray<MYON__UINT16> planar(3 * vcount);
+    planar.SetCount(3 * vcount);
+    for (unsigned int vi = 0; vi < vcount; vi++)
+    {
+      planar[vi] = m_V16[3 * vi];
+      planar[vcount + vi] = m_V16[3 * vi + 1];
+      planar[2 * vcount + vi] = m_V16[3 * vi + 2];
+    }
+    m_V16 = planar;
+  }
+
+  m_vertex_bits = (unsigned char)bits;
+  m_vertex_origin = MYON_3dPoint(origin);
+  m_vertex_scale = MYON_3dVector(scale);
+  return true;
+}
+
+bool MYON_MeshCompactVertexArrays::Encode(
+  const MYON_Mesh& mesh,
+  double tolerance
+  )
+{
+  const unsigned int vcount = mesh.m_V.UnsignedCount();
+  if (0 == vcount || !(tolerance > 0.0))
+    return false;
+
+  if (false == Internal_QuantizeVertices(mesh, tolerance, 16))
+    Internal_QuantizeVertices(mesh, tolerance, 21);
+
+  m_N16.SetCount(0);
+  if (vcount == mesh.m_N.UnsignedCount())
+  {
+    m_N16.SetCapacity(2 * vcount);
+    m_N16.SetCount(2 * vcount);
+    for (unsigned int vi = 0; vi < vcount; vi++)
+    {
+      MYON__INT16* oct = m_N16.Array() + 2 * vi;
+      const MYON_3fVector& N = mesh.m_N[vi];
+      Internal_OctahedronEncode(N, oct);
+      const MYON_3fVector D = Internal_OctahedronDecode(oct);
+      if (
+        fabs(((double)D.x) - N.x) <= NormalTolerance
+        && fabs(((double)D.y) - N.y) <= NormalTolerance
+        && fabs(((double)D.z) - N.z) <= NormalTolerance
+        )
+        continue;
+      // zero, invalid or not unit length
+      m_N16.SetCount(0);
+      break;
+    }
+  }
+
+  m_T16.SetCount(0);
+  if (vcount == mesh.m_T.UnsignedCount())
+  {
+    m_T16.SetCapacity(2 * vcount);
+    m_T16.SetCount(2 * vcount);
+    const float* t = &mesh.m_T[0].x;
+    MYON__UINT16* h = m_T16.Array();
+    for (unsigned int i = 0; i < 2 * vcount; i++)
+    {
+      h[i] = Internal_FloatToHalf(t[i]);
+      if (fabs(((double)Internal_HalfToFloat(h[i])) - t[i]) <= TextureCoordinateTolerance)
+        continue;
+      m_T16.SetCount(0);
+      break;
+    }
+  }
+
+  return (0 != m_vertex_bits || m_N16.UnsignedCount() > 0 || m_T16.UnsignedCount() > 0);
+}
+
+bool MYON_MeshCompactVertexArrays::Write(
+  const MYON_Mesh& mesh,
+  MYON_BinaryArchive& file
+  ) const
+{
+  const unsigned int vcount = mesh.m_V.UnsignedCount();
+  const unsigned int Ncount = (vcount == mesh.m_N.UnsignedCount()) ? vcount : 0;
+  const unsigned int Tcount = (vcount == mesh.m_T.UnsignedCount()) ? vcount : 0;
+  const unsigned int Kcount = (vcount == mesh.m_K.UnsignedCount()) ? vcount : 0;
+  const unsigned int Ccount = (vcount == mesh.m_C.UnsignedCount()) ? vcount : 0;
+
+  if ( !file.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK,1,0) )
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    if (!file.WriteChar(m_vertex_bits))
+      break;
+    if (0 != m_vertex_bits)
+    {
+      if (!file.WritePoint(m_vertex_origin))
+        break;
+      if (!file.WriteVector(m_vertex_scale))
+        break;
+      if (16 == m_vertex_bits)
+      {
+        if (!Internal_WriteCompactMeshArray(file, m_V16, m_V16.UnsignedCount(), 2))
+          break;
+      }
+      else
+      {
+        if (!Internal_WriteCompactMeshArray(file, m_V21, m_V21.UnsignedCount(), 8))
+          break;
+      }
+    }
+    else
+    {
+      if (!Internal_WriteCompactMeshArray(file, mesh.m_V, vcount, 4))
+        break;
+    }
+
+    const bool bOctahedronNormals = (m_N16.UnsignedCount() > 0);
+    if (!file.WriteBool(bOctahedronNormals))
       break;
-    if (0 == dVcount)
+    if (bOctahedronNormals)
     {
-      rc = true;
-      break;
+      if (!Internal_WriteCompactMeshArray(file, m_N16, m_N16.UnsignedCount(), 2))
+        break;
     }
-
-    const MYON::endian e = file.Endian();
-    if (e == MYON::endian::big_endian)
+    else
     {
-      file.ToggleByteOrder(dVcount * 3, 8, dV.Array(), (void*)dV.Array());
+      if (!Internal_WriteCompactMeshArray(file, mesh.m_N, Ncount, 4))
+        break;
     }
-    if (!file.WriteCompressedBuffer(dVcount*sizeof(MYON_3dPoint), dV.Array()))
+
+    const bool bHalfFloatTextureCoordinates = (m_T16.UnsignedCount() > 0);
+    if (!file.WriteBool(bHalfFloatTextureCoordinates))
       break;
-    if (e == MYON::endian::big_endian)
+    if (bHalfFloatTextureCoordinates)
     {
-      file.ToggleByteOrder(dVcount * 3, 8, dV.Array(), (void*)dV.Array());
+      if (!Internal_WriteCompactMeshArray(file, m_T16, m_T16.UnsignedCount(), 2))
+        break;
+    }
+    else
+    {
+      if (!Internal_WriteCompactMeshArray(file, mesh.m_T, Tcount, 4))
+        break;
     }
 
+    if (!Internal_WriteCompactMeshArray(file, mesh.m_K, Kcount, 8))
+      break;
+    if (!Internal_WriteCompactMeshArray(file, mesh.m_C, Ccount, 4))
+      break;
+
     rc = true;
     break;
   }
@@ -1988,64 +2781,141 @@ bool WriteMeshDoublePrecisionVertices(
   return rc;
 }
 
-static
-bool ReadMeshDoublePrecisionVertices( 
-  MYON_BinaryArchive& file, 
-  MYON_SimpleArray<MYON_3dPoint>& dV 
+bool MYON_MeshCompactVertexArrays::Read(
+  MYON_Mesh& mesh,
+  unsigned int vcount,
+  MYON_BinaryArchive& file
   )
 {
-  dV.SetCount(0);
-
   int major_version = 0;
   int minor_version = 0;
   if ( !file.BeginRead3dmChunk(TCODE_ANONYMOUS_CHUNK,&major_version,&minor_version) )
     return false;
 
   bool rc = false;
-  for(;;)
+  for (;;)
   {
     if (1 != major_version)
       break;
 
-    unsigned int dVcount = 0;
-    if (!file.ReadInt(&dVcount))
+    unsigned char bits = 0;
+    if (!file.ReadChar(&bits))
       break;
+    if (16 == bits || 21 == bits)
+    {
+      MYON_3dPoint origin = MYON_3dPoint::Origin;
+      MYON_3dVector scale = MYON_3dVector::ZeroVector;
+      if (!file.ReadPoint(origin))
+        break;
+      if (!file.ReadVector(scale))
+        break;
 
-    if (0 == dVcount)
+      MYON_SimpleArray<MYON__UINT16> V16;
+      MYON_SimpleArray<MYON__UINT64> V21;
+      if (16 == bits)
+      {
+        if (!Internal_ReadCompactMeshArray(file, 3 * vcount, 2, V16))
+          break;
+        if (V16.UnsignedCount() != 3 * vcount)
+          break;
+      }
+      else
+      {
+        if (!Internal_ReadCompactMeshArray(file, vcount, 8, V21))
+          break;
+        if (V21.UnsignedCount() != vcount)
+          break;
+      }
+
+      const MYON__UINT32 mask = (1U << bits) - 1U;
+      MYON__UINT32 q[3] = { 0, 0, 0 };
+      MYON__UINT32 zigzag[3] = { 0, 0, 0 };
+      mesh.m_V.SetCapacity(vcount);
+      mesh.m_V.SetCount(vcount);
+      for (unsigned int vi = 0; vi < vcount; vi++)
+      {
+        if (16 == bits)
+        {
+          zigzag[0] = V16[vi];
+          zigzag[1] = V16[vcount + vi];
+          zigzag[2] = V16[2 * vcount + vi];
+        }
+        else
+        {
+          const MYON__UINT64 packed = V21[vi];
+          zigzag[0] = (MYON__UINT32)(packed & mask);
+          zigzag[1] = (MYON__UINT32)((packed >> 21) & mask);
+          zigzag[2] = (MYON__UINT32)((packed >> 42) & mask);
+        }
+        float* v = &mesh.m_V[vi].x;
+        for (int k = 0; k < 3; k++)
+        {
+          const MYON__UINT32 delta = (0 != (zigzag[k] & 1U)) ? (0U - ((zigzag[k] + 1U) >> 1)) : (zigzag[k] >> 1);
+          q[k] = (q[k] + delta) & mask;
+          v[k] = (float)(origin[k] + ((double)q[k])*scale[k]);
+        }
+      }
+    }
+    else if (0 == bits)
     {
-      rc = true;
-      break;
+      if (!Internal_ReadCompactMeshArray(file, vcount, 4, mesh.m_V))
+        break;
     }
-
-    size_t sz = 0;
-    if (!file.ReadCompressedBufferSize( &sz ))
+    else
       break;
 
-    if (sz != ((size_t)dVcount)*sizeof(MYON_3dPoint))
-    {
-      MYON_ERROR("Compressed double precision vertex point buffer size is wrong.");
+    bool bOctahedronNormals = false;
+    if (!file.ReadBool(&bOctahedronNormals))
       break;
+    if (bOctahedronNormals)
+    {
+      MYON_SimpleArray<MYON__INT16> N16;
+      if (!Internal_ReadCompactMeshArray(file, 2 * vcount, 2, N16))
+        break;
+      if (N16.UnsignedCount() != 2 * vcount)
+        break;
+      mesh.m_N.SetCapacity(vcount);
+      mesh.m_N.SetCount(vcount);
+      for (unsigned int vi = 0; vi < vcount; vi++)
+        mesh.m_N[vi] = Internal_OctahedronDecode(N16.Array() + 2 * vi);
     }
-
-    dV.SetCapacity(dVcount);
-    dV.SetCount(dVcount);
-    MYON_3dPoint* a = dV.Array();
-    if (nullptr == a || dVcount != dV.UnsignedCount())
+    else
     {
-      MYON_ERROR("Unable to allocate double precision vertex point array.");
+      if (!Internal_ReadCompactMeshArray(file, vcount, 4, mesh.m_N))
+        break;
+    }
+
+    bool bHalfFloatTextureCoordinates = false;
+    if (!file.ReadBool(&bHalfFloatTextureCoordinates))
       break;
+    if (bHalfFloatTextureCoordinates)
+    {
+      MYON_SimpleArray<MYON__UINT16> T16;
+      if (!Internal_ReadCompactMeshArray(file, 2 * vcount, 2, T16))
+        break;
+      if (T16.UnsignedCount() != 2 * vcount)
+        break;
+      mesh.m_T.SetCapacity(vcount);
+      mesh.m_T.SetCount(vcount);
+      float* t = &mesh.m_T[0].x;
+      for (unsigned int i = 0; i < 2 * vcount; i++)
+        t[i] = Internal_HalfToFloat(T16[i]);
     }
-    
-    bool bFailedCRC = 0;
-    if (!file.ReadCompressedBuffer( sz, a, &bFailedCRC))
+    else
+    {
+      if (!Internal_ReadCompactMeshArray(file, vcount, 4, mesh.m_T))
+        break;
+    }
+
+    if (!Internal_ReadCompactMeshArray(file, vcount, 8, mesh.m_K))
+      break;
+    if (!Internal_ReadCompactMeshArray(file, vcount, 4, mesh.m_C))
       break;
 
     rc = true;
     break;
   }
 
-  if (!rc)
-    dV.SetCount(0);
   if ( !file.EndRead3dmChunk() )
     rc = false;
 
@@ -2055,9 +2925,27 @@ bool ReadMeshDoublePrecisionVertices(
 bool MYON_Mesh::Write( MYON_BinaryArchive& file ) const
 {
   int i;
+
+  // See MYON_BinaryArchive::SetMeshQuantizationTolerance()
+  MYON_MeshCompactVertexArrays compact_vertex_arrays;
+  const bool bCompactVertexArrays
+    =  file.Archive3dmVersion() >= 60
+    && file.MeshQuantizationTolerance() > 0.0
+    && compact_vertex_arrays.Encode(*this, file.MeshQuantizationTolerance());
+
+  // See MYON_BinaryArchive::SetCompactMeshFaces()
+  const bool bCompactFaces
+    =  file.Archive3dmVersion() >= 60
+    && file.CompactMeshFaces()
+    && FaceUnsignedCount() > 0;
+
   //const int major_version = 1; // uncompressed
   //const int major_version = 2; // beta format (never used)
-  const int major_version = 3; // compressed
+  //const int major_version = 3; // compressed
+  const int major_version 
+    = (bCompactVertexArrays || bCompactFaces)
+    ? 4  // version 3 format with compact m_V[], m_N[], m_T[] and m_F[]
+    : 3; // compressed
 
   const int minor_version 
     = (file.Archive3dmVersion() >= 60) 
@@ -2135,7 +3023,13 @@ bool MYON_Mesh::Write( MYON_BinaryArchive& file ) const
     }
   }
 
-  if (rc) rc = WriteFaceArray( vcount, fcount, file );
+  if (rc)
+  {
+    if (bCompactFaces)
+      rc = MYON_MeshCompactFaceArray::Write(*this, fcount, file);
+    else
+      rc = WriteFaceArray( vcount, fcount, file );
+  }
 
   if (rc) {
     // major version is a hard coded 3
@@ -2143,6 +3037,9 @@ bool MYON_Mesh::Write( MYON_BinaryArchive& file ) const
     //if ( major_version == 1 )
     //  rc = Write_1(file);
     //else if ( major_version == 3 )
+    if (4 == major_version)
+      rc = compact_vertex_arrays.Write(*this, file);
+    else
       rc = Write_2(vcount,file);
     //else
     //  rc = false;
@@ -2194,7 +3091,8 @@ bool MYON_Mesh::Write( MYON_BinaryArchive& file ) const
     {
       // added explicit double precision vertices chunk version 3.7
       // (used to be on user data)
-      const bool bHasDoublePrecisionVertices = HasDoublePrecisionVertices();
+      // Compact meshes are saved without double precision vertices.
+      const bool bHasDoublePrecisionVertices = !bCompactVertexArrays && HasDoublePrecisionVertices();
       if (rc) rc = file.WriteBool(bHasDoublePrecisionVertices);
       if (rc && bHasDoublePrecisionVertices)
         rc = WriteMeshDoublePrecisionVertices(file, m_dV);
@@ -2417,6 +3315,14 @@ bool MYON_Mesh::Read( MYON_BinaryArchive& file )
   int minor_version = 0;
   int i;
   bool rc = file.Read3dmChunkVersion(&major_version,&minor_version);
+
+  // Version 4.x is version 3.x with compact m_V[], m_N[] and m_T[] arrays
+  // and, optionally, a compact m_F[] array.
+  // See MYON_BinaryArchive::SetMeshQuantizationTolerance() and
+  // MYON_BinaryArchive::SetCompactMeshFaces().
+  const bool bCompactVertexArrays = (rc && 4 == major_version);
+  if (bCompactVertexArrays)
+    major_version = 3;
   
   if (rc && (1 == major_version || 3 == major_version) ) 
   {
@@ -2515,7 +3421,10 @@ bool MYON_Mesh::Read( MYON_BinaryArchive& file )
         rc = Read_1(file);
       }
       else if ( major_version == 3 ) {
-        rc = Read_2(vcount,file);
+        if (bCompactVertexArrays)
+          rc = MYON_MeshCompactVertexArrays::Read(*this, (unsigned int)vcount, file);
+        else
+          rc = Read_2(vcount,file);
       }
       else
         rc = false;
@@ -2632,6 +3541,11 @@ bool MYON_Mesh::Read( MYON_BinaryArchive& file )
                 {
                   rc = file.ReadBoundingBox(m_vertex_bbox);
                 }
+                if (rc && bCompactVertexArrays)
+                {
+                  // quantized vertices can be slightly outside the saved box
+                  m_vertex_bbox.Set(m_V, false);
+                }
                 if (bHasInvalidDoublePrecisionVertices)
                 {
                   m_vertex_bbox.Set(m_V, false);
@@ -3388,6 +4302,30 @@ int MYON_Mesh::SolidOrientation() const
 }
 
 
+static bool MeshIsPointInsideHelper(
+        const MYON_MeshTree* mesh_tree,
+        MYON_3dPoint test_point, 
+        double tolerance,
+        bool bStrictlyInside
+        )
+{
+  if ( nullptr == mesh_tree || !test_point.IsValid() )
+    return false;
+
+  if ( !mesh_tree->BoundingBox().IsPointIn(test_point) )
+  {
+    if ( bStrictlyInside || 0.0 == tolerance )
+      return false;
+    return mesh_tree->IsNear(test_point, tolerance);
+  }
+
+  if ( tolerance > 0.0 && mesh_tree->IsNear(test_point, tolerance) )
+    return !bStrictlyInside;
+
+  // +1 inside outward oriented meshes, -1 inside inward oriented meshes
+  return ( 0 != mesh_tree->WindingNumber(test_point) );
+}
+
 bool MYON_Mesh::IsPointInside(
         MYON_3dPoint test_point, 
         double tolerance,
@@ -3396,10 +4334,83 @@ bool MYON_Mesh::IsPointInside(
 {
   if ( IsSolid() )
   {
+    if ( !(MYON_IsValid(tolerance) && tolerance > 0.0) )
+      tolerance = 0.0;
+    return MeshIsPointInsideHelper(MeshTree(), test_point, tolerance, bStrictlyInside);
   }
   return false;
 }
 
+unsigned int MYON_Mesh::IsPointInside(
+        size_t point_count,
+        const MYON_3dPoint* points,
+        double tolerance,
+        bool bStrictlyInside,
+        bool* bInside,
+        unsigned int thread_count
+        ) const
+{
+  if ( 0 == point_count || nullptr == points || nullptr == bInside )
+    return 0;
+
+  // The solid test and the tree are cached before threads use them.
+  const MYON_MeshTree* mesh_tree = IsSolid() ? MeshTree() : nullptr;
+  if ( nullptr == mesh_tree )
+  {
+    memset(bInside, 0, point_count * sizeof(bInside[0]));
+    return 0;
+  }
+  if ( !(MYON_IsValid(tolerance) && tolerance > 0.0) )
+    tolerance = 0.0;
+
+  if ( 0 == thread_count )
+    thread_count = std::thread::hardware_concurrency();
+
+  const size_t block_size = 256;
+  const size_t block_count = (point_count + block_size - 1) / block_size;
+  std::atomic<size_t> next_block(0);
+  std::atomic<unsigned int> inside_count(0);
+  auto test = [&]()
+  {
+    unsigned int block_inside_count = 0;
+    for ( size_t b = next_block++; b < block_count; b = next_block++ )
+    {
+      const size_t i1 = (b + 1 < block_count) ? (b + 1) * block_size : point_count;
+      for ( size_t i = b * block_size; i < i1; i++ )
+      {
+        bInside[i] = MeshIsPointInsideHelper(mesh_tree, points[i], tolerance, bStrictlyInside);
+        if ( bInside[i] )
+          block_inside_count++;
+      }
+    }
+    inside_count += block_inside_count;
+  };
+
+  const size_t worker_count = ((block_count < thread_count) ? block_count : (thread_count > 0 ? thread_count : 1)) - 1;
+  MYON_SimpleArray< std::thread* > workers((int)worker_count);
+  for ( size_t i = 0; i < worker_count; i++ )
+  {
+    try
+    {
+      workers.Append(new std::thread(test));
+    }
+    catch (const std::system_error&)
+    {
+      // No more threads are available.
+      // The calling thread tests the remaining points.
+      break;
+    }
+  }
+  test();
+  for ( int i = 0; i < workers.Count(); i++ )
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+
+  return inside_count;
+}
+
 bool MYON_Mesh::IsSolid() const
 {
   return ( IsClosed() && IsManifold() && IsOriented() );
@@ -4254,6 +5265,7 @@ void MYON_Mesh::InvalidateVertexBoundingBox()
 {
   m_vertex_bbox = MYON_BoundingBox::UnsetBoundingBox;
   m_tight_bbox_cache.RemoveAllBoundingBoxes();
+  DestroyTree();
 }
 
 void MYON_Mesh::InvalidateVertexNormalBoundingBox()
@@ -4546,6 +5558,7 @@ const MYON_MeshFace MYON_MeshFace::UnsetMeshFace(MYON_UnsetMeshFaceInitalizer())
 void MYON_Mesh::DestroyTopology()
 {
   m_top.Destroy();
+  DestroyTree();
 }
 
 bool
@@ -9084,6 +10097,244 @@ bool MYON_Mesh::Compact()
   return true;
 }
 
+static float Internal_VertexCacheScore(
+  int cache_position,
+  unsigned int remaining_face_count,
+  unsigned int cache_size
+  )
+{
+  // Linear-speed vertex cache optimization (T. Forsyth). Vertices used
+  // by the last face get a fixed score, older cached vertices a score
+  // that decays with their position, and vertices with few remaining
+  // faces a boost so they are finished and leave the cache.
+  if (0 == remaining_face_count)
+    return -1.0f;
+  float score = 0.0f;
+  if (cache_position >= 0)
+  {
+    if (cache_position < 3)
+      score = 0.75f;
+    else
+      score = powf(1.0f - ((float)(cache_position - 3)) / ((float)(cache_size - 3)), 1.5f);
+  }
+  score += 2.0f / sqrtf((float)remaining_face_count);
+  return score;
+}
+
+bool MYON_Mesh::OptimizeFaceOrderForVertexCache(
+  unsigned int cache_size
+  )
+{
+  const unsigned int vcount = m_V.UnsignedCount();
+  const unsigned int fcount = m_F.UnsignedCount();
+  if (fcount < 2 || 0 == vcount)
+    return false;
+  if (cache_size < 8)
+    cache_size = 32;
+
+  // face_vcount[fi] = 3 for triangles and 4 for quads
+  MYON_SimpleArray<unsigned char> face_vcount(fcount);
+  face_vcount.SetCount(fcount);
+  MYON_SimpleArray<unsigned int> vertex_face_offset(vcount + 1);
+  vertex_face_offset.SetCount(vcount + 1);
+  vertex_face_offset.Zero();
+  for (unsigned int fi = 0; fi < fcount; fi++)
+  {
+    const unsigned int* fvi = (const unsigned int*)m_F[fi].vi;
+    face_vcount[fi] = (fvi[2] == fvi[3]) ? 3 : 4;
+    for (unsigned int j = 0; j < face_vcount[fi]; j++)
+    {
+      if (fvi[j] >= vcount)
+        return false;
+      vertex_face_offset[fvi[j] + 1]++;
+    }
+  }
+
+  // vertex_faces[vertex_face_offset[vi],...] = faces that use vertex vi 
+  // and have not been added to the new order.
+  MYON_SimpleArray<unsigned int> remaining_face_count(vcount);
+  remaining_face_count.SetCount(vcount);
+  for (unsigned int vi = 0; vi < vcount; vi++)
+  {
+    remaining_face_count[vi] = vertex_face_offset[vi + 1];
+    vertex_face_offset[vi + 1] += vertex_face_offset[vi];
+  }
+  MYON_SimpleArray<unsigned int> vertex_faces(vertex_face_offset[vcount]);
+  vertex_faces.SetCount(vertex_face_offset[vcount]);
+  {
+    MYON_SimpleArray<unsigned int> n(vcount);
+    n.SetCount(vcount);
+    n.Zero();
+    for (unsigned int fi = 0; fi < fcount; fi++)
+    {
+      const unsigned int* fvi = (const unsigned int*)m_F[fi].vi;
+      for (unsigned int j = 0; j < face_vcount[fi]; j++)
+        vertex_faces[vertex_face_offset[fvi[j]] + n[fvi[j]]++] = fi;
+    }
+  }
+
+  MYON_SimpleArray<int> cache_position(vcount);
+  cache_position.SetCount(vcount);
+  MYON_SimpleArray<float> vertex_score(vcount);
+  vertex_score.SetCount(vcount);
+  for (unsigned int vi = 0; vi < vcount; vi++)
+  {
+    cache_position[vi] = -1;
+    vertex_score[vi] = Internal_VertexCacheScore(-1, remaining_face_count[vi], cache_size);
+  }
+
+  MYON_SimpleArray<bool> face_added(fcount);
+  face_added.SetCount(fcount);
+  unsigned int best_fi = MYON_UNSET_UINT_INDEX;
+  float best_score = -1.0f;
+  for (unsigned int fi = 0; fi < fcount; fi++)
+  {
+    face_added[fi] = false;
+    const unsigned int* fvi = (const unsigned int*)m_F[fi].vi;
+    float s = 0.0f;
+    for (unsigned int j = 0; j < face_vcount[fi]; j++)
+      s += vertex_score[fvi[j]];
+    if (s > best_score)
+    {
+      best_score = s;
+      best_fi = fi;
+    }
+  }
+
+  // cache[] holds at most cache_size vertices. new_cache[] has room for
+  // the cache and the 4 vertices of the face being added.
+  MYON_SimpleArray<unsigned int> cache(cache_size + 4);
+  MYON_SimpleArray<unsigned int> new_cache(cache_size + 4);
+  MYON_SimpleArray<unsigned int> new_order(fcount);
+  unsigned int next_unadded_fi = 0;
+
+  while (new_order.UnsignedCount() < fcount)
+  {
+    if (MYON_UNSET_UINT_INDEX == best_fi)
+    {
+      // No cached vertex has remaining faces.
+      while (face_added[next_unadded_fi])
+        next_unadded_fi++;
+      best_fi = next_unadded_fi;
+    }
+
+    const unsigned int fi = best_fi;
+    const unsigned int* fvi = (const unsigned int*)m_F[fi].vi;
+    face_added[fi] = true;
+    new_order.Append(fi);
+
+    new_cache.SetCount(0);
+    for (unsigned int j = 0; j < face_vcount[fi]; j++)
+    {
+      const unsigned int vi = fvi[j];
+
+      // remove fi from the vertex's remaining faces
+      unsigned int* vf = vertex_faces.Array() + vertex_face_offset[vi];
+      const unsigned int n = remaining_face_count[vi];
+      for (unsigned int k = 0; k < n; k++)
+      {
+        if (fi == vf[k])
+        {
+          vf[k] = vf[n - 1];
+          vf[n - 1] = fi;
+          remaining_face_count[vi] = n - 1;
+          break;
+        }
+      }
+
+      if (new_cache.Search(vi) < 0)
+        new_cache.Append(vi);
+    }
+    for (unsigned int k = 0; k < cache.UnsignedCount(); k++)
+    {
+      if (new_cache.Search(cache[k]) < 0)
+        new_cache.Append(cache[k]);
+    }
+
+    for (unsigned int k = 0; k < new_cache.UnsignedCount(); k++)
+    {
+      const unsigned int vi = new_cache[k];
+      cache_position[vi] = (k < cache_size) ? ((int)k) : -1;
+      vertex_score[vi] = Internal_VertexCacheScore(cache_position[vi], remaining_face_count[vi], cache_size);
+    }
+
+    best_fi = MYON_UNSET_UINT_INDEX;
+    best_score = -1.0f;
+    for (unsigned int k = 0; k < new_cache.UnsignedCount(); k++)
+    {
+      const unsigned int vi = new_cache[k];
+      const unsigned int* vf = vertex_faces.Array() + vertex_face_offset[vi];
+      for (unsigned int n = 0; n < remaining_face_count[vi]; n++)
+      {
+        const unsigned int* gvi = (const unsigned int*)m_F[vf[n]].vi;
+        float s = 0.0f;
+        for (unsigned int j = 0; j < face_vcount[vf[n]]; j++)
+          s += vertex_score[gvi[j]];
+        if (s > best_score)
+        {
+          best_score = s;
+          best_fi = vf[n];
+        }
+      }
+    }
+
+    if (new_cache.UnsignedCount() > cache_size)
+      new_cache.SetCount(cache_size);
+    cache = new_cache;
+  }
+
+  bool bReordered = false;
+  for (unsigned int fi = 0; fi < fcount && !bReordered; fi++)
+    bReordered = (new_order[fi] != fi);
+  if (!bReordered)
+    return false;
+
+  // face_map[old face index] = new face index
+  MYON_SimpleArray<unsigned int> face_map(fcount);
+  face_map.SetCount(fcount);
+  for (unsigned int fi = 0; fi < fcount; fi++)
+    face_map[new_order[fi]] = fi;
+
+  {
+    MYON_SimpleArray<MYON_MeshFace> F(m_F);
+    for (unsigned int fi = 0; fi < fcount; fi++)
+      m_F[fi] = F[new_order[fi]];
+  }
+
+  if (fcount == m_FN.UnsignedCount())
+  {
+    MYON_3fVectorArray FN(m_FN);
+    for (unsigned int fi = 0; fi < fcount; fi++)
+      m_FN[fi] = FN[new_order[fi]];
+  }
+
+  if (fcount == m_NgonMap.UnsignedCount())
+  {
+    MYON_SimpleArray<unsigned int> ngon_map(m_NgonMap);
+    for (unsigned int fi = 0; fi < fcount; fi++)
+      m_NgonMap[fi] = ngon_map[new_order[fi]];
+  }
+
+  const unsigned int ngon_count = m_Ngon.UnsignedCount();
+  for (unsigned int ngon_index = 0; ngon_index < ngon_count; ngon_index++)
+  {
+    MYON_MeshNgon* ngon = m_Ngon[ngon_index];
+    if (nullptr == ngon || nullptr == ngon->m_fi)
+      continue;
+    for (unsigned int j = 0; j < ngon->m_Fcount; j++)
+    {
+      if (ngon->m_fi[j] < fcount)
+        ngon->m_fi[j] = face_map[ngon->m_fi[j]];
+    }
+  }
+
+  DestroyTopology();
+  DestroyPartition();
+  DestroyTree();
+
+  return true;
+}
+
 void MYON_Mesh::Cleanup(
   bool bRemoveNgons, 
   bool bRemoveDegenerateFaces, 
@@ -12998,6 +14249,44 @@ bool MYON_3dmObjectAttributes::EnableCustomRenderMeshParameters(bool bEnable)
 
 void MYON_Mesh::DestroyTree( bool bDeleteTree )
 {
+  if ( nullptr != m_mesh_tree )
+  {
+    if ( bDeleteTree )
+      delete m_mesh_tree;
+    m_mesh_tree = nullptr;
+  }
+}
+
+const MYON_MeshTree* MYON_Mesh::MeshTree() const
+{
+  if ( nullptr == m_mesh_tree )
+  {
+    MYON_MeshTree* mesh_tree = new MYON_MeshTree();
+    if ( mesh_tree->Create(*this) )
+      m_mesh_tree = mesh_tree;
+    else
+      delete mesh_tree;
+  }
+  return m_mesh_tree;
+}
+
+bool MYON_Mesh::IntersectRay(
+  const MYON_3dPoint& P,
+  const MYON_3dVector& D,
+  MYON_MeshRayHit& hit
+  ) const
+{
+  const MYON_MeshTree* mesh_tree = MeshTree();
+  if ( nullptr == mesh_tree )
+  {
+    hit.m_t = MYON_UNSET_VALUE;
+    hit.m_fi = -1;
+    hit.m_ti = 0;
+    hit.m_u = 0.0;
+    hit.m_v = 0.0;
+    return false;
+  }
+  return mesh_tree->IntersectRay(P, D, MYON_DBL_MAX, hit);
 }
 
 
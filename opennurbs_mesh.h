@@ -3108,6 +3108,286 @@ MYON_DLL_TEMPLATE template class MYON_CLASS MYON_SimpleArray<MYON_MappingTag>;
 MYON_DLL_TEMPLATE template class MYON_CLASS MYON_ClassArray<MYON_TextureCoordinates>;
 #endif
 
+// A ray - mesh face intersection found by MYON_MeshTree and MYON_Mesh
+// ray queries. The ray is P + t*D.
+struct MYON_MeshRayHit
+{
+  // Ray parameter of the hit point. MYON_UNSET_VALUE if the ray did not hit the mesh.
+  double m_t;
+
+  // Index of the hit face in MYON_Mesh.m_F[]. -1 if the ray did not hit the mesh.
+  int m_fi;
+
+  // 0: the hit is on triangle (vi[0],vi[1],vi[2]) of the face.
+  // 1: the hit is on triangle (vi[0],vi[2],vi[3]) of a quad face.
+  int m_ti;
+
+  // Barycentric coordinates of the hit point on the triangle (A,B,C).
+  // hit point = (1-m_u-m_v)*A + m_u*B + m_v*C.
+  double m_u;
+  double m_v;
+};
+
+// Maximum number of rays MYON_MeshTree::IntersectRayPacket() traverses together.
+#define MYON_MeshTree_PACKET_SIZE 8
+
+// The MYON_MeshTreeNode is used at branch and leaf nodes of an MYON_MeshTree.
+struct MYON_MeshTreeNode
+{
+  // bounding box of the triangles below this node
+  double m_min[3];
+  double m_max[3];
+
+  // If m_count > 0, the node is a leaf and its triangles are 
+  // MYON_MeshTree.Triangles()[m_index] ... [m_index + m_count - 1].
+  // If m_count = 0, the children are nodes this+1 and Nodes()[m_index].
+  int m_index;
+  int m_count;
+
+  // coordinate the children were split along (0,1 or 2)
+  int m_axis;
+};
+
+// A triangle in an MYON_MeshTree.
+struct MYON_MeshTreeTriangle
+{
+  // m_V[0], m_V[1], m_V[2] are the triangle corners.
+  double m_V[3][3];
+
+  // MYON_MeshRayHit.m_fi and m_ti values for this triangle.
+  int m_fi;
+  int m_ti;
+};
+
+#if defined(MYON_DLL_TEMPLATE)
+MYON_DLL_TEMPLATE template class MYON_CLASS MYON_SimpleArray<MYON_MeshTreeNode>;
+MYON_DLL_TEMPLATE template class MYON_CLASS MYON_SimpleArray<MYON_MeshTreeTriangle>;
+#endif
+
+////////////////////////////////////////////////////////////////
+//
+// MYON_MeshTree
+//
+//   The MYON_MeshTree class is a bounding volume hierarchy of the
+//   triangles of a mesh used for ray intersection and point
+//   inclusion queries. It is created with a binned surface area
+//   heuristic builder and keeps a copy of the triangle corners, 
+//   so it does not reference the mesh after it is created.
+//   MYON_Mesh::MeshTree() returns a tree that is cached on the mesh.
+//
+class MYON_CLASS MYON_MeshTree
+{
+public:
+  static const MYON_MeshTree Empty;
+
+  MYON_MeshTree() = default;
+  ~MYON_MeshTree() = default;
+  MYON_MeshTree(const MYON_MeshTree&) = default;
+  MYON_MeshTree& operator=(const MYON_MeshTree&) = default;
+
+  /*
+  Description:
+    Create a tree of the triangles of a mesh. Quad faces are split
+    into the triangles (vi[0],vi[1],vi[2]) and (vi[0],vi[2],vi[3]).
+  Parameters:
+    mesh - [in]
+  Returns:
+    True if successful. False if the mesh has no valid faces, in which 
+    case the tree is empty.
+  */
+  bool Create(
+    const class MYON_Mesh& mesh
+    );
+
+  /*
+  Description:
+    Remove all triangles.
+  */
+  void Destroy();
+
+  /*
+  Description:
+    Find the first place a ray hits the mesh.
+  Parameters:
+    P - [in]
+    D - [in]
+      The ray is P + t*D with 0 <= t <= t_max.
+    t_max - [in]
+    hit - [out]
+      If the ray hits the mesh, the hit with the smallest t.
+  Returns:
+    True if the ray hits the mesh.
+  Remarks:
+    Hits on edges and vertices are reported. A ray that passes 
+    between two triangles that share an edge hits at least one of 
+    them.
+  */
+  bool IntersectRay(
+    const MYON_3dPoint& P,
+    const MYON_3dVector& D,
+    double t_max,
+    MYON_MeshRayHit& hit
+    ) const;
+
+  /*
+  Description:
+    Find every place a ray hits the mesh.
+  Parameters:
+    P - [in]
+    D - [in]
+      The ray is P + t*D with 0 <= t <= t_max.
+    t_max - [in]
+    resultCallback - [in]
+      Called once for each hit, in no particular order. Return true 
+      to continue the search or false to stop it.
+    a_context - [in]
+      argument passed through to resultCallback().
+  Returns:
+    Number of hits passed to resultCallback().
+  */
+  unsigned int IntersectRay(
+    const MYON_3dPoint& P,
+    const MYON_3dVector& D,
+    double t_max,
+    bool MYON_CALLBACK_CDECL resultCallback(void* a_context, const MYON_MeshRayHit& hit),
+    void* a_context
+    ) const;
+
+  /*
+  Description:
+    Find the first place each ray in a list hits the mesh.
+  Parameters:
+    ray_count - [in]
+    P - [in]
+    D - [in]
+      The rays are P[i] + t*D[i] with 0 <= t <= t_max.
+    t_max - [in]
+    hits - [out]
+      hits[i] is the first hit of ray i. If ray i does not hit the mesh,
+      then hits[i].m_fi = -1.
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: search on the calling thread (default).
+      > 1: use at most thread_count threads.
+  Returns:
+    Number of rays that hit the mesh.
+  */
+  unsigned int IntersectRays(
+    size_t ray_count,
+    const MYON_3dPoint* P,
+    const MYON_3dVector* D,
+    double t_max,
+    MYON_MeshRayHit* hits,
+    unsigned int thread_count = 1
+    ) const;
+
+  /*
+  Description:
+    Find the first place each ray in a packet of rays hits the mesh.
+    The rays traverse the tree together, which is faster than
+    IntersectRays() when the rays start near each other and point in
+    similar directions, like the rays through the pixels of a tile of
+    an image.
+  Parameters:
+    ray_count - [in]
+      Number of rays. If ray_count > MYON_MeshTree_PACKET_SIZE, the rays
+      are traversed in packets of MYON_MeshTree_PACKET_SIZE rays.
+    P - [in]
+    D - [in]
+      The rays are P[i] + t*D[i] with 0 <= t <= t_max.
+    t_max - [in]
+    hits - [out]
+      hits[i] is the first hit of ray i. If ray i does not hit the mesh,
+      then hits[i].m_fi = -1.
+  Returns:
+    Number of rays that hit the mesh.
+  */
+  unsigned int IntersectRayPacket(
+    unsigned int ray_count,
+    const MYON_3dPoint* P,
+    const MYON_3dVector* D,
+    double t_max,
+    MYON_MeshRayHit* hits
+    ) const;
+
+  /*
+  Description:
+    Get the winding number of the triangles around a point.
+  Parameters:
+    point - [in]
+  Returns:
+    The sum over the triangles a ray from point crosses of +1 
+    when the ray leaves through the front of the triangle and -1 
+    when it leaves through the back. For a closed oriented mesh 
+    this is +1 at points inside a mesh with outward facing normals,
+    -1 at points inside a mesh with inward facing normals and 0 at
+    points outside.
+  Remarks:
+    Rays that hit an edge or vertex or graze a triangle give
+    unreliable counts. When that happens, other ray directions are
+    tried and if none of them is clean, the most common count is
+    returned.
+  */
+  int WindingNumber(
+    const MYON_3dPoint& point
+    ) const;
+
+  /*
+  Description:
+    Determine if a point is within a distance of a triangle.
+  Parameters:
+    point - [in]
+    distance - [in] >= 0.0
+  Returns:
+    True if the distance from point to a triangle is <= distance.
+  */
+  bool IsNear(
+    const MYON_3dPoint& point,
+    double distance
+    ) const;
+
+  /*
+  Returns:
+    Number of triangles.
+  */
+  unsigned int TriangleCount() const;
+
+  /*
+  Returns:
+    Pointer to the triangles in the order they are referenced by the
+    leaf nodes.
+  */
+  const MYON_MeshTreeTriangle* Triangles() const;
+
+  /*
+  Returns:
+    Number of nodes.
+  */
+  unsigned int NodeCount() const;
+
+  /*
+  Returns:
+    Pointer to the nodes. The root is Nodes()[0].
+  */
+  const MYON_MeshTreeNode* Nodes() const;
+
+  /*
+  Returns:
+    Bounding box of the triangles.
+  */
+  MYON_BoundingBox BoundingBox() const;
+
+  /*
+  Returns:
+    Number of bytes of heap memory used by this tree.
+  */
+  size_t SizeOf() const;
+
+private:
+  MYON_SimpleArray<MYON_MeshTreeNode> m_nodes;
+  MYON_SimpleArray<MYON_MeshTreeTriangle> m_triangles;
+};
+
 class MYON_CLASS MYON_Mesh : public MYON_Geometry
 {
   MYON_OBJECT_DECLARE(MYON_Mesh);
@@ -3146,8 +3426,32 @@ public:
                            // memory.
 
 
+  /*
+  Description:
+    Destroy the tree returned by MeshTree().
+  Parameters:
+    bDeleteTree - [in]
+      If false, the tree is forgotten but not deleted. Use false 
+      only in the same situations EmergencyDestroy() is used.
+  */
   void DestroyTree( bool bDeleteTree = true );
 
+  /*
+  Description:
+    Get a bounding volume hierarchy of the mesh faces that is used
+    for ray intersection and point inclusion queries.
+  Returns:
+    A pointer to the tree or nullptr if the mesh has no valid faces.
+    The tree is created the first time it is needed and cached on 
+    the mesh until DestroyTree() or DestroyRuntimeCache() is called.
+  Remarks:
+    If you modify m_V[], m_dV[] or m_F[], then call DestroyTree().
+    Creating the tree is not thread safe. Call MeshTree() once before
+    using the tree or calling IntersectRay() or IsPointInside() from
+    multiple threads.
+  */
+  const class MYON_MeshTree* MeshTree() const;
+
   /*
   Description:
     Check for corrupt data values that are likely to cause crashes.
@@ -3737,6 +4041,28 @@ Returns:
   //   and shrinks arrays to minimum required size.
   bool Compact();
 
+  /*
+  Description:
+    Reorders m_F[] so faces that share vertices are near each other.
+    Renderers reuse more transformed vertices and the compact face
+    arrays enabled by MYON_BinaryArchive::SetCompactMeshFaces() are
+    smaller.
+  Parameters:
+    cache_size - [in]
+      Number of vertices in the simulated vertex cache.
+      Values below 8 are replaced with the default of 32.
+  Returns:
+    True if m_F[] was reordered.
+  Remarks:
+    Vertices and the shape of the mesh are not changed. m_FN[], n-gon
+    face lists and the n-gon map are updated. Topology, partition and
+    face tree information is destroyed. Face component indices saved 
+    elsewhere no longer refer to the same faces.
+  */
+  bool OptimizeFaceOrderForVertexCache(
+    unsigned int cache_size = 32
+    );
+
   /*
   Description:
     Removes and unsets all possible cached information and 
@@ -4046,7 +4372,7 @@ Returns:
 
   /*
   Description:
-    Determine if a point is inside a solid brep.
+    Determine if a point is inside a solid mesh.
   Parameters:
     test_point - [in]
     tolerance - [in] >= 0.0
@@ -4064,6 +4390,8 @@ Returns:
     The caller is responsible for making certing the mesh is
     solid before calling this function. If the mesh is not
     solid, the behavior is unpredictable.
+    The winding number of the mesh around test_point is computed
+    with rays cast through the cached MeshTree().
   See Also:
     MYON_Mesh::IsSolid()
   */
@@ -4073,6 +4401,58 @@ Returns:
           bool bStrictlyInside
           ) const;
 
+  /*
+  Description:
+    Determine which points in a list are inside a solid mesh.
+  Parameters:
+    point_count - [in]
+    points - [in]
+    tolerance - [in] >= 0.0
+    bStrictlyInside - [in]
+      Same as MYON_Mesh::IsPointInside(test_point,tolerance,bStrictlyInside).
+    bInside - [out]
+      bInside[i] is true if points[i] is inside the solid mesh.
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: test the points on the calling thread (default).
+      > 1: use at most thread_count threads.
+  Returns:
+    Number of points inside the solid mesh.
+  Remarks:
+    The caller is responsible for making certing the mesh is
+    solid before calling this function. If the mesh is not
+    solid, the behavior is unpredictable.
+  */
+  unsigned int IsPointInside(
+          size_t point_count,
+          const MYON_3dPoint* points,
+          double tolerance,
+          bool bStrictlyInside,
+          bool* bInside,
+          unsigned int thread_count = 1
+          ) const;
+
+  /*
+  Description:
+    Find the first place a ray hits the mesh.
+  Parameters:
+    P - [in]
+    D - [in]
+      The ray is P + t*D with t >= 0.
+    hit - [out]
+      If the ray hits the mesh, the hit with the smallest t.
+  Returns:
+    True if the ray hits the mesh.
+  See Also:
+    MYON_Mesh::MeshTree()
+    MYON_MeshTree::IntersectRay()
+  */
+  bool IntersectRay(
+          const MYON_3dPoint& P,
+          const MYON_3dVector& D,
+          MYON_MeshRayHit& hit
+          ) const;
+
   /*
   Description:
     Appends a list of mesh edges that begin or end at the specified
@@ -5509,6 +5889,9 @@ private:
   // cache of recently used tight bounding boxes
   mutable MYON_BoundingBoxCache m_tight_bbox_cache;
 
+  // face tree used for ray and point inclusion queries (see MeshTree())
+  mutable class MYON_MeshTree* m_mesh_tree = nullptr;
+
 protected:
 
   MYON_MeshCurvatureStats* m_kstat[4]; // gaussian,mean,min,max,sectionx,sectiony,sectionz
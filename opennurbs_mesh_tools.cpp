@@ -21,6 +21,9 @@
 #error MYON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// std::partition() and std::nth_element() are used by MYON_MeshTree::Create().
+#include <algorithm>
+
 
 /////////////////////////////////////////////////////////////////////////////
 // SwapMeshEdge()
@@ -1550,3 +1553,849 @@ int MYON_Mesh::GetConnectedComponents( bool bUseVertexConnections,
 
   return compct;
 }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// MYON_MeshTree
+//
+
+// Maximum depth of an MYON_MeshTree. Deeper nodes are leaves.
+#define MYON_MeshTree_MAX_DEPTH 64
+
+// Number of bins used to evaluate the surface area heuristic.
+#define MYON_MeshTree_BIN_COUNT 16
+
+// Nodes with more triangles than this are always split.
+#define MYON_MeshTree_MAX_LEAF_COUNT 8
+
+struct MYON_MeshTreeBuildItem
+{
+  double m_min[3];
+  double m_max[3];
+  double m_center[3];
+  int m_triangle; // index of the triangle in the unsorted list
+};
+
+struct MYON_MeshTreeBin
+{
+  double m_min[3];
+  double m_max[3];
+  int m_count;
+};
+
+static void MeshTreeEmptyBoxHelper(double a_min[3], double a_max[3])
+{
+  a_min[0] = a_min[1] = a_min[2] = MYON_DBL_MAX;
+  a_max[0] = a_max[1] = a_max[2] = -MYON_DBL_MAX;
+}
+
+static void MeshTreeGrowBoxHelper(double a_min[3], double a_max[3], const double b_min[3], const double b_max[3])
+{
+  for (int j = 0; j < 3; j++)
+  {
+    if (b_min[j] < a_min[j])
+      a_min[j] = b_min[j];
+    if (b_max[j] > a_max[j])
+      a_max[j] = b_max[j];
+  }
+}
+
+static double MeshTreeHalfAreaHelper(const double a_min[3], const double a_max[3])
+{
+  if (!(a_min[0] <= a_max[0]))
+    return 0.0;
+  const double dx = a_max[0] - a_min[0];
+  const double dy = a_max[1] - a_min[1];
+  const double dz = a_max[2] - a_min[2];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+static int MeshTreeBinHelper(double c, double c_min, double scale)
+{
+  const int b = (int)((c - c_min) * scale);
+  return (b < 0) ? 0 : ((b >= MYON_MeshTree_BIN_COUNT) ? (MYON_MeshTree_BIN_COUNT - 1) : b);
+}
+
+static void MeshTreeBuildHelper(MYON_SimpleArray<MYON_MeshTreeNode>& a_nodes, MYON_MeshTreeBuildItem* a_items, int a_begin, int a_end, int a_depth)
+{
+  const int node_index = a_nodes.Count();
+  const int count = a_end - a_begin;
+
+  double box_min[3], box_max[3], center_min[3], center_max[3];
+  MeshTreeEmptyBoxHelper(box_min, box_max);
+  MeshTreeEmptyBoxHelper(center_min, center_max);
+  for (int i = a_begin; i < a_end; i++)
+  {
+    MeshTreeGrowBoxHelper(box_min, box_max, a_items[i].m_min, a_items[i].m_max);
+    MeshTreeGrowBoxHelper(center_min, center_max, a_items[i].m_center, a_items[i].m_center);
+  }
+
+  MYON_MeshTreeNode& node = a_nodes.AppendNew();
+  memcpy(node.m_min, box_min, sizeof(node.m_min));
+  memcpy(node.m_max, box_max, sizeof(node.m_max));
+  node.m_index = a_begin;
+  node.m_count = count;
+  node.m_axis = 0;
+
+  if (count <= 1 || a_depth >= MYON_MeshTree_MAX_DEPTH)
+    return;
+
+  // Find the bin boundary with the smallest surface area heuristic cost.
+  double best_cost = MYON_DBL_MAX;
+  int best_axis = -1;
+  int best_bin = -1;
+  for (int axis = 0; axis < 3; axis++)
+  {
+    const double extent = center_max[axis] - center_min[axis];
+    if (!(extent > 0.0))
+      continue;
+    const double scale = MYON_MeshTree_BIN_COUNT / extent;
+
+    MYON_MeshTreeBin bins[MYON_MeshTree_BIN_COUNT];
+    for (int b = 0; b < MYON_MeshTree_BIN_COUNT; b++)
+    {
+      MeshTreeEmptyBoxHelper(bins[b].m_min, bins[b].m_max);
+      bins[b].m_count = 0;
+    }
+    for (int i = a_begin; i < a_end; i++)
+    {
+      MYON_MeshTreeBin& bin = bins[MeshTreeBinHelper(a_items[i].m_center[axis], center_min[axis], scale)];
+      MeshTreeGrowBoxHelper(bin.m_min, bin.m_max, a_items[i].m_min, a_items[i].m_max);
+      bin.m_count++;
+    }
+
+    // right_cost[b] = cost of the triangles in bins b, b+1, ...
+    double right_cost[MYON_MeshTree_BIN_COUNT];
+    double right_min[3], right_max[3];
+    int right_count = 0;
+    MeshTreeEmptyBoxHelper(right_min, right_max);
+    for (int b = MYON_MeshTree_BIN_COUNT - 1; b > 0; b--)
+    {
+      MeshTreeGrowBoxHelper(right_min, right_max, bins[b].m_min, bins[b].m_max);
+      right_count += bins[b].m_count;
+      right_cost[b] = right_count * MeshTreeHalfAreaHelper(right_min, right_max);
+    }
+
+    double left_min[3], left_max[3];
+    int left_count = 0;
+    MeshTreeEmptyBoxHelper(left_min, left_max);
+    for (int b = 0; b < MYON_MeshTree_BIN_COUNT - 1; b++)
+    {
+      MeshTreeGrowBoxHelper(left_min, left_max, bins[b].m_min, bins[b].m_max);
+      left_count += bins[b].m_count;
+      if (0 == left_count || count == left_count)
+        continue;
+      const double cost = left_count * MeshTreeHalfAreaHelper(left_min, left_max) + right_cost[b + 1];
+      if (cost < best_cost)
+      {
+        best_cost = cost;
+        best_axis = axis;
+        best_bin = b;
+      }
+    }
+  }
+
+  int mid;
+  if (best_axis < 0)
+  {
+    // All triangle centers are at the same place.
+    if (count <= MYON_MeshTree_MAX_LEAF_COUNT)
+      return;
+    best_axis = 0;
+    mid = a_begin + count / 2;
+  }
+  else
+  {
+    // A traversal step costs about as much as a triangle test.
+    const double area = MeshTreeHalfAreaHelper(box_min, box_max);
+    if (count <= MYON_MeshTree_MAX_LEAF_COUNT && count * area <= area + best_cost)
+      return;
+    const double c_min = center_min[best_axis];
+    const double scale = MYON_MeshTree_BIN_COUNT / (center_max[best_axis] - c_min);
+    const int axis = best_axis;
+    const int bin = best_bin;
+    mid = (int)(std::partition(a_items + a_begin, a_items + a_end,
+      [axis, bin, c_min, scale](const MYON_MeshTreeBuildItem& item) { return MeshTreeBinHelper(item.m_center[axis], c_min, scale) <= bin; }
+    ) - a_items);
+    if (mid <= a_begin || mid >= a_end)
+    {
+      mid = a_begin + count / 2;
+      std::nth_element(a_items + a_begin, a_items + mid, a_items + a_end,
+        [axis](const MYON_MeshTreeBuildItem& a, const MYON_MeshTreeBuildItem& b) { return a.m_center[axis] < b.m_center[axis]; }
+      );
+    }
+  }
+
+  // The first child is node_index+1 and the second child follows
+  // all the nodes below the first child.
+  a_nodes[node_index].m_count = 0;
+  a_nodes[node_index].m_axis = best_axis;
+  MeshTreeBuildHelper(a_nodes, a_items, a_begin, mid, a_depth + 1);
+  a_nodes[node_index].m_index = a_nodes.Count();
+  MeshTreeBuildHelper(a_nodes, a_items, mid, a_end, a_depth + 1);
+}
+
+static bool MeshTreeAddTriangleHelper(const MYON_Mesh& mesh, int fi, int ti, int vi0, int vi1, int vi2, MYON_SimpleArray<MYON_MeshTreeTriangle>& a_triangles)
+{
+  if (vi0 == vi1 || vi1 == vi2 || vi2 == vi0)
+    return false;
+  const MYON_3dPoint V[3] = { mesh.Vertex(vi0), mesh.Vertex(vi1), mesh.Vertex(vi2) };
+  if (!V[0].IsValid() || !V[1].IsValid() || !V[2].IsValid())
+    return false;
+  MYON_MeshTreeTriangle& tri = a_triangles.AppendNew();
+  for (int k = 0; k < 3; k++)
+  {
+    tri.m_V[k][0] = V[k].x;
+    tri.m_V[k][1] = V[k].y;
+    tri.m_V[k][2] = V[k].z;
+  }
+  tri.m_fi = fi;
+  tri.m_ti = ti;
+  return true;
+}
+
+bool MYON_MeshTree::Create(const MYON_Mesh& mesh)
+{
+  Destroy();
+
+  const unsigned int vertex_count = mesh.m_V.UnsignedCount();
+  const int face_count = mesh.m_F.Count();
+  MYON_SimpleArray<MYON_MeshTreeTriangle> triangles(2 * face_count);
+  for (int fi = 0; fi < face_count; fi++)
+  {
+    const MYON_MeshFace& f = mesh.m_F[fi];
+    if (!f.IsValid(vertex_count))
+      continue;
+    MeshTreeAddTriangleHelper(mesh, fi, 0, f.vi[0], f.vi[1], f.vi[2], triangles);
+    if (f.IsQuad())
+      MeshTreeAddTriangleHelper(mesh, fi, 1, f.vi[0], f.vi[2], f.vi[3], triangles);
+  }
+
+  const int triangle_count = triangles.Count();
+  if (triangle_count <= 0)
+    return false;
+
+  MYON_SimpleArray<MYON_MeshTreeBuildItem> items(triangle_count);
+  for (int i = 0; i < triangle_count; i++)
+  {
+    const MYON_MeshTreeTriangle& tri = triangles[i];
+    MYON_MeshTreeBuildItem& item = items.AppendNew();
+    MeshTreeEmptyBoxHelper(item.m_min, item.m_max);
+    for (int k = 0; k < 3; k++)
+      MeshTreeGrowBoxHelper(item.m_min, item.m_max, tri.m_V[k], tri.m_V[k]);
+    for (int j = 0; j < 3; j++)
+      item.m_center[j] = 0.5 * (item.m_min[j] + item.m_max[j]);
+    item.m_triangle = i;
+  }
+
+  m_nodes.Reserve(2 * triangle_count);
+  MeshTreeBuildHelper(m_nodes, items.Array(), 0, triangle_count, 0);
+
+  m_triangles.Reserve(triangle_count);
+  for (int i = 0; i < triangle_count; i++)
+    m_triangles.Append(triangles[items[i].m_triangle]);
+
+  return true;
+}
+
+void MYON_MeshTree::Destroy()
+{
+  m_nodes.Destroy();
+  m_triangles.Destroy();
+}
+
+unsigned int MYON_MeshTree::TriangleCount() const
+{
+  return m_triangles.UnsignedCount();
+}
+
+const MYON_MeshTreeTriangle* MYON_MeshTree::Triangles() const
+{
+  return m_triangles.Array();
+}
+
+unsigned int MYON_MeshTree::NodeCount() const
+{
+  return m_nodes.UnsignedCount();
+}
+
+const MYON_MeshTreeNode* MYON_MeshTree::Nodes() const
+{
+  return m_nodes.Array();
+}
+
+MYON_BoundingBox MYON_MeshTree::BoundingBox() const
+{
+  if (m_nodes.Count() <= 0)
+    return MYON_BoundingBox::EmptyBoundingBox;
+  const MYON_MeshTreeNode& root = m_nodes[0];
+  return MYON_BoundingBox(MYON_3dPoint(root.m_min), MYON_3dPoint(root.m_max));
+}
+
+size_t MYON_MeshTree::SizeOf() const
+{
+  return m_nodes.SizeOfArray() + m_triangles.SizeOfArray();
+}
+
+// A ray prepared for box and watertight triangle tests.
+// (Woop, Benthin and Wald, "Watertight Ray/Triangle Intersection", 2013)
+struct MYON_MeshTreeRay
+{
+  double m_P[3];
+  double m_D[3];
+  double m_invD[3];
+  int m_kx;
+  int m_ky;
+  int m_kz;
+  double m_Sx;
+  double m_Sy;
+  double m_Sz;
+};
+
+static bool MeshTreeSetRayHelper(const MYON_3dPoint& P, const MYON_3dVector& D, MYON_MeshTreeRay& ray)
+{
+  if (!P.IsValid() || !D.IsValid() || D.IsZero())
+    return false;
+  ray.m_P[0] = P.x; ray.m_P[1] = P.y; ray.m_P[2] = P.z;
+  ray.m_D[0] = D.x; ray.m_D[1] = D.y; ray.m_D[2] = D.z;
+  for (int j = 0; j < 3; j++)
+    ray.m_invD[j] = 1.0 / ray.m_D[j]; // infinite when m_D[j] = 0
+
+  // kz = dominant direction, swap kx and ky when D[kz] < 0 to 
+  // preserve the winding direction of the triangles.
+  int kz = (fabs(D.x) >= fabs(D.y)) ? 0 : 1;
+  if (fabs(D.z) > fabs(ray.m_D[kz]))
+    kz = 2;
+  int kx = (kz + 1) % 3;
+  int ky = (kx + 1) % 3;
+  if (ray.m_D[kz] < 0.0)
+  {
+    const int k = kx;
+    kx = ky;
+    ky = k;
+  }
+  ray.m_kx = kx;
+  ray.m_ky = ky;
+  ray.m_kz = kz;
+  ray.m_Sx = ray.m_D[kx] / ray.m_D[kz];
+  ray.m_Sy = ray.m_D[ky] / ray.m_D[kz];
+  ray.m_Sz = 1.0 / ray.m_D[kz];
+  return true;
+}
+
+static bool MeshTreeRayBoxHelper(const MYON_MeshTreeRay& ray, const MYON_MeshTreeNode& node, double t_max)
+{
+  double t0 = 0.0;
+  double t1 = t_max;
+  for (int j = 0; j < 3; j++)
+  {
+    double a = (node.m_min[j] - ray.m_P[j]) * ray.m_invD[j];
+    double b = (node.m_max[j] - ray.m_P[j]) * ray.m_invD[j];
+    if (a > b)
+    {
+      const double c = a;
+      a = b;
+      b = c;
+    }
+    // a or b is a nan when the ray is parallel to and on a slab 
+    // boundary and is ignored by these compares. The far distance
+    // is enlarged so rounding cannot cull a box the ray touches.
+    if (a > t0)
+      t0 = a;
+    b *= 1.0 + 4.0 * MYON_EPSILON;
+    if (b < t1)
+      t1 = b;
+  }
+  return (t0 <= t1);
+}
+
+static bool MeshTreeRayTriangleHelper(const MYON_MeshTreeRay& ray, const MYON_MeshTreeTriangle& tri, double t_max, MYON_MeshRayHit& hit)
+{
+  const int kx = ray.m_kx;
+  const int ky = ray.m_ky;
+  const int kz = ray.m_kz;
+  const double* A = tri.m_V[0];
+  const double* B = tri.m_V[1];
+  const double* C = tri.m_V[2];
+
+  // Triangle corners relative to the ray origin, sheared so the ray is the z axis.
+  const double Az = A[kz] - ray.m_P[kz];
+  const double Bz = B[kz] - ray.m_P[kz];
+  const double Cz = C[kz] - ray.m_P[kz];
+  const double Ax = (A[kx] - ray.m_P[kx]) - ray.m_Sx * Az;
+  const double Ay = (A[ky] - ray.m_P[ky]) - ray.m_Sy * Az;
+  const double Bx = (B[kx] - ray.m_P[kx]) - ray.m_Sx * Bz;
+  const double By = (B[ky] - ray.m_P[ky]) - ray.m_Sy * Bz;
+  const double Cx = (C[kx] - ray.m_P[kx]) - ray.m_Sx * Cz;
+  const double Cy = (C[ky] - ray.m_P[ky]) - ray.m_Sy * Cz;
+
+  // Scaled barycentric coordinates. A ray through a shared edge gets
+  // the same value on both sides, so it cannot pass between triangles.
+  const double U = Cx * By - Cy * Bx;
+  const double V = Ax * Cy - Ay * Cx;
+  const double W = Bx * Ay - By * Ax;
+  if ((U < 0.0 || V < 0.0 || W < 0.0) && (U > 0.0 || V > 0.0 || W > 0.0))
+    return false;
+  const double det = U + V + W;
+  if (0.0 == det)
+    return false;
+
+  const double T = ray.m_Sz * (U * Az + V * Bz + W * Cz);
+  if (det > 0.0 ? (T < 0.0 || T > t_max * det) : (T > 0.0 || T < t_max * det))
+    return false;
+
+  const double inv_det = 1.0 / det;
+  hit.m_t = T * inv_det;
+  hit.m_fi = tri.m_fi;
+  hit.m_ti = tri.m_ti;
+  hit.m_u = V * inv_det;
+  hit.m_v = W * inv_det;
+  return true;
+}
+
+static void MeshTreeNoHitHelper(MYON_MeshRayHit& hit)
+{
+  hit.m_t = MYON_UNSET_VALUE;
+  hit.m_fi = -1;
+  hit.m_ti = 0;
+  hit.m_u = 0.0;
+  hit.m_v = 0.0;
+}
+
+// Calls a_visit(tri,hit) for every triangle the ray hits until a_visit returns false.
+template <class F> static unsigned int MeshTreeVisitHitsHelper(
+  const MYON_SimpleArray<MYON_MeshTreeNode>& a_nodes,
+  const MYON_SimpleArray<MYON_MeshTreeTriangle>& a_triangles,
+  const MYON_MeshTreeRay& ray,
+  double t_max,
+  F a_visit
+  )
+{
+  unsigned int hit_count = 0;
+  if (a_nodes.Count() <= 0)
+    return 0;
+  const MYON_MeshTreeNode* nodes = a_nodes.Array();
+  const MYON_MeshTreeTriangle* triangles = a_triangles.Array();
+  int stack[MYON_MeshTree_MAX_DEPTH + 2];
+  int stack_count = 0;
+  stack[stack_count++] = 0;
+  MYON_MeshRayHit hit;
+  while (stack_count > 0)
+  {
+    const int node_index = stack[--stack_count];
+    const MYON_MeshTreeNode& node = nodes[node_index];
+    if (!MeshTreeRayBoxHelper(ray, node, t_max))
+      continue;
+    if (node.m_count > 0)
+    {
+      for (int i = node.m_index; i < node.m_index + node.m_count; i++)
+      {
+        if (MeshTreeRayTriangleHelper(ray, triangles[i], t_max, hit))
+        {
+          hit_count++;
+          if (!a_visit(triangles[i], hit))
+            return hit_count;
+        }
+      }
+    }
+    else
+    {
+      stack[stack_count++] = node.m_index;
+      stack[stack_count++] = node_index + 1;
+    }
+  }
+  return hit_count;
+}
+
+bool MYON_MeshTree::IntersectRay(
+  const MYON_3dPoint& P,
+  const MYON_3dVector& D,
+  double t_max,
+  MYON_MeshRayHit& hit
+  ) const
+{
+  MeshTreeNoHitHelper(hit);
+  MYON_MeshTreeRay ray;
+  if (m_nodes.Count() <= 0 || !(t_max >= 0.0) || !MeshTreeSetRayHelper(P, D, ray))
+    return false;
+
+  const MYON_MeshTreeNode* nodes = m_nodes.Array();
+  const MYON_MeshTreeTriangle* triangles = m_triangles.Array();
+  int stack[MYON_MeshTree_MAX_DEPTH + 2];
+  int stack_count = 0;
+  stack[stack_count++] = 0;
+  MYON_MeshRayHit tri_hit;
+  bool rc = false;
+  while (stack_count > 0)
+  {
+    const int node_index = stack[--stack_count];
+    const MYON_MeshTreeNode& node = nodes[node_index];
+    if (!MeshTreeRayBoxHelper(ray, node, t_max))
+      continue;
+    if (node.m_count > 0)
+    {
+      for (int i = node.m_index; i < node.m_index + node.m_count; i++)
+      {
+        if (MeshTreeRayTriangleHelper(ray, triangles[i], t_max, tri_hit))
+        {
+          // later hits must be closer
+          hit = tri_hit;
+          t_max = tri_hit.m_t;
+          rc = true;
+        }
+      }
+    }
+    else if (ray.m_D[node.m_axis] < 0.0)
+    {
+      // visit the second child first
+      stack[stack_count++] = node_index + 1;
+      stack[stack_count++] = node.m_index;
+    }
+    else
+    {
+      stack[stack_count++] = node.m_index;
+      stack[stack_count++] = node_index + 1;
+    }
+  }
+  return rc;
+}
+
+unsigned int MYON_MeshTree::IntersectRay(
+  const MYON_3dPoint& P,
+  const MYON_3dVector& D,
+  double t_max,
+  bool MYON_CALLBACK_CDECL resultCallback(void* a_context, const MYON_MeshRayHit& hit),
+  void* a_context
+  ) const
+{
+  MYON_MeshTreeRay ray;
+  if (nullptr == resultCallback || !(t_max >= 0.0) || !MeshTreeSetRayHelper(P, D, ray))
+    return 0;
+  return MeshTreeVisitHitsHelper(m_nodes, m_triangles, ray, t_max,
+    [resultCallback, a_context](const MYON_MeshTreeTriangle&, const MYON_MeshRayHit& hit) { return resultCallback(a_context, hit); }
+  );
+}
+
+unsigned int MYON_MeshTree::IntersectRays(
+  size_t ray_count,
+  const MYON_3dPoint* P,
+  const MYON_3dVector* D,
+  double t_max,
+  MYON_MeshRayHit* hits,
+  unsigned int thread_count
+  ) const
+{
+  if (0 == ray_count || nullptr == P || nullptr == D || nullptr == hits)
+    return 0;
+
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+
+  // Rays are handed out in blocks to threads as they need them.
+  const size_t block_size = 256;
+  const size_t block_count = (ray_count + block_size - 1) / block_size;
+  std::atomic<size_t> next_block(0);
+  std::atomic<unsigned int> hit_count(0);
+  auto intersect = [&]()
+  {
+    unsigned int block_hit_count = 0;
+    for (size_t b = next_block++; b < block_count; b = next_block++)
+    {
+      const size_t i1 = (b + 1 < block_count) ? (b + 1) * block_size : ray_count;
+      for (size_t i = b * block_size; i < i1; i++)
+      {
+        if (IntersectRay(P[i], D[i], t_max, hits[i]))
+          block_hit_count++;
+      }
+    }
+    hit_count += block_hit_count;
+  };
+
+  const size_t worker_count = ((block_count < thread_count) ? block_count : (thread_count > 0 ? thread_count : 1)) - 1;
+  MYON_SimpleArray< std::thread* > workers((int)worker_count);
+  for (size_t i = 0; i < worker_count; i++)
+  {
+    try
+    {
+      workers.Append(new std::thread(intersect));
+    }
+    catch (const std::system_error&)
+    {
+      // No more threads are available.
+      // The calling thread intersects the remaining rays.
+      break;
+    }
+  }
+  intersect();
+  for (int i = 0; i < workers.Count(); i++)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+
+  return hit_count;
+}
+
+unsigned int MYON_MeshTree::IntersectRayPacket(
+  unsigned int ray_count,
+  const MYON_3dPoint* P,
+  const MYON_3dVector* D,
+  double t_max,
+  MYON_MeshRayHit* hits
+  ) const
+{
+  if (0 == ray_count || nullptr == P || nullptr == D || nullptr == hits)
+    return 0;
+
+  if (ray_count > MYON_MeshTree_PACKET_SIZE)
+  {
+    unsigned int hit_count = 0;
+    for (unsigned int i = 0; i < ray_count; i += MYON_MeshTree_PACKET_SIZE)
+    {
+      const unsigned int packet_count = (ray_count - i < MYON_MeshTree_PACKET_SIZE) ? (ray_count - i) : MYON_MeshTree_PACKET_SIZE;
+      hit_count += IntersectRayPacket(packet_count, P + i, D + i, t_max, hits + i);
+    }
+    return hit_count;
+  }
+
+  // Bit r of a mask is set when ray r may hit triangles below a node.
+  MYON_MeshTreeRay rays[MYON_MeshTree_PACKET_SIZE];
+  double ray_t_max[MYON_MeshTree_PACKET_SIZE];
+  unsigned int active = 0;
+  for (unsigned int r = 0; r < ray_count; r++)
+  {
+    MeshTreeNoHitHelper(hits[r]);
+    ray_t_max[r] = t_max;
+    if (t_max >= 0.0 && MeshTreeSetRayHelper(P[r], D[r], rays[r]))
+      active |= (1U << r);
+  }
+  if (0 == active || m_nodes.Count() <= 0)
+    return 0;
+
+  const MYON_MeshTreeNode* nodes = m_nodes.Array();
+  const MYON_MeshTreeTriangle* triangles = m_triangles.Array();
+  int stack[MYON_MeshTree_MAX_DEPTH + 2];
+  unsigned int stack_mask[MYON_MeshTree_MAX_DEPTH + 2];
+  int stack_count = 0;
+  stack[stack_count] = 0;
+  stack_mask[stack_count++] = active;
+  MYON_MeshRayHit tri_hit;
+  while (stack_count > 0)
+  {
+    stack_count--;
+    const int node_index = stack[stack_count];
+    const MYON_MeshTreeNode& node = nodes[node_index];
+    unsigned int mask = 0;
+    for (unsigned int r = 0; r < ray_count; r++)
+    {
+      if (0 != (stack_mask[stack_count] & (1U << r)) && MeshTreeRayBoxHelper(rays[r], node, ray_t_max[r]))
+        mask |= (1U << r);
+    }
+    if (0 == mask)
+      continue;
+    if (node.m_count > 0)
+    {
+      for (int i = node.m_index; i < node.m_index + node.m_count; i++)
+      {
+        for (unsigned int r = 0; r < ray_count; r++)
+        {
+          if (0 != (mask & (1U << r)) && MeshTreeRayTriangleHelper(rays[r], triangles[i], ray_t_max[r], tri_hit))
+          {
+            hits[r] = tri_hit;
+            ray_t_max[r] = tri_hit.m_t;
+          }
+        }
+      }
+    }
+    else
+    {
+      // The first active ray decides which child is visited first.
+      unsigned int r0 = 0;
+      while (0 == (mask & (1U << r0)))
+        r0++;
+      const bool bSecondFirst = (rays[r0].m_D[node.m_axis] < 0.0);
+      stack[stack_count] = bSecondFirst ? (node_index + 1) : node.m_index;
+      stack_mask[stack_count++] = mask;
+      stack[stack_count] = bSecondFirst ? node.m_index : (node_index + 1);
+      stack_mask[stack_count++] = mask;
+    }
+  }
+
+  unsigned int hit_count = 0;
+  for (unsigned int r = 0; r < ray_count; r++)
+  {
+    if (hits[r].m_fi >= 0)
+      hit_count++;
+  }
+  return hit_count;
+}
+
+int MYON_MeshTree::WindingNumber(const MYON_3dPoint& point) const
+{
+  if (m_nodes.Count() <= 0 || !point.IsValid())
+    return 0;
+
+  // Directions are not parallel to coordinate axes or planes so
+  // rays are unlikely to run along the edges of axis aligned meshes.
+  static const double directions[][3] =
+  {
+    { 0.8391,  0.4218,  0.3436},
+    {-0.2713,  0.8920,  0.3614},
+    { 0.3352, -0.5176,  0.7871},
+    {-0.6841, -0.3012, -0.6643},
+    { 0.1637,  0.2938, -0.9418},
+    { 0.9126, -0.4019,  0.0745},
+    {-0.4507,  0.6384, -0.6239}
+  };
+  const int direction_count = (int)(sizeof(directions) / sizeof(directions[0]));
+
+  const double min_barycentric = 1.0e-10;
+  const double min_sine = 1.0e-8;
+  int windings[sizeof(directions) / sizeof(directions[0])];
+  for (int d = 0; d < direction_count; d++)
+  {
+    const MYON_3dVector D(directions[d]);
+    MYON_MeshTreeRay ray;
+    if (!MeshTreeSetRayHelper(point, D, ray))
+    {
+      windings[d] = 0;
+      continue;
+    }
+
+    int winding = 0;
+    bool bAmbiguous = false;
+    MeshTreeVisitHitsHelper(m_nodes, m_triangles, ray, MYON_DBL_MAX,
+      [&](const MYON_MeshTreeTriangle& tri, const MYON_MeshRayHit& hit)
+      {
+        const MYON_3dPoint A(tri.m_V[0]);
+        const MYON_3dVector N = MYON_CrossProduct(MYON_3dPoint(tri.m_V[1]) - A, MYON_3dPoint(tri.m_V[2]) - A);
+        const double DoN = D * N;
+        if (!(hit.m_t > 0.0)
+          || fabs(DoN) <= min_sine * D.Length() * N.Length()
+          || hit.m_u <= min_barycentric
+          || hit.m_v <= min_barycentric
+          || 1.0 - hit.m_u - hit.m_v <= min_barycentric)
+        {
+          // The ray starts on the triangle, grazes it or hits an edge 
+          // or vertex where it may be counted more than once.
+          bAmbiguous = true;
+        }
+        winding += (DoN > 0.0) ? 1 : -1;
+        return true;
+      }
+    );
+    if (!bAmbiguous)
+      return winding;
+    windings[d] = winding;
+  }
+
+  // Every ray was ambiguous. Use the most common answer.
+  int best_winding = 0;
+  int best_count = 0;
+  for (int d = 0; d < direction_count; d++)
+  {
+    int count = 0;
+    for (int e = 0; e < direction_count; e++)
+    {
+      if (windings[e] == windings[d])
+        count++;
+    }
+    if (count > best_count)
+    {
+      best_count = count;
+      best_winding = windings[d];
+    }
+  }
+  return best_winding;
+}
+
+static double MeshTreePointTriangleDistanceHelper(const MYON_3dPoint& P, const MYON_MeshTreeTriangle& tri)
+{
+  // Closest point on a triangle (Ericson, "Real-Time Collision Detection", 5.1.5).
+  const MYON_3dPoint A(tri.m_V[0]);
+  const MYON_3dPoint B(tri.m_V[1]);
+  const MYON_3dPoint C(tri.m_V[2]);
+  const MYON_3dVector AB = B - A;
+  const MYON_3dVector AC = C - A;
+  const MYON_3dVector AP = P - A;
+  const double d1 = AB * AP;
+  const double d2 = AC * AP;
+  if (d1 <= 0.0 && d2 <= 0.0)
+    return P.DistanceTo(A);
+
+  const MYON_3dVector BP = P - B;
+  const double d3 = AB * BP;
+  const double d4 = AC * BP;
+  if (d3 >= 0.0 && d4 <= d3)
+    return P.DistanceTo(B);
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return P.DistanceTo(A + (d1 / (d1 - d3)) * AB);
+
+  const MYON_3dVector CP = P - C;
+  const double d5 = AB * CP;
+  const double d6 = AC * CP;
+  if (d6 >= 0.0 && d5 <= d6)
+    return P.DistanceTo(C);
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return P.DistanceTo(A + (d2 / (d2 - d6)) * AC);
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    return P.DistanceTo(B + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (C - B));
+
+  const double denom = va + vb + vc;
+  if (!(denom > 0.0))
+  {
+    // degenerate triangle
+    const double ab = P.DistanceTo(A + (d1 / (d1 - d3)) * AB);
+    const double ac = P.DistanceTo(A + (d2 / (d2 - d6)) * AC);
+    return MYON_IsValid(ab) ? (MYON_IsValid(ac) && ac < ab ? ac : ab) : ac;
+  }
+  const double v = vb / denom;
+  const double w = vc / denom;
+  return P.DistanceTo(A + v * AB + w * AC);
+}
+
+bool MYON_MeshTree::IsNear(const MYON_3dPoint& point, double distance) const
+{
+  if (m_nodes.Count() <= 0 || !point.IsValid() || !(distance >= 0.0))
+    return false;
+
+  const MYON_MeshTreeNode* nodes = m_nodes.Array();
+  const MYON_MeshTreeTriangle* triangles = m_triangles.Array();
+  const double P[3] = { point.x, point.y, point.z };
+  int stack[MYON_MeshTree_MAX_DEPTH + 2];
+  int stack_count = 0;
+  stack[stack_count++] = 0;
+  while (stack_count > 0)
+  {
+    const int node_index = stack[--stack_count];
+    const MYON_MeshTreeNode& node = nodes[node_index];
+    double dd = 0.0;
+    for (int j = 0; j < 3; j++)
+    {
+      const double d = (P[j] < node.m_min[j]) ? (node.m_min[j] - P[j]) : ((P[j] > node.m_max[j]) ? (P[j] - node.m_max[j]) : 0.0);
+      dd += d * d;
+    }
+    if (dd > distance * distance * (1.0 + 4.0 * MYON_EPSILON))
+      continue;
+    if (node.m_count > 0)
+    {
+      for (int i = node.m_index; i < node.m_index + node.m_count; i++)
+      {
+        if (MeshTreePointTriangleDistanceHelper(point, triangles[i]) <= distance)
+          return true;
+      }
+    }
+    else
+    {
+      stack[stack_count++] = node.m_index;
+      stack[stack_count++] = node_index + 1;
+    }
+  }
+  return false;
+}
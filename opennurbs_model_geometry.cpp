@@ -41,6 +41,8 @@ bool MYON_ModelGeometryComponent::UpdateReferencedComponents(
   bool bGeometryUpdated = false;
   for (;;)
   {
+    // Deferred geometry is not created here. Geometry types that can be
+    // deferred do not reference other model components.
     MYON_Object* geometry = m_geometry_sp.get();
     if (nullptr == geometry)
     {
@@ -137,6 +139,7 @@ MYON_ModelGeometryComponent::MYON_ModelGeometryComponent(const MYON_ModelGeometr
   : MYON_ModelComponent(Internal_MYON_ModelGeometry_TypeFilter(src.ComponentType()), src)
   , m_geometry_sp(src.m_geometry_sp)
   , m_attributes_sp(src.m_attributes_sp)
+  , m_deferred_geometry_sp(src.m_deferred_geometry_sp)
 {}
 
 MYON_ModelGeometryComponent& MYON_ModelGeometryComponent::operator=(const MYON_ModelGeometryComponent& src)
@@ -148,6 +151,8 @@ MYON_ModelGeometryComponent& MYON_ModelGeometryComponent::operator=(const MYON_M
     m_geometry_sp = src.m_geometry_sp;
     m_attributes_sp.reset();
     m_attributes_sp = src.m_attributes_sp;
+    m_deferred_geometry_sp.reset();
+    m_deferred_geometry_sp = src.m_deferred_geometry_sp;
     SetComponentType(Internal_MYON_ModelGeometry_TypeFilter(src.ComponentType()));
   }
   return *this;
@@ -195,6 +200,7 @@ MYON_ModelGeometryComponent* MYON_ModelGeometryComponent::CreateForExperts(
   if ( nullptr == model_geometry_component)
     model_geometry_component = new MYON_ModelGeometryComponent(component_type);
 
+  model_geometry_component->m_deferred_geometry_sp.reset();
   model_geometry_component->m_geometry_sp
     = bManageGeometry
     ? MYON_MANAGED_SHARED_PTR(MYON_Geometry,geometry)
@@ -237,11 +243,106 @@ MYON_ModelGeometryComponent* MYON_ModelGeometryComponent::CreateManaged(
   return MYON_ModelGeometryComponent::CreateForExperts(bManageGeometry,geometry_object,bManageAttributes,object_attributes,model_geometry_component);
 }
 
+MYON_ModelGeometryComponent* MYON_ModelGeometryComponent::CreateDeferredForExperts(
+  MYON_DeferredModelGeometry* deferred_geometry,
+  MYON_3dmObjectAttributes* attributes,
+  MYON_ModelGeometryComponent* model_geometry_component
+  )
+{
+  if (nullptr == deferred_geometry)
+    return nullptr;
+
+  const bool bManageGeometry = true;
+  const bool bManageAttributes = true;
+  model_geometry_component = MYON_ModelGeometryComponent::CreateForExperts(bManageGeometry, nullptr, bManageAttributes, attributes, model_geometry_component);
+  if (nullptr != model_geometry_component)
+  {
+    model_geometry_component->SetComponentType(MYON_ModelComponent::Type::ModelGeometry);
+    model_geometry_component->m_deferred_geometry_sp = MYON_MANAGED_SHARED_PTR(MYON_DeferredModelGeometry, deferred_geometry);
+  }
+  return model_geometry_component;
+}
+
+MYON_ModelGeometryComponent* MYON_ModelGeometryComponent::CreateSharedForExperts(
+  const std::shared_ptr<MYON_Geometry>& geometry_sp,
+  MYON_3dmObjectAttributes* attributes,
+  MYON_ModelGeometryComponent* model_geometry_component
+  )
+{
+  if (nullptr == geometry_sp.get() || nullptr != MYON_Light::Cast(geometry_sp.get()))
+    return nullptr;
+
+  const bool bManageGeometry = true;
+  const bool bManageAttributes = true;
+  model_geometry_component = MYON_ModelGeometryComponent::CreateForExperts(bManageGeometry, nullptr, bManageAttributes, attributes, model_geometry_component);
+  if (nullptr != model_geometry_component)
+  {
+    model_geometry_component->SetComponentType(MYON_ModelComponent::Type::ModelGeometry);
+    model_geometry_component->m_geometry_sp = geometry_sp;
+  }
+  return model_geometry_component;
+}
+
+bool MYON_ModelGeometryComponent::GeometryIsDeferred() const
+{
+  return
+    nullptr == m_geometry_sp.get()
+    && nullptr != m_deferred_geometry_sp.get()
+    && false == m_deferred_geometry_sp->GeometryIsCreated();
+}
+
+MYON_BoundingBox MYON_ModelGeometryComponent::GeometryBoundingBox() const
+{
+  const MYON_Geometry* geometry = m_geometry_sp.get();
+  if (nullptr != geometry)
+    return geometry->BoundingBox();
+  if (nullptr != m_deferred_geometry_sp.get())
+    return m_deferred_geometry_sp->BoundingBox();
+  return MYON_BoundingBox::UnsetBoundingBox;
+}
+
+MYON_DeferredModelGeometry::~MYON_DeferredModelGeometry()
+{
+  // This destructor is explictily implemented to insure m_geometry_sp 
+  // is destroyed by the same c-runtime that creates it.
+}
+
+bool MYON_DeferredModelGeometry::GeometryIsCreated() const
+{
+  return m_bGeometryCreated;
+}
+
+MYON_BoundingBox MYON_DeferredModelGeometry::BoundingBox() const
+{
+  // The geometry is created on the first request and kept for Geometry().
+  const MYON_Geometry* geometry = const_cast<MYON_DeferredModelGeometry*>(this)->Internal_GeometrySharedPtr().get();
+  return (nullptr != geometry) ? geometry->BoundingBox() : MYON_BoundingBox::UnsetBoundingBox;
+}
+
+const std::shared_ptr<MYON_Geometry>& MYON_DeferredModelGeometry::Internal_GeometrySharedPtr()
+{
+  if (false == m_bGeometryCreated)
+  {
+    // Geometry() may be called from multiple threads at the same time.
+    m_sleep_lock.GetLock(MYON_SleepLock::OneMillisecond, 0);
+    if (false == m_bGeometryCreated)
+    {
+      MYON_Geometry* geometry = Internal_CreateGeometry();
+      if (nullptr != geometry)
+        m_geometry_sp = MYON_MANAGED_SHARED_PTR(MYON_Geometry, geometry);
+      m_bGeometryCreated = true;
+    }
+    m_sleep_lock.ReturnLock();
+  }
+  return m_geometry_sp;
+}
+
 #if defined(MYON_HAS_RVALUEREF)
 MYON_ModelGeometryComponent::MYON_ModelGeometryComponent( MYON_ModelGeometryComponent&& src) MYON_NOEXCEPT
   : MYON_ModelComponent(std::move(src))
   , m_geometry_sp(std::move(src.m_geometry_sp))
   , m_attributes_sp(std::move(src.m_attributes_sp))
+  , m_deferred_geometry_sp(std::move(src.m_deferred_geometry_sp))
 {}
 
 MYON_ModelGeometryComponent& MYON_ModelGeometryComponent::operator=(MYON_ModelGeometryComponent&& src)
@@ -250,9 +351,11 @@ MYON_ModelGeometryComponent& MYON_ModelGeometryComponent::operator=(MYON_ModelGe
   {
     m_geometry_sp.reset();
     m_attributes_sp.reset();
+    m_deferred_geometry_sp.reset();
     MYON_ModelComponent::operator=(std::move(src));
     m_geometry_sp = std::move(src.m_geometry_sp);
     m_attributes_sp = std::move(src.m_attributes_sp);
+    m_deferred_geometry_sp = std::move(src.m_deferred_geometry_sp);
   }
   return *this;
 }
@@ -260,12 +363,12 @@ MYON_ModelGeometryComponent& MYON_ModelGeometryComponent::operator=(MYON_ModelGe
 
 bool MYON_ModelGeometryComponent::IsEmpty() const
 {
-  return (nullptr == m_geometry_sp.get());
+  return (nullptr == m_geometry_sp.get() && nullptr == m_deferred_geometry_sp.get());
 }
 
 bool MYON_ModelGeometryComponent::IsInstanceDefinitionGeometry() const
 {
-  if (nullptr != m_geometry_sp.get())
+  if (false == IsEmpty())
   {
     const MYON_3dmObjectAttributes* attributes = m_attributes_sp.get();
     return (nullptr != attributes && attributes->IsInstanceDefinitionObject() );
@@ -279,6 +382,8 @@ const MYON_Geometry* MYON_ModelGeometryComponent::Geometry(
   ) const
 {
   const MYON_Geometry* ptr = m_geometry_sp.get();
+  if (nullptr == ptr && nullptr != m_deferred_geometry_sp.get())
+    ptr = m_deferred_geometry_sp->Internal_GeometrySharedPtr().get();
   return (nullptr != ptr) ? ptr : no_geometry_return_value;
 }
 
@@ -292,6 +397,16 @@ const MYON_3dmObjectAttributes* MYON_ModelGeometryComponent::Attributes(
 
 MYON_Geometry* MYON_ModelGeometryComponent::ExclusiveGeometry() const
 {
+  if (nullptr == m_geometry_sp.get() && nullptr != m_deferred_geometry_sp.get())
+  {
+    if (1 != m_deferred_geometry_sp.use_count())
+      return nullptr;
+    const std::shared_ptr<MYON_Geometry>& geometry_sp = m_deferred_geometry_sp->Internal_GeometrySharedPtr();
+    return
+      (1 == geometry_sp.use_count())
+      ? geometry_sp.get()
+      : nullptr;
+  }
   return
     (1 == m_geometry_sp.use_count())
     ? m_geometry_sp.get()
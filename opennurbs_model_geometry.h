@@ -14,6 +14,69 @@
 #if !defined(MYON_MODEL_GEOMETRY_INC_)
 #define MYON_MODEL_GEOMETRY_INC_
 
+/*
+Description:
+  MYON_DeferredModelGeometry creates the geometry of an MYON_ModelGeometryComponent
+  the first time the geometry is requested. MYONX_Model uses it to read model 
+  geometry on demand.
+See Also:
+  MYON_ModelGeometryComponent::CreateDeferredForExperts()
+  MYONX_Model::SetDeferGeometryReading()
+*/
+class MYON_CLASS MYON_DeferredModelGeometry
+{
+public:
+  MYON_DeferredModelGeometry() = default;
+  virtual ~MYON_DeferredModelGeometry();
+
+private:
+  MYON_DeferredModelGeometry(const MYON_DeferredModelGeometry&) = delete;
+  MYON_DeferredModelGeometry& operator=(const MYON_DeferredModelGeometry&) = delete;
+
+public:
+  /*
+  Returns:
+    True if Internal_CreateGeometry() has been called.
+  */
+  bool GeometryIsCreated() const;
+
+  /*
+  Returns:
+    The bounding box of the geometry or MYON_BoundingBox::UnsetBoundingBox
+    if the geometry cannot be created.
+  Remarks:
+    The geometry is created the first time this function or 
+    MYON_ModelGeometryComponent::Geometry() is called and is kept, so it
+    is decoded only one time.
+  */
+  MYON_BoundingBox BoundingBox() const;
+
+protected:
+  /*
+  Description:
+    Called one time, the first time the geometry is requested.
+  Returns:
+    Geometry created by operator new or nullptr if the geometry
+    cannot be created. MYON_DeferredModelGeometry manages the returned
+    geometry and will eventually delete it.
+  */
+  virtual class MYON_Geometry* Internal_CreateGeometry() = 0;
+
+private:
+  friend class MYON_ModelGeometryComponent;
+  const std::shared_ptr<MYON_Geometry>& Internal_GeometrySharedPtr();
+
+  MYON_SleepLock m_sleep_lock;
+
+#pragma MYON_PRAGMA_WARNING_PUSH
+#pragma MYON_PRAGMA_WARNING_DISABLE_MSC( 4251 ) 
+  // C4251: ... needs to have dll-interface to be used by clients of class ...
+  // m_bGeometryCreated and m_geometry_sp are private and all code that manages them is explicitly implemented in the DLL.
+  std::atomic<bool> m_bGeometryCreated = false;
+  std::shared_ptr<MYON_Geometry> m_geometry_sp;
+#pragma MYON_PRAGMA_WARNING_POP
+};
+
 /*
 Description:
   Used to store geometry table object definition and attributes in an MYONX_Model.
@@ -133,6 +196,67 @@ public:
     MYON_ModelGeometryComponent* model_geometry_component
     );
 
+  /*
+  Description:
+    Create a model geometry component whose geometry is created the first
+    time Geometry() or ExclusiveGeometry() is called.
+  Parameters:
+    deferred_geometry - [in]
+      deferred_geometry was created on the heap using operator new and 
+      is managed by the returned MYON_ModelGeometryComponent and its copies.
+    attributes - [in]
+      attributes is nullptr or was created on the heap using operator new
+      and the MYON_ModelGeometryComponent destructor will delete attributes.
+    model_geometry_component - [in]
+      If not nullptr, this class is set. Otherwise operator new allocates
+      an MYON_ModelGeometryComponent class.
+  Remarks:
+    The deferred geometry must not be a light. ComponentType() returns
+    MYON_ModelComponent::Type::ModelGeometry.
+  */
+  static MYON_ModelGeometryComponent* CreateDeferredForExperts(
+    class MYON_DeferredModelGeometry* deferred_geometry,
+    class MYON_3dmObjectAttributes* attributes,
+    MYON_ModelGeometryComponent* model_geometry_component
+    );
+
+  /*
+  Description:
+    Create a model geometry component that shares geometry with other 
+    components. MYON_BinaryArchive uses this when several object table 
+    records reference the same geometry (see MYON_BinaryArchive::SetDeduplicateGeometry()).
+  Parameters:
+    geometry_sp - [in]
+      The geometry must not be a light.
+      ExclusiveGeometry() returns nullptr while the geometry is shared.
+    attributes - [in]
+      attributes is nullptr or was created on the heap using operator new
+      and the MYON_ModelGeometryComponent destructor will delete attributes.
+    model_geometry_component - [in]
+      If not nullptr, this class is set. Otherwise operator new allocates
+      an MYON_ModelGeometryComponent class.
+  */
+  static MYON_ModelGeometryComponent* CreateSharedForExperts(
+    const std::shared_ptr<class MYON_Geometry>& geometry_sp,
+    class MYON_3dmObjectAttributes* attributes,
+    MYON_ModelGeometryComponent* model_geometry_component
+    );
+
+  /*
+  Returns:
+    True if the geometry will be created the first time it is requested.
+    False if the geometry is set, has been created, or was never set.
+  */
+  bool GeometryIsDeferred() const;
+
+  /*
+  Returns:
+    The bounding box of the geometry. When the geometry is deferred,
+    it is created the first time it or its bounding box is requested.
+    MYON_BoundingBox::UnsetBoundingBox is returned if there is no geometry.
+  */
+  MYON_BoundingBox GeometryBoundingBox() const;
+
   /*
   Description:
     Get a pointer to geometry. The returned pointer may be shared
@@ -237,6 +361,9 @@ private:
   std::shared_ptr<MYON_Geometry> m_geometry_sp;
 private:
   std::shared_ptr<MYON_3dmObjectAttributes> m_attributes_sp;
+private:
+  // When m_geometry_sp is empty, m_deferred_geometry_sp creates the geometry on demand.
+  std::shared_ptr<MYON_DeferredModelGeometry> m_deferred_geometry_sp;
 #pragma MYON_PRAGMA_WARNING_POP
 };
 
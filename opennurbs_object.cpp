@@ -589,6 +589,272 @@ void MYON::End()
 {
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//
+// MYON_ClassIdHashTable
+//
+//   Open addressing hash tables that index the MYON_ClassId linked list
+//   by class name and by class uuid. The tables are built the first
+//   time MYON_ClassId::ClassId() is called. A published table is never
+//   modified or deleted while the program runs because lookups read it
+//   without locking. When class ids are constructed or removed by
+//   MYON_ClassId::Purge() / PurgeAfter(), the current table is retired
+//   and a later lookup builds a new one from the list. Retired tables
+//   are deleted when the program exits. While class ids are being
+//   registered, for example during static initialization, lookups use
+//   the linear search until a few lookups have been made with no
+//   changes to the list, so a table is not built for every new class id.
+//   When a name or uuid appears more than once in the list, the table
+//   keeps the first one so lookups return what the linear search did.
+//
+
+class MYON_ClassIdHashTable
+{
+public:
+  MYON_ClassIdHashTable() = default;
+  ~MYON_ClassIdHashTable();
+
+  static const MYON_ClassIdHashTable* Table();
+  static void ClassIdAdded(const MYON_ClassId* class_id);
+  static void ClassIdsRemoved();
+  static void DeleteTables();
+
+  const MYON_ClassId* FindName(const char* sClassName) const;
+  const MYON_ClassId* FindUuid(const MYON_UUID& class_uuid) const;
+
+private:
+  MYON_ClassIdHashTable(const MYON_ClassIdHashTable&) = delete;
+  MYON_ClassIdHashTable& operator=(const MYON_ClassIdHashTable&) = delete;
+
+  static unsigned int NameHash(const char* sClassName);
+  static unsigned int UuidHash(const MYON_UUID& class_uuid);
+
+  bool Reserve(unsigned int class_id_count);
+  bool Add(const MYON_ClassId* class_id);
+
+  // Caller must hold m_table_mutex.
+  static void Internal_RetireTable();
+
+  // m_capacity is a power of 2 and m_count <= m_capacity/2
+  unsigned int m_capacity = 0;
+  unsigned int m_count = 0;
+  const MYON_ClassId** m_name_slots = nullptr;
+  const MYON_ClassId** m_uuid_slots = nullptr;
+
+  // next table in the m_retired list
+  MYON_ClassIdHashTable* m_next_retired = nullptr;
+
+  // All are constant initialized so lookups made while other class ids
+  // are being constructed during static initialization are safe.
+  static std::atomic<MYON_ClassIdHashTable*> m_table;
+  static std::mutex m_table_mutex;
+  static MYON_ClassIdHashTable* m_retired;
+  static std::atomic<unsigned int> m_lookups_since_change;
+
+public:
+  // MYON_ClassId::SetUseHashTablesForExperts()
+  static std::atomic<bool> m_use_tables;
+};
+
+std::atomic<MYON_ClassIdHashTable*> MYON_ClassIdHashTable::m_table(nullptr);
+std::mutex MYON_ClassIdHashTable::m_table_mutex;
+MYON_ClassIdHashTable* MYON_ClassIdHashTable::m_retired = nullptr;
+std::atomic<unsigned int> MYON_ClassIdHashTable::m_lookups_since_change(0);
+std::atomic<bool> MYON_ClassIdHashTable::m_use_tables(true);
+
+class MYON_ClassIdHashTableCleanup
+{
+public:
+  MYON_ClassIdHashTableCleanup() = default;
+  ~MYON_ClassIdHashTableCleanup()
+  {
+    MYON_ClassIdHashTable::DeleteTables();
+  }
+};
+
+static MYON_ClassIdHashTableCleanup MYON_ClassIdHashTableCleanup_atexit;
+
+MYON_ClassIdHashTable::~MYON_ClassIdHashTable()
+{
+  delete[] m_name_slots;
+  delete[] m_uuid_slots;
+}
+
+unsigned int MYON_ClassIdHashTable::NameHash(const char* sClassName)
+{
+  // FNV-1a
+  MYON__UINT32 h = 2166136261U;
+  for (const char* s = sClassName; 0 != *s; s++)
+  {
+    h ^= (unsigned char)(*s);
+    h *= 16777619U;
+  }
+  return h;
+}
+
+unsigned int MYON_ClassIdHashTable::UuidHash(const MYON_UUID& class_uuid)
+{
+  // Class uuids are random enough that a simple mix is sufficient.
+  MYON__UINT32 h = class_uuid.Data1;
+  h ^= ((MYON__UINT32)class_uuid.Data2 << 16) | (MYON__UINT32)class_uuid.Data3;
+  for (int i = 0; i < 8; i++)
+    h = (h ^ class_uuid.Data4[i]) * 16777619U;
+  return h ^ (h >> 15);
+}
+
+bool MYON_ClassIdHashTable::Reserve(unsigned int class_id_count)
+{
+  unsigned int capacity = 64;
+  while (capacity < 2 * class_id_count)
+    capacity *= 2;
+  m_name_slots = new (std::nothrow) const MYON_ClassId*[capacity];
+  m_uuid_slots = new (std::nothrow) const MYON_ClassId*[capacity];
+  if (nullptr == m_name_slots || nullptr == m_uuid_slots)
+    return false;
+  memset(m_name_slots, 0, capacity * sizeof(m_name_slots[0]));
+  memset(m_uuid_slots, 0, capacity * sizeof(m_uuid_slots[0]));
+  m_capacity = capacity;
+  m_count = 0;
+  return true;
+}
+
+bool MYON_ClassIdHashTable::Add(const MYON_ClassId* class_id)
+{
+  if (nullptr == class_id)
+    return true;
+  if (2 * (m_count + 1) > m_capacity)
+    return false;
+
+  const unsigned int mask = m_capacity - 1;
+  if (0 != class_id->m_sClassName[0])
+  {
+    for (unsigned int i = NameHash(class_id->m_sClassName) & mask; /*empty test*/; i = (i + 1) & mask)
+    {
+      if (nullptr == m_name_slots[i])
+      {
+        m_name_slots[i] = class_id;
+        break;
+      }
+      if (0 == strcmp(m_name_slots[i]->m_sClassName, class_id->m_sClassName))
+        break; // keep the first class id with this name
+    }
+  }
+
+  for (unsigned int i = UuidHash(class_id->m_uuid) & mask; /*empty test*/; i = (i + 1) & mask)
+  {
+    if (nullptr == m_uuid_slots[i])
+    {
+      m_uuid_slots[i] = class_id;
+      break;
+    }
+    if (m_uuid_slots[i]->m_uuid == class_id->m_uuid)
+      break; // keep the first class id with this uuid
+  }
+
+  m_count++;
+  return true;
+}
+
+const MYON_ClassIdHashTable* MYON_ClassIdHashTable::Table()
+{
+  if (false == m_use_tables.load(std::memory_order_relaxed))
+    return nullptr;
+
+  MYON_ClassIdHashTable* table = m_table.load(std::memory_order_acquire);
+  if (nullptr != table)
+    return table;
+
+  // The caller uses the linear search until the list of class ids
+  // has stopped changing.
+  if (m_lookups_since_change.fetch_add(1, std::memory_order_relaxed) < 32)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(m_table_mutex);
+  table = m_table.load(std::memory_order_relaxed);
+  if (nullptr == table)
+  {
+    unsigned int class_id_count = 0;
+    for (const MYON_ClassId* p = MYON_ClassId::m_p0; nullptr != p; p = p->m_pNext)
+      class_id_count++;
+    table = new (std::nothrow) MYON_ClassIdHashTable();
+    if (nullptr != table && table->Reserve(class_id_count))
+    {
+      for (const MYON_ClassId* p = MYON_ClassId::m_p0; nullptr != p; p = p->m_pNext)
+        table->Add(p);
+      m_table.store(table, std::memory_order_release);
+    }
+    else
+    {
+      delete table;
+      table = nullptr;
+    }
+  }
+  return table;
+}
+
+void MYON_ClassIdHashTable::Internal_RetireTable()
+{
+  MYON_ClassIdHashTable* table = m_table.load(std::memory_order_relaxed);
+  if (nullptr != table)
+  {
+    // Other threads may still be searching table, so it is kept
+    // until DeleteTables() is called when the program exits.
+    m_table.store(nullptr, std::memory_order_release);
+    table->m_next_retired = m_retired;
+    m_retired = table;
+  }
+}
+
+void MYON_ClassIdHashTable::ClassIdAdded(const MYON_ClassId* class_id)
+{
+  if (nullptr == class_id)
+    return;
+  std::lock_guard<std::mutex> lock(m_table_mutex);
+  Internal_RetireTable();
+  m_lookups_since_change.store(0, std::memory_order_relaxed);
+}
+
+void MYON_ClassIdHashTable::ClassIdsRemoved()
+{
+  std::lock_guard<std::mutex> lock(m_table_mutex);
+  Internal_RetireTable();
+  m_lookups_since_change.store(0, std::memory_order_relaxed);
+}
+
+void MYON_ClassIdHashTable::DeleteTables()
+{
+  std::lock_guard<std::mutex> lock(m_table_mutex);
+  Internal_RetireTable();
+  while (nullptr != m_retired)
+  {
+    MYON_ClassIdHashTable* table = m_retired;
+    m_retired = table->m_next_retired;
+    delete table;
+  }
+}
+
+const MYON_ClassId* MYON_ClassIdHashTable::FindName(const char* sClassName) const
+{
+  const unsigned int mask = m_capacity - 1;
+  for (unsigned int i = NameHash(sClassName) & mask; nullptr != m_name_slots[i]; i = (i + 1) & mask)
+  {
+    if (0 == strcmp(m_name_slots[i]->m_sClassName, sClassName))
+      return m_name_slots[i];
+  }
+  return nullptr;
+}
+
+const MYON_ClassId* MYON_ClassIdHashTable::FindUuid(const MYON_UUID& class_uuid) const
+{
+  const unsigned int mask = m_capacity - 1;
+  for (unsigned int i = UuidHash(class_uuid) & mask; nullptr != m_uuid_slots[i]; i = (i + 1) & mask)
+  {
+    if (m_uuid_slots[i]->m_uuid == class_uuid)
+      return m_uuid_slots[i];
+  }
+  return nullptr;
+}
+
 int MYON_ClassId::CurrentMark()
 {
   return m_mark0;
@@ -622,6 +888,8 @@ int MYON_ClassId::Purge( int mark_value )
       else
         prev = p;
     }
+    if ( purge_count > 0 )
+      MYON_ClassIdHashTable::ClassIdsRemoved();
   }
   return purge_count;
 }
@@ -645,6 +913,7 @@ bool MYON_ClassId::PurgeAfter(const MYON_ClassId* pClassId)
       // be bad.
       p->m_pNext = 0;
       m_p1 = p;
+      MYON_ClassIdHashTable::ClassIdsRemoved();
       return true;
     }
   }
@@ -827,6 +1096,8 @@ void MYON_ClassId::ConstructorHelper( const char* sClassName,
   }
   m_p1 = this;
   m_p1->m_pNext = 0;
+
+  MYON_ClassIdHashTable::ClassIdAdded(this);
 }
 
 MYON_ClassId::~MYON_ClassId()
@@ -848,15 +1119,31 @@ MYON_Object* MYON_ClassId::Create() const
   return m_create ? m_create() : 0;
 }
 
+bool MYON_ClassId::SetUseHashTablesForExperts(bool bUseHashTables)
+{
+  return MYON_ClassIdHashTable::m_use_tables.exchange(bUseHashTables);
+}
+
+bool MYON_ClassId::UseHashTablesForExperts()
+{
+  return MYON_ClassIdHashTable::m_use_tables.load();
+}
+
 const MYON_ClassId* MYON_ClassId::ClassId( const char* sClassName )
 {
   // static member function
   // search list of class ids for one with a matching class name
+  if ( !sClassName || !sClassName[0] || sClassName[0] == '0' )
+    return nullptr;
+
+  const MYON_ClassIdHashTable* table = MYON_ClassIdHashTable::Table();
+  if ( nullptr != table )
+    return table->FindName(sClassName);
+
+  // the hash table is not available - use a linear search
   MYON_ClassId* p;
   const char* s0;
   const char* s1;
-  if ( !sClassName || !sClassName[0] || sClassName[0] == '0' )
-    return nullptr;
   for(p = m_p0; p; p = p->m_pNext) {
     // avoid strcmp() because it crashes on nullptr strings
     s0 = sClassName;
@@ -879,11 +1166,18 @@ const MYON_ClassId* MYON_ClassId::ClassId( MYON_UUID uuid )
 {
   // static member function
   // search list of class ids for one with a matching typecode
-  const MYON_ClassId* p;
-  for(p = m_p0; p; p = p->m_pNext) 
+  const MYON_ClassId* p = nullptr;
+  const MYON_ClassIdHashTable* table = MYON_ClassIdHashTable::Table();
+  if ( nullptr != table )
+    p = table->FindUuid(uuid);
+  else
   {
-    if ( !MYON_UuidCompare(&p->m_uuid,&uuid) )
-      break;
+    // the hash table is not available - use a linear search
+    for(p = m_p0; p; p = p->m_pNext) 
+    {
+      if ( !MYON_UuidCompare(&p->m_uuid,&uuid) )
+        break;
+    }
   }
 
   if ( nullptr == p && false == g_bDisableDemotion) 
@@ -85,6 +85,29 @@ public:
           MYON_UUID class_uuid
           );
 
+  /*
+  Description:
+    Expert user function used to measure class id lookups.
+    ClassId() normally searches hash tables built from the list of
+    class ids. When the hash tables are disabled, ClassId() searches
+    the list one class id at a time.
+  Parameters:
+    bUseHashTables - [in]
+      true: (default) ClassId() uses the hash tables.
+      false: ClassId() uses the linear search.
+  Returns:
+    The previous setting.
+  */
+  static bool SetUseHashTablesForExperts(
+    bool bUseHashTables
+    );
+
+  /*
+  Returns:
+    True if ClassId() uses hash tables. See SetUseHashTablesForExperts().
+  */
+  static bool UseHashTablesForExperts();
+
   // Description:
   //   Each class derived from MYON_Object has a corresponding MYON_ClassId
   //   stored in a linked list and the class is marked with an integer
@@ -204,6 +227,10 @@ private:
           const char* sUUID
           );
 
+  // MYON_ClassIdHashTable indexes the linked list of class ids by
+  // name and uuid so ClassId() lookups do not walk the list.
+  friend class MYON_ClassIdHashTable;
+
   // The m_f[] pointers provide a way add a "virtual" function to
   // a class derived from MYON_Object without breaking the SDK.
   // At each SDK breaking release, any functions that use this
@@ -21,6 +21,10 @@
 #error MYON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// std::nth_element() is used by MYON_RTree::CreatePacked() and 
+// std::push_heap() is used by MYON_RTree::SearchNearest().
+#include <algorithm>
+
 // Dimension of tree bounding boxes
 #define MYON_RTree_NODE_DIM 3
 
@@ -513,6 +517,7 @@ bool MYON_RTree::CreateMeshFaceTree( const MYON_Mesh* mesh )
   const MYON_MeshFace* meshF;
   const MYON_3fPoint* meshfV;
   const MYON_3dPoint* meshdV;
+  MYON_RTreeLeaf* leaf;
 
   RemoveAll();
 
@@ -533,6 +538,10 @@ bool MYON_RTree::CreateMeshFaceTree( const MYON_Mesh* mesh )
          ? mesh->DoublePrecisionVertices().Array() 
          : 0;
 
+  // The face boxes are collected and packed into a tree. This is faster
+  // than inserting one face at a time and the tree is faster to search.
+  MYON_SimpleArray<MYON_RTreeLeaf> leaves(fcount);
+
   if ( 0 != meshfV )
   {
     if ( 0 != meshdV )
@@ -580,11 +589,10 @@ bool MYON_RTree::CreateMeshFaceTree( const MYON_Mesh* mesh )
           if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;  
         }
 
-        if ( !Insert(fmin,fmax,fi) )
-        {
-          RemoveAll();
-          return false;
-        }
+        leaf = &leaves.AppendNew();
+        memcpy(leaf->m_rect.m_min,fmin,sizeof(leaf->m_rect.m_min));
+        memcpy(leaf->m_rect.m_max,fmax,sizeof(leaf->m_rect.m_max));
+        leaf->m_id = fi;
       }
     }
     else
@@ -616,11 +624,10 @@ bool MYON_RTree::CreateMeshFaceTree( const MYON_Mesh* mesh )
           if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;      
         }
 
-        if ( !Insert(fmin,fmax,fi) )
-        {
-          RemoveAll();
-          return false;
-        }
+        leaf = &leaves.AppendNew();
+        memcpy(leaf->m_rect.m_min,fmin,sizeof(leaf->m_rect.m_min));
+        memcpy(leaf->m_rect.m_max,fmax,sizeof(leaf->m_rect.m_max));
+        leaf->m_id = fi;
       }
     }
   }
@@ -653,11 +660,10 @@ bool MYON_RTree::CreateMeshFaceTree( const MYON_Mesh* mesh )
         if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;      
       }
 
-      if ( !Insert(fmin,fmax,fi) )
-      {
-        RemoveAll();
-        return false;
-      }
+      leaf = &leaves.AppendNew();
+      memcpy(leaf->m_rect.m_min,fmin,sizeof(leaf->m_rect.m_min));
+      memcpy(leaf->m_rect.m_max,fmax,sizeof(leaf->m_rect.m_max));
+      leaf->m_id = fi;
     }
   }
   else
@@ -666,7 +672,197 @@ bool MYON_RTree::CreateMeshFaceTree( const MYON_Mesh* mesh )
     return false;
   }
 
-  return (0 != m_root);
+  return CreatePacked(leaves.Array(), leaves.UnsignedCount(), 1);
+}
+
+static double PackCenterHelper(const MYON_RTreeBranch& a_branch, int a_axis)
+{
+  return a_branch.m_rect.m_min[a_axis] + a_branch.m_rect.m_max[a_axis];
+}
+
+static void PackPartitionHelper(MYON_RTreeBranch* a_branch, size_t a_count, int a_axis, size_t a_slice0, size_t a_slice1, size_t a_slice_count)
+{
+  // Partitions a_branch[] so that every element in slice s has a center 
+  // coordinate <= every element in slice s+1. Slice s is the elements
+  // from a_count*s/a_slice_count to a_count*(s+1)/a_slice_count.
+  if (a_slice1 - a_slice0 <= 1)
+    return;
+  const size_t slice = (a_slice0 + a_slice1) / 2;
+  const size_t i0 = a_count * a_slice0 / a_slice_count;
+  const size_t i = a_count * slice / a_slice_count;
+  const size_t i1 = a_count * a_slice1 / a_slice_count;
+  std::nth_element(a_branch + i0, a_branch + i, a_branch + i1,
+    [a_axis](const MYON_RTreeBranch& a, const MYON_RTreeBranch& b) { return PackCenterHelper(a, a_axis) < PackCenterHelper(b, a_axis); }
+  );
+  PackPartitionHelper(a_branch, a_count, a_axis, a_slice0, slice, a_slice_count);
+  PackPartitionHelper(a_branch, a_count, a_axis, slice, a_slice1, a_slice_count);
+}
+
+static size_t PackSliceCountHelper(size_t a_count, int a_axis, size_t a_node_capacity)
+{
+  // Sort-tile-recursive: the elements are split into node_count^(1/3) 
+  // slabs along x, each slab is split into node_count^(1/2) runs along y,
+  // and each run is split into nodes along z.
+  const size_t node_count = (a_count + a_node_capacity - 1) / a_node_capacity;
+  size_t slice_count = node_count;
+  if (a_axis < MYON_RTree_NODE_DIM - 1)
+  {
+    slice_count = (size_t)ceil(pow((double)node_count, 1.0 / ((double)(MYON_RTree_NODE_DIM - a_axis))));
+    if (slice_count > node_count)
+      slice_count = node_count;
+  }
+  return (slice_count > 1) ? slice_count : 1;
+}
+
+static void PackHelper(MYON_RTreeBranch* a_branch, size_t a_count, int a_axis, size_t a_node_capacity, MYON_SimpleArray<int>& a_node_sizes)
+{
+  // Reorders a_branch[] and appends the sizes of the nodes that pack it.
+  // The slices are as equal as possible, so when a_count > a_node_capacity, 
+  // every node gets at least a_node_capacity/2 branches. For example,
+  // 9 branches with a node capacity of 8 are packed as 4 + 5.
+  if (a_count <= a_node_capacity)
+  {
+    if (a_count > 0)
+      a_node_sizes.Append((int)a_count);
+    return;
+  }
+  const size_t slice_count = PackSliceCountHelper(a_count, a_axis, a_node_capacity);
+  PackPartitionHelper(a_branch, a_count, a_axis, 0, slice_count, slice_count);
+  for (size_t s = 0; s < slice_count; s++)
+  {
+    const size_t i0 = a_count * s / slice_count;
+    const size_t i1 = a_count * (s + 1) / slice_count;
+    if (a_axis < MYON_RTree_NODE_DIM - 1)
+      PackHelper(a_branch + i0, i1 - i0, a_axis + 1, a_node_capacity, a_node_sizes);
+    else if (i1 > i0)
+      a_node_sizes.Append((int)(i1 - i0));
+  }
+}
+
+static void PackLevelHelper(MYON_RTreeBranch* a_branch, size_t a_count, size_t a_node_capacity, unsigned int a_thread_count, MYON_SimpleArray<int>& a_node_sizes)
+{
+  a_node_sizes.SetCount(0);
+  const size_t slab_count = PackSliceCountHelper(a_count, 0, a_node_capacity);
+  if (a_thread_count <= 1 || slab_count <= 1 || a_count <= 4096)
+  {
+    PackHelper(a_branch, a_count, 0, a_node_capacity, a_node_sizes);
+    return;
+  }
+
+  // The x slabs are packed independently on a_thread_count threads.
+  PackPartitionHelper(a_branch, a_count, 0, 0, slab_count, slab_count);
+  MYON_ClassArray< MYON_SimpleArray<int> > slab_node_sizes((int)slab_count);
+  slab_node_sizes.SetCount((int)slab_count);
+  std::atomic<size_t> next_slab(0);
+  auto pack = [&]()
+  {
+    for (size_t s = next_slab++; s < slab_count; s = next_slab++)
+    {
+      const size_t i0 = a_count * s / slab_count;
+      const size_t i1 = a_count * (s + 1) / slab_count;
+      PackHelper(a_branch + i0, i1 - i0, 1, a_node_capacity, slab_node_sizes[(int)s]);
+    }
+  };
+
+  const size_t worker_count = ((slab_count < a_thread_count) ? slab_count : a_thread_count) - 1;
+  MYON_SimpleArray< std::thread* > workers((int)worker_count);
+  for (size_t i = 0; i < worker_count; i++)
+  {
+    try
+    {
+      workers.Append(new std::thread(pack));
+    }
+    catch (const std::system_error&)
+    {
+      // No more threads are available.
+      // The calling thread packs the remaining slabs.
+      break;
+    }
+  }
+  pack();
+  for (int i = 0; i < workers.Count(); i++)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+
+  for (size_t s = 0; s < slab_count; s++)
+    a_node_sizes.Append(slab_node_sizes[(int)s].Count(), slab_node_sizes[(int)s].Array());
+}
+
+static bool PackLeavesHelper(const MYON_RTreeLeaf* a_leaves, size_t a_leaf_count, MYON_SimpleArray<MYON_RTreeBranch>& a_branches)
+{
+  a_branches.SetCount(0);
+  a_branches.Reserve(a_leaf_count);
+  for (size_t i = 0; i < a_leaf_count; i++)
+  {
+    const MYON_RTreeBBox& rect = a_leaves[i].m_rect;
+    if (!(rect.m_min[0] <= rect.m_max[0] && rect.m_min[1] <= rect.m_max[1] && rect.m_min[2] <= rect.m_max[2]))
+      return false;
+    MYON_RTreeBranch& branch = a_branches.AppendNew();
+    branch.m_rect = rect;
+    branch.m_id = a_leaves[i].m_id;
+  }
+  return true;
+}
+
+bool MYON_RTree::CreatePacked(
+  const MYON_RTreeLeaf* leaves,
+  size_t leaf_count,
+  unsigned int thread_count
+  )
+{
+  RemoveAll();
+
+  if (nullptr == leaves || 0 == leaf_count || leaf_count > 0x7FFFFFFF)
+    return false;
+
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+
+  MYON_SimpleArray<MYON_RTreeBranch> branches;
+  if (!PackLeavesHelper(leaves, leaf_count, branches))
+  {
+    // invalid bounding box - don't let this corrupt the tree
+    MYON_ERROR("MYON_RTree::CreatePacked - invalid leaves[].m_rect.");
+    return false;
+  }
+
+  // Each pass packs the branches of one level into nodes and the
+  // branches of the next level up point to those nodes.
+  MYON_SimpleArray<MYON_RTreeBranch> parents;
+  MYON_SimpleArray<int> node_sizes;
+  for (int level = 0; /*empty test*/; level++)
+  {
+    PackLevelHelper(branches.Array(), branches.UnsignedCount(), MYON_RTree_MAX_NODE_COUNT, thread_count, node_sizes);
+    parents.SetCount(0);
+    parents.Reserve(node_sizes.UnsignedCount());
+    const MYON_RTreeBranch* branch = branches.Array();
+    for (int i = 0; i < node_sizes.Count(); i++)
+    {
+      MYON_RTreeNode* node = m_mem_pool.AllocNode();
+      if (nullptr == node)
+      {
+        RemoveAll();
+        return false;
+      }
+      node->m_level = level;
+      node->m_count = node_sizes[i];
+      memcpy(node->m_branch, branch, node->m_count * sizeof(node->m_branch[0]));
+      branch += node->m_count;
+      MYON_RTreeBranch& parent = parents.AppendNew();
+      parent.m_rect = NodeCover(node);
+      parent.m_child = node;
+    }
+    if (1 == parents.Count())
+    {
+      m_root = parents[0].m_child;
+      break;
+    }
+    branches = std::move(parents);
+  }
+
+  return true;
 }
 
 
@@ -691,16 +887,18 @@ bool MYON_SubDRTree::CreateSubDVertexRTree(
 
   MYON_SubDVertexIterator vit(m_subd);
 
+  MYON_SimpleArray<MYON_RTreeLeaf> leaves(vit.VertexCount());
   for (const MYON_SubDVertex* v = vit.FirstVertex(); nullptr != v; v = vit.NextVertex())
   {
     const MYON_3dPoint P = v->Point(vertex_location);
-    if (false == this->Insert(&P.x, &P.x, (void*)v))
-    {
-      this->RemoveAll();
-      return false;
-    }
+    MYON_RTreeLeaf& leaf = leaves.AppendNew();
+    memcpy(leaf.m_rect.m_min, &P.x, sizeof(leaf.m_rect.m_min));
+    memcpy(leaf.m_rect.m_max, &P.x, sizeof(leaf.m_rect.m_max));
+    leaf.m_id = (MYON__INT_PTR)v;
   }
-  return (nullptr != this->Root());
+
+  // CreatePacked() fails and leaves the tree empty when a point is not valid.
+  return this->CreatePacked(leaves.Array(), leaves.UnsignedCount(), 1);
 }
 
 bool MYON_SubDRTree::AddVertex(
@@ -1532,6 +1730,189 @@ bool MYON_RTree::Search(
   return true;
 }
 
+// A unit of work for the parallel pair searches. When m_nodeA and m_nodeB 
+// are both set the pair of nodes is searched, when one of them is nullptr
+// the corresponding branch is searched against the other node, and when
+// both are nullptr the overlapping leaf pair (m_branchA,m_branchB) is 
+// the result.
+struct MYON_RTreePairSearchTask
+{
+  const MYON_RTreeNode* m_nodeA;
+  const MYON_RTreeNode* m_nodeB;
+  const MYON_RTreeBranch* m_branchA;
+  const MYON_RTreeBranch* m_branchB;
+};
+
+static void PairSearchTaskHelper(MYON_SimpleArray<MYON_RTreePairSearchTask>& a_tasks, const MYON_RTreeNode* a_nodeA, const MYON_RTreeNode* a_nodeB, const MYON_RTreeBranch* a_branchA, const MYON_RTreeBranch* a_branchB)
+{
+  MYON_RTreePairSearchTask& task = a_tasks.AppendNew();
+  task.m_nodeA = a_nodeA;
+  task.m_nodeB = a_nodeB;
+  task.m_branchA = a_branchA;
+  task.m_branchB = a_branchB;
+}
+
+static void PairSearchExpandHelper(const MYON_RTreeNode* a_nodeA, const MYON_RTreeNode* a_nodeB, bool bSingleTree, double a_tolerance, MYON_SimpleArray<MYON_RTreePairSearchTask>& a_tasks)
+{
+  // Appends the tasks PairSearchHelper(a_nodeA,a_nodeB,...) or 
+  // SingleTreeSearchHelper(a_nodeA,a_nodeB,...) would recurse into,
+  // in the order they would be visited.
+  const MYON_RTreeBranch *branchA, *branchAmax, *branchB, *branchBmax;
+  branchAmax = a_nodeA->m_branch + a_nodeA->m_count;
+  branchBmax = a_nodeB->m_branch + a_nodeB->m_count;
+  for (branchA = a_nodeA->m_branch; branchA < branchAmax; branchA++)
+  {
+    for (branchB = a_nodeB->m_branch; branchB < branchBmax; branchB++)
+    {
+      if (a_nodeA->m_level <= 0 && a_nodeB->m_level <= 0 && bSingleTree && !(branchA < branchB))
+        continue;
+      if (!PairSearchOverlapHelper(&branchA->m_rect, &branchB->m_rect, a_tolerance))
+        continue;
+      if (a_nodeA->m_level > 0)
+      {
+        if (a_nodeB->m_level > 0)
+          PairSearchTaskHelper(a_tasks, branchA->m_child, branchB->m_child, nullptr, nullptr);
+        else
+          PairSearchTaskHelper(a_tasks, branchA->m_child, nullptr, nullptr, branchB);
+      }
+      else if (a_nodeB->m_level > 0)
+        PairSearchTaskHelper(a_tasks, nullptr, branchB->m_child, branchA, nullptr);
+      else
+        PairSearchTaskHelper(a_tasks, nullptr, nullptr, branchA, branchB);
+    }
+  }
+}
+
+static void SingleTreeSearchHelper(const MYON_RTreeBranch* a_branchA, const MYON_RTreeNode* a_nodeB, MYON_RTreePairSearchResult* a_result);
+static void SingleTreeSearchHelper(const MYON_RTreeNode* a_nodeA, const MYON_RTreeBranch* a_branchB, MYON_RTreePairSearchResult* a_result);
+static void SingleTreeSearchHelper(const MYON_RTreeNode* a_nodeA, const MYON_RTreeNode* a_nodeB, MYON_RTreePairSearchResult* a_result);
+
+static void PairSearchParallelHelper(const MYON_RTreeNode* a_rootA, const MYON_RTreeNode* a_rootB, bool bSingleTree, double a_tolerance, unsigned int a_thread_count, MYON_SimpleArray<MYON_2dex>& a_result)
+{
+  // Expand the top of the traversal until there are enough tasks to keep
+  // a_thread_count threads busy. Each expansion replaces a node pair with
+  // the pairs the recursive search visits next, so the tasks stay in
+  // the order of the single threaded search.
+  const int min_task_count = 64 * (int)a_thread_count;
+  MYON_SimpleArray<MYON_RTreePairSearchTask> tasks;
+  MYON_SimpleArray<MYON_RTreePairSearchTask> expanded;
+  PairSearchTaskHelper(tasks, a_rootA, a_rootB, nullptr, nullptr);
+  while (tasks.Count() > 0 && tasks.Count() < min_task_count)
+  {
+    bool bExpanded = false;
+    expanded.SetCount(0);
+    for (int i = 0; i < tasks.Count(); i++)
+    {
+      const MYON_RTreePairSearchTask& task = tasks[i];
+      if (nullptr != task.m_nodeA && nullptr != task.m_nodeB)
+      {
+        PairSearchExpandHelper(task.m_nodeA, task.m_nodeB, bSingleTree, a_tolerance, expanded);
+        bExpanded = true;
+      }
+      else
+        expanded.Append(task);
+    }
+    tasks = std::move(expanded);
+    if (!bExpanded)
+      break;
+  }
+
+  // Each task writes to its own result buffer. The buffers are appended
+  // to a_result in task order so the results are the same for any
+  // number of threads.
+  const int task_count = tasks.Count();
+  MYON_ClassArray< MYON_SimpleArray<MYON_2dex> > task_results(task_count);
+  task_results.SetCount(task_count);
+  std::atomic<int> next_task(0);
+  auto search = [&]()
+  {
+    MYON_RTreePairSearchResult r;
+    r.m_tolerance = a_tolerance;
+    for (int i = next_task++; i < task_count; i = next_task++)
+    {
+      const MYON_RTreePairSearchTask& task = tasks[i];
+      r.m_result = &task_results[i];
+      if (nullptr != task.m_nodeA)
+      {
+        if (nullptr != task.m_nodeB)
+        {
+          if (bSingleTree)
+            SingleTreeSearchHelper(task.m_nodeA, task.m_nodeB, &r);
+          else
+            PairSearchHelper(task.m_nodeA, task.m_nodeB, &r);
+        }
+        else if (bSingleTree)
+          SingleTreeSearchHelper(task.m_nodeA, task.m_branchB, &r);
+        else
+          PairSearchHelper(task.m_nodeA, task.m_branchB, &r);
+      }
+      else if (nullptr != task.m_nodeB)
+      {
+        if (bSingleTree)
+          SingleTreeSearchHelper(task.m_branchA, task.m_nodeB, &r);
+        else
+          PairSearchHelper(task.m_branchA, task.m_nodeB, &r);
+      }
+      else
+      {
+        MYON_2dex& pair = r.m_result->AppendNew();
+        pair.i = (int)task.m_branchA->m_id;
+        pair.j = (int)task.m_branchB->m_id;
+      }
+    }
+  };
+
+  const int worker_count = ((task_count < (int)a_thread_count) ? task_count : (int)a_thread_count) - 1;
+  MYON_SimpleArray< std::thread* > workers(worker_count > 0 ? worker_count : 0);
+  for (int i = 0; i < worker_count; i++)
+  {
+    try
+    {
+      workers.Append(new std::thread(search));
+    }
+    catch (const std::system_error&)
+    {
+      // No more threads are available.
+      // The calling thread searches the remaining tasks.
+      break;
+    }
+  }
+  search();
+  for (int i = 0; i < workers.Count(); i++)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+
+  size_t result_count = 0;
+  for (int i = 0; i < task_count; i++)
+    result_count += task_results[i].UnsignedCount();
+  a_result.Reserve(a_result.UnsignedCount() + result_count);
+  for (int i = 0; i < task_count; i++)
+    a_result.Append(task_results[i].Count(), task_results[i].Array());
+}
+
+bool MYON_RTree::Search(
+          const MYON_RTree& a_rtreeA,
+          const MYON_RTree& a_rtreeB,
+          double tolerance,
+          unsigned int thread_count,
+          MYON_SimpleArray<MYON_2dex>& a_result
+          )
+{
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+  if (thread_count <= 1)
+    return MYON_RTree::Search(a_rtreeA, a_rtreeB, tolerance, a_result);
+  if (0 == a_rtreeA.m_root)
+    return false;
+  if (0 == a_rtreeB.m_root)
+    return false;
+  tolerance = (MYON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  PairSearchParallelHelper(a_rtreeA.m_root, a_rtreeB.m_root, false, tolerance, thread_count, a_result);
+  return true;
+}
+
 typedef void (*MYON_RTreePairSearchCallback)(void*, MYON__INT_PTR, MYON__INT_PTR);
 
 struct MYON_RTreePairSearchCallbackResult
@@ -2143,6 +2524,23 @@ bool MYON_RTree::Search(
   return true;
 }
 
+bool MYON_RTree::Search(
+  double tolerance,
+  unsigned int thread_count,
+  MYON_SimpleArray<MYON_2dex>& a_result
+  ) const
+{
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+  if (thread_count <= 1)
+    return Search(tolerance, a_result);
+  if (0 == this->m_root)
+    return false;
+  tolerance = (MYON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  PairSearchParallelHelper(this->m_root, this->m_root, true, tolerance, thread_count, a_result);
+  return true;
+}
+
 static void SingleTreeSearchHelper(const MYON_RTreeBranch* a_branchA, const MYON_RTreeNode* a_nodeB, MYON_RTreePairSearchCallbackResult* a_result)
 {
   // DO NOT ADD ANYTHING TO THIS FUNCTION
@@ -3890,6 +4288,152 @@ bool MYON_RTree::Search(
   return SearchBoundedPlaneXYZHelper(m_root, bounded_plane, result);
 }
 
+// An entry in the MYON_RTree::SearchNearest() priority queue.
+struct MYON_RTreeNearestHeapItem
+{
+  double m_distance2;  // squared distance from the search point
+  const MYON_RTreeNode* m_node; // node to search or nullptr for an element
+  MYON__INT_PTR m_id;  // element id when m_node is nullptr
+  bool m_bExact;       // true when m_distance2 is the exact element distance
+
+  // std::push_heap() makes a max heap, so the comparison is reversed
+  // to make the closest item the top of the heap.
+  bool operator<(const MYON_RTreeNearestHeapItem& other) const
+  {
+    return m_distance2 > other.m_distance2;
+  }
+};
+
+static double DistanceToBoxSquaredHelper(const double* a_point, const MYON_RTreeBBox* a_rect)
+{
+  double dd = 0.0;
+  for (int j = 0; j < MYON_RTree_NODE_DIM; j++)
+  {
+    double d;
+    if (a_point[j] < a_rect->m_min[j])
+      d = a_rect->m_min[j] - a_point[j];
+    else if (a_point[j] > a_rect->m_max[j])
+      d = a_point[j] - a_rect->m_max[j];
+    else
+      continue;
+    dd += d * d;
+  }
+  return dd;
+}
+
+unsigned int MYON_RTree::SearchNearest(
+  const double a_point[3],
+  unsigned int k,
+  double a_max_distance,
+  double MYON_CALLBACK_CDECL distanceCallback(void* a_context, const double a_point[3], MYON__INT_PTR a_id),
+  void* a_context,
+  MYON_SimpleArray<MYON_RTreeNearestElement>& a_result
+  ) const
+{
+  if (    0 == m_root 
+       || m_root->m_count <= 0
+       || 0 == a_point
+       || 0 == k
+       || !(a_max_distance >= 0.0)
+     )
+    return 0;
+
+  const double max_distance2 
+    = (a_max_distance < sqrt(MYON_DBL_MAX)) 
+    ? a_max_distance * a_max_distance 
+    : MYON_DBL_MAX;
+
+  MYON_SimpleArray<MYON_RTreeNearestHeapItem> heap(64);
+  MYON_RTreeNearestHeapItem item;
+  item.m_distance2 = 0.0;
+  item.m_node = m_root;
+  item.m_id = 0;
+  item.m_bExact = false;
+  heap.Append(item);
+
+  unsigned int found_count = 0;
+  while (heap.Count() > 0 && found_count < k)
+  {
+    std::pop_heap(heap.Array(), heap.Array() + heap.Count());
+    item = *heap.Last();
+    heap.Remove();
+
+    if (item.m_distance2 > max_distance2)
+      break; // everything left in the heap is farther away
+
+    if (nullptr == item.m_node)
+    {
+      if (false == item.m_bExact && nullptr != distanceCallback)
+      {
+        // The element is closer than anything else in the heap.
+        // Get its exact distance and put it back in the heap.
+        const double d = distanceCallback(a_context, a_point, item.m_id);
+        if (!(d >= 0.0) || d > a_max_distance)
+          continue; // skip this element
+        item.m_distance2 = d * d;
+        item.m_bExact = true;
+        heap.Append(item);
+        std::push_heap(heap.Array(), heap.Array() + heap.Count());
+        continue;
+      }
+
+      MYON_RTreeNearestElement& nearest = a_result.AppendNew();
+      nearest.m_id = item.m_id;
+      nearest.m_distance = sqrt(item.m_distance2);
+      found_count++;
+      continue;
+    }
+
+    const MYON_RTreeNode* node = item.m_node;
+    for (int i = 0; i < node->m_count; i++)
+    {
+      const MYON_RTreeBranch& branch = node->m_branch[i];
+      item.m_distance2 = DistanceToBoxSquaredHelper(a_point, &branch.m_rect);
+      if (item.m_distance2 > max_distance2)
+        continue;
+      if (node->IsInternalNode())
+      {
+        item.m_node = branch.m_child;
+        item.m_id = 0;
+      }
+      else
+      {
+        item.m_node = nullptr;
+        item.m_id = branch.m_id;
+      }
+      item.m_bExact = false;
+      heap.Append(item);
+      std::push_heap(heap.Array(), heap.Array() + heap.Count());
+    }
+  }
+
+  return found_count;
+}
+
+unsigned int MYON_RTree::SearchNearest(
+  const double a_point[3],
+  unsigned int k,
+  MYON_SimpleArray<MYON_RTreeNearestElement>& a_result
+  ) const
+{
+  return SearchNearest(a_point, k, MYON_DBL_MAX, nullptr, nullptr, a_result);
+}
+
+bool MYON_RTree::SearchNearest(
+  const double a_point[3],
+  double a_max_distance,
+  double MYON_CALLBACK_CDECL distanceCallback(void* a_context, const double a_point[3], MYON__INT_PTR a_id),
+  void* a_context,
+  MYON_RTreeNearestElement& a_nearest
+  ) const
+{
+  MYON_SimpleArray<MYON_RTreeNearestElement> result(1);
+  if (1 != SearchNearest(a_point, 1, a_max_distance, distanceCallback, a_context, result))
+    return false;
+  a_nearest = result[0];
+  return true;
+}
+
 // Search in an index tree or subtree for all data retangles that overlap the argument rectangle.
 
 static
@@ -4378,3 +4922,709 @@ bool SearchHelper(const MYON_RTreeNode* a_node, const MYON_RTreeBBox* a_rect, MY
   return true; // Continue searching
 }
 
+
+////////////////////////////////////////////////////////////////
+//
+// MYON_RTreeFlat
+//
+// Each query type has a scalar, an AVX2 and a NEON function that 
+// returns a bit mask of the children of a node whose boxes pass the
+// query test. The three versions perform the same operations, so the
+// results do not depend on the instruction set. The AVX2 version is 
+// used when the processor supports it; this is tested at runtime.
+//
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(MYON_COMPILER_MSC) || defined(MYON_COMPILER_CLANG) || defined(MYON_COMPILER_GNU))
+#define MYON_RTREE_FLAT_AVX2
+#if defined(MYON_COMPILER_MSC)
+#include <intrin.h>
+#define MYON_RTREE_FLAT_AVX2_TARGET
+#else
+#include <immintrin.h>
+#include <cpuid.h>
+#define MYON_RTREE_FLAT_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64))
+#define MYON_RTREE_FLAT_NEON
+#if defined(MYON_COMPILER_MSC)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+struct MYON_RTreeFlatBoxQuery
+{
+  double m_min[3];
+  double m_max[3];
+};
+
+struct MYON_RTreeFlatSphereQuery
+{
+  double m_point[3];
+  double m_radius2; // radius squared
+};
+
+struct MYON_RTreeFlatLineQuery
+{
+  double m_P[3];    // line start
+  double m_inv[3];  // 1/(line direction) when m_bParallel[] is false
+  bool m_bParallel[3]; // true when the line direction coordinate is zero
+  double m_t[2];    // line parameter interval
+};
+
+struct MYON_RTreeFlatPlaneQuery
+{
+  double m_eqn[4];
+  double m_min;
+  double m_max;
+};
+
+static unsigned int FlatMaskScalarHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatBoxQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i++)
+  {
+    if (   a_node.m_min[0][i] <= a_q.m_max[0] && a_node.m_max[0][i] >= a_q.m_min[0]
+        && a_node.m_min[1][i] <= a_q.m_max[1] && a_node.m_max[1][i] >= a_q.m_min[1]
+        && a_node.m_min[2][i] <= a_q.m_max[2] && a_node.m_max[2][i] >= a_q.m_min[2]
+       )
+      mask |= (1U << i);
+  }
+  return mask;
+}
+
+static unsigned int FlatMaskScalarHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatSphereQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i++)
+  {
+    double dd = 0.0;
+    for (int j = 0; j < 3; j++)
+    {
+      const double a = a_node.m_min[j][i] - a_q.m_point[j];
+      const double b = a_q.m_point[j] - a_node.m_max[j][i];
+      const double d = (a > 0.0 ? a : 0.0) + (b > 0.0 ? b : 0.0);
+      dd += d * d;
+    }
+    if (dd <= a_q.m_radius2)
+      mask |= (1U << i);
+  }
+  return mask;
+}
+
+static unsigned int FlatMaskScalarHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatLineQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i++)
+  {
+    bool bOverlap = true;
+    double t0 = a_q.m_t[0];
+    double t1 = a_q.m_t[1];
+    for (int j = 0; j < 3 && bOverlap; j++)
+    {
+      if (a_q.m_bParallel[j])
+      {
+        bOverlap = (a_node.m_min[j][i] <= a_q.m_P[j] && a_q.m_P[j] <= a_node.m_max[j][i]);
+      }
+      else
+      {
+        const double a = (a_node.m_min[j][i] - a_q.m_P[j]) * a_q.m_inv[j];
+        const double b = (a_node.m_max[j][i] - a_q.m_P[j]) * a_q.m_inv[j];
+        if (a < b)
+        {
+          if (a > t0) t0 = a;
+          if (b < t1) t1 = b;
+        }
+        else
+        {
+          if (b > t0) t0 = b;
+          if (a < t1) t1 = a;
+        }
+        bOverlap = (t0 <= t1);
+      }
+    }
+    if (bOverlap)
+      mask |= (1U << i);
+  }
+  return mask;
+}
+
+static unsigned int FlatMaskScalarHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatPlaneQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i++)
+  {
+    double lo = a_q.m_eqn[3];
+    double hi = a_q.m_eqn[3];
+    for (int j = 0; j < 3; j++)
+    {
+      const double c = a_q.m_eqn[j];
+      if (c >= 0.0)
+      {
+        lo += c * a_node.m_min[j][i];
+        hi += c * a_node.m_max[j][i];
+      }
+      else
+      {
+        lo += c * a_node.m_max[j][i];
+        hi += c * a_node.m_min[j][i];
+      }
+    }
+    if (lo <= a_q.m_max && hi >= a_q.m_min)
+      mask |= (1U << i);
+  }
+  return mask;
+}
+
+#if defined(MYON_RTREE_FLAT_AVX2)
+
+static bool FlatHasAVX2Helper()
+{
+  // CPUID leaf 1 ECX bit 27 = OSXSAVE, bit 28 = AVX
+  // CPUID leaf 7 EBX bit 5 = AVX2
+  // XCR0 bits 1 and 2 = the operating system saves SSE and AVX state
+  unsigned int ecx1 = 0, ebx7 = 0;
+#if defined(MYON_COMPILER_MSC)
+  int info[4] = {};
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  __cpuid(info, 1);
+  ecx1 = (unsigned int)info[2];
+  if (max_leaf >= 7)
+  {
+    __cpuidex(info, 7, 0);
+    ebx7 = (unsigned int)info[1];
+  }
+#else
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (0 == __get_cpuid(1, &eax, &ebx, &ecx1, &edx))
+    ecx1 = 0;
+  if (0 == __get_cpuid_count(7, 0, &eax, &ebx7, &ecx, &edx))
+    ebx7 = 0;
+#endif
+  if (0 == (ecx1 & (1u << 27)) || 0 == (ecx1 & (1u << 28)) || 0 == (ebx7 & (1u << 5)))
+    return false;
+#if defined(MYON_COMPILER_MSC)
+  const unsigned long long xcr0 = _xgetbv(0);
+#else
+  unsigned int xcr0_lo = 0, xcr0_hi = 0;
+  __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+  const unsigned long long xcr0 = ((unsigned long long)xcr0_hi << 32) | xcr0_lo;
+#endif
+  return (6 == (xcr0 & 6));
+}
+
+static bool FlatUseAVX2Helper()
+{
+  static const bool bHasAVX2 = FlatHasAVX2Helper();
+  return bHasAVX2;
+}
+
+MYON_RTREE_FLAT_AVX2_TARGET
+static unsigned int FlatMaskAVX2Helper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatBoxQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 4)
+  {
+    __m256d m = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    for (int j = 0; j < 3; j++)
+    {
+      m = _mm256_and_pd(m, _mm256_cmp_pd(_mm256_loadu_pd(&a_node.m_min[j][i]), _mm256_set1_pd(a_q.m_max[j]), _CMP_LE_OQ));
+      m = _mm256_and_pd(m, _mm256_cmp_pd(_mm256_loadu_pd(&a_node.m_max[j][i]), _mm256_set1_pd(a_q.m_min[j]), _CMP_GE_OQ));
+    }
+    mask |= ((unsigned int)_mm256_movemask_pd(m)) << i;
+  }
+  return mask;
+}
+
+MYON_RTREE_FLAT_AVX2_TARGET
+static unsigned int FlatMaskAVX2Helper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatSphereQuery& a_q)
+{
+  unsigned int mask = 0;
+  const __m256d zero = _mm256_setzero_pd();
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 4)
+  {
+    __m256d dd = zero;
+    for (int j = 0; j < 3; j++)
+    {
+      const __m256d p = _mm256_set1_pd(a_q.m_point[j]);
+      const __m256d a = _mm256_sub_pd(_mm256_loadu_pd(&a_node.m_min[j][i]), p);
+      const __m256d b = _mm256_sub_pd(p, _mm256_loadu_pd(&a_node.m_max[j][i]));
+      const __m256d d = _mm256_add_pd(_mm256_max_pd(a, zero), _mm256_max_pd(b, zero));
+      dd = _mm256_add_pd(dd, _mm256_mul_pd(d, d));
+    }
+    mask |= ((unsigned int)_mm256_movemask_pd(_mm256_cmp_pd(dd, _mm256_set1_pd(a_q.m_radius2), _CMP_LE_OQ))) << i;
+  }
+  return mask;
+}
+
+MYON_RTREE_FLAT_AVX2_TARGET
+static unsigned int FlatMaskAVX2Helper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatLineQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 4)
+  {
+    __m256d m = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    __m256d t0 = _mm256_set1_pd(a_q.m_t[0]);
+    __m256d t1 = _mm256_set1_pd(a_q.m_t[1]);
+    for (int j = 0; j < 3; j++)
+    {
+      const __m256d p = _mm256_set1_pd(a_q.m_P[j]);
+      const __m256d mn = _mm256_loadu_pd(&a_node.m_min[j][i]);
+      const __m256d mx = _mm256_loadu_pd(&a_node.m_max[j][i]);
+      if (a_q.m_bParallel[j])
+      {
+        m = _mm256_and_pd(m, _mm256_cmp_pd(mn, p, _CMP_LE_OQ));
+        m = _mm256_and_pd(m, _mm256_cmp_pd(p, mx, _CMP_LE_OQ));
+      }
+      else
+      {
+        const __m256d inv = _mm256_set1_pd(a_q.m_inv[j]);
+        const __m256d a = _mm256_mul_pd(_mm256_sub_pd(mn, p), inv);
+        const __m256d b = _mm256_mul_pd(_mm256_sub_pd(mx, p), inv);
+        t0 = _mm256_max_pd(t0, _mm256_min_pd(a, b));
+        t1 = _mm256_min_pd(t1, _mm256_max_pd(a, b));
+      }
+    }
+    m = _mm256_and_pd(m, _mm256_cmp_pd(t0, t1, _CMP_LE_OQ));
+    mask |= ((unsigned int)_mm256_movemask_pd(m)) << i;
+  }
+  return mask;
+}
+
+MYON_RTREE_FLAT_AVX2_TARGET
+static unsigned int FlatMaskAVX2Helper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatPlaneQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 4)
+  {
+    __m256d lo = _mm256_set1_pd(a_q.m_eqn[3]);
+    __m256d hi = lo;
+    for (int j = 0; j < 3; j++)
+    {
+      const __m256d c = _mm256_set1_pd(a_q.m_eqn[j]);
+      const __m256d mn = _mm256_loadu_pd(&a_node.m_min[j][i]);
+      const __m256d mx = _mm256_loadu_pd(&a_node.m_max[j][i]);
+      if (a_q.m_eqn[j] >= 0.0)
+      {
+        lo = _mm256_add_pd(lo, _mm256_mul_pd(c, mn));
+        hi = _mm256_add_pd(hi, _mm256_mul_pd(c, mx));
+      }
+      else
+      {
+        lo = _mm256_add_pd(lo, _mm256_mul_pd(c, mx));
+        hi = _mm256_add_pd(hi, _mm256_mul_pd(c, mn));
+      }
+    }
+    const __m256d m = _mm256_and_pd(
+      _mm256_cmp_pd(lo, _mm256_set1_pd(a_q.m_max), _CMP_LE_OQ),
+      _mm256_cmp_pd(hi, _mm256_set1_pd(a_q.m_min), _CMP_GE_OQ)
+    );
+    mask |= ((unsigned int)_mm256_movemask_pd(m)) << i;
+  }
+  return mask;
+}
+
+#endif
+
+#if defined(MYON_RTREE_FLAT_NEON)
+
+static unsigned int FlatMovemaskNEONHelper(uint64x2_t m)
+{
+  return (unsigned int)((vgetq_lane_u64(m, 0) & 1) | ((vgetq_lane_u64(m, 1) & 1) << 1));
+}
+
+static unsigned int FlatMaskNEONHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatBoxQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 2)
+  {
+    uint64x2_t m = vdupq_n_u64(~((uint64_t)0));
+    for (int j = 0; j < 3; j++)
+    {
+      m = vandq_u64(m, vcleq_f64(vld1q_f64(&a_node.m_min[j][i]), vdupq_n_f64(a_q.m_max[j])));
+      m = vandq_u64(m, vcgeq_f64(vld1q_f64(&a_node.m_max[j][i]), vdupq_n_f64(a_q.m_min[j])));
+    }
+    mask |= FlatMovemaskNEONHelper(m) << i;
+  }
+  return mask;
+}
+
+static unsigned int FlatMaskNEONHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatSphereQuery& a_q)
+{
+  unsigned int mask = 0;
+  const float64x2_t zero = vdupq_n_f64(0.0);
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 2)
+  {
+    float64x2_t dd = zero;
+    for (int j = 0; j < 3; j++)
+    {
+      const float64x2_t p = vdupq_n_f64(a_q.m_point[j]);
+      const float64x2_t a = vsubq_f64(vld1q_f64(&a_node.m_min[j][i]), p);
+      const float64x2_t b = vsubq_f64(p, vld1q_f64(&a_node.m_max[j][i]));
+      const float64x2_t d = vaddq_f64(vmaxq_f64(a, zero), vmaxq_f64(b, zero));
+      dd = vaddq_f64(dd, vmulq_f64(d, d));
+    }
+    mask |= FlatMovemaskNEONHelper(vcleq_f64(dd, vdupq_n_f64(a_q.m_radius2))) << i;
+  }
+  return mask;
+}
+
+static unsigned int FlatMaskNEONHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatLineQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 2)
+  {
+    uint64x2_t m = vdupq_n_u64(~((uint64_t)0));
+    float64x2_t t0 = vdupq_n_f64(a_q.m_t[0]);
+    float64x2_t t1 = vdupq_n_f64(a_q.m_t[1]);
+    for (int j = 0; j < 3; j++)
+    {
+      const float64x2_t p = vdupq_n_f64(a_q.m_P[j]);
+      const float64x2_t mn = vld1q_f64(&a_node.m_min[j][i]);
+      const float64x2_t mx = vld1q_f64(&a_node.m_max[j][i]);
+      if (a_q.m_bParallel[j])
+      {
+        m = vandq_u64(m, vcleq_f64(mn, p));
+        m = vandq_u64(m, vcleq_f64(p, mx));
+      }
+      else
+      {
+        const float64x2_t inv = vdupq_n_f64(a_q.m_inv[j]);
+        const float64x2_t a = vmulq_f64(vsubq_f64(mn, p), inv);
+        const float64x2_t b = vmulq_f64(vsubq_f64(mx, p), inv);
+        t0 = vmaxq_f64(t0, vminq_f64(a, b));
+        t1 = vminq_f64(t1, vmaxq_f64(a, b));
+      }
+    }
+    m = vandq_u64(m, vcleq_f64(t0, t1));
+    mask |= FlatMovemaskNEONHelper(m) << i;
+  }
+  return mask;
+}
+
+static unsigned int FlatMaskNEONHelper(const MYON_RTreeFlatNode& a_node, const MYON_RTreeFlatPlaneQuery& a_q)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < MYON_RTreeFlat_NODE_COUNT; i += 2)
+  {
+    float64x2_t lo = vdupq_n_f64(a_q.m_eqn[3]);
+    float64x2_t hi = lo;
+    for (int j = 0; j < 3; j++)
+    {
+      const float64x2_t c = vdupq_n_f64(a_q.m_eqn[j]);
+      const float64x2_t mn = vld1q_f64(&a_node.m_min[j][i]);
+      const float64x2_t mx = vld1q_f64(&a_node.m_max[j][i]);
+      if (a_q.m_eqn[j] >= 0.0)
+      {
+        lo = vaddq_f64(lo, vmulq_f64(c, mn));
+        hi = vaddq_f64(hi, vmulq_f64(c, mx));
+      }
+      else
+      {
+        lo = vaddq_f64(lo, vmulq_f64(c, mx));
+        hi = vaddq_f64(hi, vmulq_f64(c, mn));
+      }
+    }
+    const uint64x2_t m = vandq_u64(vcleq_f64(lo, vdupq_n_f64(a_q.m_max)), vcgeq_f64(hi, vdupq_n_f64(a_q.m_min)));
+    mask |= FlatMovemaskNEONHelper(m) << i;
+  }
+  return mask;
+}
+
+#endif
+
+template <class Q> static unsigned int FlatMaskHelper(const MYON_RTreeFlatNode& a_node, const Q& a_q)
+{
+#if defined(MYON_RTREE_FLAT_AVX2)
+  if (FlatUseAVX2Helper())
+    return FlatMaskAVX2Helper(a_node, a_q);
+#elif defined(MYON_RTREE_FLAT_NEON)
+  return FlatMaskNEONHelper(a_node, a_q);
+#endif
+  return FlatMaskScalarHelper(a_node, a_q);
+}
+
+bool MYON_RTreeFlat::Create(
+  const MYON_RTreeLeaf* leaves,
+  size_t leaf_count,
+  unsigned int thread_count
+  )
+{
+  Destroy();
+
+  if (nullptr == leaves || 0 == leaf_count || leaf_count > 0x7FFFFFFF)
+    return false;
+
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+
+  MYON_SimpleArray<MYON_RTreeBranch> branches;
+  if (!PackLeavesHelper(leaves, leaf_count, branches))
+  {
+    MYON_ERROR("MYON_RTreeFlat::Create - invalid leaves[].m_rect.");
+    return false;
+  }
+
+  // The levels are packed from the leaves up. In the branches of the next 
+  // level up, m_id is the index of a node in the level below.
+  MYON_ClassArray< MYON_SimpleArray<MYON_RTreeFlatNode> > levels;
+  MYON_SimpleArray<MYON_RTreeBranch> parents;
+  MYON_SimpleArray<int> node_sizes;
+  for (int level = 0; /*empty test*/; level++)
+  {
+    PackLevelHelper(branches.Array(), branches.UnsignedCount(), MYON_RTreeFlat_NODE_COUNT, thread_count, node_sizes);
+    MYON_SimpleArray<MYON_RTreeFlatNode>& level_nodes = levels.AppendNew();
+    level_nodes.Reserve(node_sizes.UnsignedCount());
+    parents.SetCount(0);
+    parents.Reserve(node_sizes.UnsignedCount());
+    const MYON_RTreeBranch* branch = branches.Array();
+    for (int i = 0; i < node_sizes.Count(); i++)
+    {
+      MYON_RTreeFlatNode& node = level_nodes.AppendNew();
+      memset(&node, 0, sizeof(node));
+      node.m_level = level;
+      node.m_count = node_sizes[i];
+      MYON_RTreeBranch& parent = parents.AppendNew();
+      parent.m_rect = branch[0].m_rect;
+      parent.m_id = i;
+      for (int k = 0; k < node.m_count; k++)
+      {
+        const MYON_RTreeBBox& rect = branch[k].m_rect;
+        for (int j = 0; j < 3; j++)
+        {
+          node.m_min[j][k] = rect.m_min[j];
+          node.m_max[j][k] = rect.m_max[j];
+          if (rect.m_min[j] < parent.m_rect.m_min[j])
+            parent.m_rect.m_min[j] = rect.m_min[j];
+          if (rect.m_max[j] > parent.m_rect.m_max[j])
+            parent.m_rect.m_max[j] = rect.m_max[j];
+        }
+        node.m_child[k] = branch[k].m_id;
+      }
+      branch += node.m_count;
+    }
+    if (1 == parents.Count())
+      break;
+    branches = std::move(parents);
+  }
+
+  // Copy the levels into m_nodes from the root down and 
+  // change child indices from level indices to m_nodes[] indices.
+  unsigned int node_count = 0;
+  for (int level = 0; level < levels.Count(); level++)
+    node_count += levels[level].UnsignedCount();
+  m_nodes.Reserve(node_count);
+  unsigned int child_level_offset = 1;
+  for (int level = levels.Count() - 1; level >= 0; level--)
+  {
+    const MYON_SimpleArray<MYON_RTreeFlatNode>& level_nodes = levels[level];
+    for (int i = 0; i < level_nodes.Count(); i++)
+    {
+      MYON_RTreeFlatNode& node = m_nodes.AppendNew();
+      node = level_nodes[i];
+      if (level > 0)
+      {
+        for (int k = 0; k < node.m_count; k++)
+          node.m_child[k] += child_level_offset;
+      }
+    }
+    if (level > 0)
+      child_level_offset += levels[level - 1].UnsignedCount();
+  }
+  m_element_count = (unsigned int)leaf_count;
+
+  return true;
+}
+
+bool MYON_RTreeFlat::Create(
+  const MYON_RTree& rtree
+  )
+{
+  MYON_SimpleArray<MYON_RTreeLeaf> leaves;
+  MYON_RTreeIterator rit(rtree);
+  const MYON_RTreeBranch* rtree_leaf;
+  for (rit.First(); nullptr != (rtree_leaf = rit.Value()); rit.Next())
+  {
+    MYON_RTreeLeaf& leaf = leaves.AppendNew();
+    leaf.m_rect = rtree_leaf->m_rect;
+    leaf.m_id = rtree_leaf->m_id;
+  }
+  return Create(leaves.Array(), leaves.UnsignedCount(), 1);
+}
+
+void MYON_RTreeFlat::Destroy()
+{
+  m_nodes.Destroy();
+  m_element_count = 0;
+}
+
+template <class Q> bool MYON_RTreeFlat::Internal_Search(
+  const Q& query,
+  bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+  void* a_context
+  ) const
+{
+  if (0 == m_nodes.Count() || nullptr == resultCallback)
+    return false;
+
+  // Every node below the root has at least MYON_RTreeFlat_NODE_COUNT/2 
+  // children and the root has at least 2, so 2^31 elements need at most
+  // 16 levels and at most 7 siblings per level are waiting on the stack.
+  unsigned int stack[256];
+  int sp = 0;
+  stack[sp++] = 0;
+  const MYON_RTreeFlatNode* nodes = m_nodes.Array();
+  while (sp > 0)
+  {
+    const MYON_RTreeFlatNode& node = nodes[stack[--sp]];
+    const unsigned int mask = FlatMaskHelper(node, query) & ((1U << node.m_count) - 1U);
+    if (0 == mask)
+      continue;
+    if (node.m_level > 0)
+    {
+      // Push in reverse order so the children are searched in order.
+      for (int i = node.m_count - 1; i >= 0; i--)
+      {
+        if (0 != (mask & (1U << i)))
+          stack[sp++] = (unsigned int)node.m_child[i];
+      }
+    }
+    else
+    {
+      for (int i = 0; i < node.m_count; i++)
+      {
+        if (0 != (mask & (1U << i)) && !resultCallback(a_context, node.m_child[i]))
+          return false; // callback canceled search
+      }
+    }
+  }
+
+  return true;
+}
+
+bool MYON_RTreeFlat::Search(
+  const double a_min[3],
+  const double a_max[3],
+  bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+  void* a_context
+  ) const
+{
+  if (nullptr == a_min || nullptr == a_max)
+    return false;
+  MYON_RTreeFlatBoxQuery query;
+  memcpy(query.m_min, a_min, sizeof(query.m_min));
+  memcpy(query.m_max, a_max, sizeof(query.m_max));
+  return Internal_Search(query, resultCallback, a_context);
+}
+
+static bool MYON_CALLBACK_CDECL FlatAppendIntHelper(void* a_context, MYON__INT_PTR a_id)
+{
+  ((MYON_SimpleArray<int>*)a_context)->Append((int)a_id);
+  return true;
+}
+
+bool MYON_RTreeFlat::Search(
+  const double a_min[3],
+  const double a_max[3],
+  MYON_SimpleArray<int>& a_result
+  ) const
+{
+  return Search(a_min, a_max, FlatAppendIntHelper, &a_result);
+}
+
+bool MYON_RTreeFlat::Search(
+  const MYON_RTreeSphere& a_sphere,
+  bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+  void* a_context
+  ) const
+{
+  if (!(a_sphere.m_radius >= 0.0))
+    return false;
+  MYON_RTreeFlatSphereQuery query;
+  memcpy(query.m_point, a_sphere.m_point, sizeof(query.m_point));
+  query.m_radius2 = a_sphere.m_radius * a_sphere.m_radius;
+  return Internal_Search(query, resultCallback, a_context);
+}
+
+bool MYON_RTreeFlat::Search(
+  const MYON_Line& a_line,
+  bool bInfinite,
+  bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+  void* a_context
+  ) const
+{
+  if (!a_line.from.IsValid() || !a_line.to.IsValid())
+    return false;
+  MYON_RTreeFlatLineQuery query;
+  const MYON_3dVector D = a_line.to - a_line.from;
+  for (int j = 0; j < 3; j++)
+  {
+    query.m_P[j] = a_line.from[j];
+    query.m_inv[j] = (0.0 != D[j]) ? 1.0 / D[j] : 0.0;
+    query.m_bParallel[j] = !(0.0 != D[j] && MYON_IS_FINITE(query.m_inv[j]));
+  }
+  query.m_t[0] = bInfinite ? -MYON_DBL_MAX : 0.0;
+  query.m_t[1] = bInfinite ? MYON_DBL_MAX : 1.0;
+  return Internal_Search(query, resultCallback, a_context);
+}
+
+bool MYON_RTreeFlat::Search(
+  const MYON_PlaneEquation& a_plane_eqn,
+  double a_plane_min,
+  double a_plane_max,
+  bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+  void* a_context
+  ) const
+{
+  if (   !(a_plane_min <= a_plane_max)
+      || (0.0 == a_plane_eqn.x && 0.0 == a_plane_eqn.y && 0.0 == a_plane_eqn.z)
+     )
+    return false;
+  MYON_RTreeFlatPlaneQuery query;
+  query.m_eqn[0] = a_plane_eqn.x;
+  query.m_eqn[1] = a_plane_eqn.y;
+  query.m_eqn[2] = a_plane_eqn.z;
+  query.m_eqn[3] = a_plane_eqn.d;
+  query.m_min = a_plane_min;
+  query.m_max = a_plane_max;
+  return Internal_Search(query, resultCallback, a_context);
+}
+
+unsigned int MYON_RTreeFlat::ElementCount() const
+{
+  return m_element_count;
+}
+
+unsigned int MYON_RTreeFlat::NodeCount() const
+{
+  return m_nodes.UnsignedCount();
+}
+
+const MYON_RTreeFlatNode* MYON_RTreeFlat::Nodes() const
+{
+  return m_nodes.Array();
+}
+
+MYON_BoundingBox MYON_RTreeFlat::BoundingBox() const
+{
+  MYON_BoundingBox bbox;
+  if (m_nodes.Count() > 0)
+  {
+    const MYON_RTreeFlatNode& root = m_nodes[0];
+    for (int i = 0; i < root.m_count; i++)
+    {
+      bbox.Union(MYON_BoundingBox(
+        MYON_3dPoint(root.m_min[0][i], root.m_min[1][i], root.m_min[2][i]),
+        MYON_3dPoint(root.m_max[0][i], root.m_max[1][i], root.m_max[2][i])
+      ));
+    }
+  }
+  return bbox;
+}
+
+size_t MYON_RTreeFlat::SizeOf() const
+{
+  return m_nodes.SizeOfArray();
+}
@@ -142,6 +142,12 @@ struct MYON_RTreePolylineContext
   unsigned int m_polyline_pointindex;
 };
 
+struct MYON_RTreeNearestElement
+{
+  MYON__INT_PTR m_id;  // element id
+  double m_distance;   // distance from the search point to the element
+};
+
 struct MYON_RTreeSearchResult
 {
   int m_capacity;   // m_id[] array capacity (search terminates when m_count == m_capacity)
@@ -400,6 +406,34 @@ public:
   */
   bool CreateMeshFaceTree( const class MYON_Mesh* mesh );
 
+  /*
+  Description:
+    Create an R-tree from a list of elements by packing them into nodes
+    with sort-tile-recursive bulk loading. A packed tree has fewer nodes 
+    than a tree created by calling Insert() for each element and it is
+    faster to search.
+  Parameters:
+    leaves - [in]
+      bounding boxes and ids of the elements.
+    leaf_count - [in]
+      number of elements in leaves[].
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: create the tree on the calling thread (default).
+      > 1: use at most thread_count threads to sort the elements.
+  Returns:
+    True if successful. False if leaves[] is empty or contains an
+    invalid bounding box, in which case the R-tree is empty.
+  Remarks:
+    Any elements in the R-tree are removed. Insert() and Remove() can 
+    be used to modify the R-tree after it is created.
+  */
+  bool CreatePacked(
+    const MYON_RTreeLeaf* leaves,
+    size_t leaf_count,
+    unsigned int thread_count = 1
+    );
+
 
   /*
   Description:
@@ -613,6 +647,72 @@ public:
     MYON_SimpleArray<int>& a_result
     ) const;
 
+  /*
+  Description:
+    Find the elements closest to a point with a best-first search.
+    Nodes and elements are visited in order of increasing distance 
+    from a_point to their bounding boxes, so only the part of the 
+    tree near the closest elements is searched.
+  Parameters:
+    a_point - [in]
+    k - [in]
+      maximum number of elements to find.
+    a_max_distance - [in]
+      Elements farther than a_max_distance from a_point are not found.
+      Pass MYON_DBL_MAX to find the k closest elements.
+    distanceCallback - [in]
+      nullptr or a function that returns the exact distance from a_point
+      to the element a_id. The returned distance must be >= the distance 
+      from a_point to the element's bounding box. Return a negative value
+      to skip the element. When distanceCallback is nullptr, the distance
+      to the element's bounding box is used.
+    a_context - [in]
+      pointer passed to the distanceCallback() function.
+    a_result - [out]
+      The closest elements are appended in order of increasing distance.
+  Returns:
+    Number of elements appended to a_result[].
+  Remarks:
+    distanceCallback() is called only for elements whose bounding boxes
+    are closer than the k-th closest element found so far.
+  */
+  unsigned int SearchNearest(
+    const double a_point[3],
+    unsigned int k,
+    double a_max_distance,
+    double MYON_CALLBACK_CDECL distanceCallback(void* a_context, const double a_point[3], MYON__INT_PTR a_id),
+    void* a_context,
+    MYON_SimpleArray<MYON_RTreeNearestElement>& a_result
+    ) const;
+
+  unsigned int SearchNearest(
+    const double a_point[3],
+    unsigned int k,
+    MYON_SimpleArray<MYON_RTreeNearestElement>& a_result
+    ) const;
+
+  /*
+  Description:
+    Find the element closest to a point.
+  Parameters:
+    a_point - [in]
+    a_max_distance - [in]
+    distanceCallback - [in]
+    a_context - [in]
+      See SearchNearest().
+    a_nearest - [out]
+      The closest element.
+  Returns:
+    True if an element was found.
+  */
+  bool SearchNearest(
+    const double a_point[3],
+    double a_max_distance,
+    double MYON_CALLBACK_CDECL distanceCallback(void* a_context, const double a_point[3], MYON__INT_PTR a_id),
+    void* a_context,
+    MYON_RTreeNearestElement& a_nearest
+    ) const;
+
   /*
   Description:
     Search two R-trees for all pairs elements whose bounding boxes overlap.
@@ -639,6 +739,37 @@ public:
           MYON_SimpleArray<MYON_2dex>& a_result
           );
 
+  /*
+  Description:
+    Search two R-trees for all pairs elements whose bounding boxes overlap
+    using multiple threads.
+  Parameters:
+    a_rtreeA - [in]
+    a_rtreeB - [in]
+    tolerance - [in]
+      If the distance between a pair of bounding boxes is <= tolerance, 
+      then the pair is added to a_result[].
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: search on the calling thread.
+      > 1: use at most thread_count threads.
+    a_result - [out]
+      Pairs of ids of elements who bounding boxes overlap.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  Remarks:
+    The top levels of the trees are split into node pairs that are
+    searched in parallel. The pairs are appended to a_result[] in the 
+    same order as the single threaded search.
+  */
+  static bool Search(
+          const MYON_RTree& a_rtreeA,
+          const MYON_RTree& a_rtreeB,
+          double tolerance,
+          unsigned int thread_count,
+          MYON_SimpleArray<MYON_2dex>& a_result
+          );
+
   /*
   Description:
     Search two R-trees for all pairs elements whose bounding boxes overlap.
@@ -750,6 +881,32 @@ public:
     MYON_SimpleArray<MYON_2dex>& a_result
     ) const;
 
+  /*
+  Description:
+    Search a single R-tree for all pairs of distinct elements whose bounding boxes overlap
+    using multiple threads.
+  Parameters:
+    tolerance - [in]
+      If the distance between a pair of bounding boxes is <= tolerance,
+      then the pair is added to a_result[].
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: search on the calling thread.
+      > 1: use at most thread_count threads.
+    a_result - [out]
+      Pairs of ids of elements who bounding boxes overlap.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  Remarks:
+    The pairs are appended to a_result[] in the same order as the 
+    single threaded search.
+  */
+  bool Search(
+    double tolerance,
+    unsigned int thread_count,
+    MYON_SimpleArray<MYON_2dex>& a_result
+    ) const;
+
   /*
   Description:
     Search a single R-tree for all pairs of distinct elements whose bounding boxes overlap.
@@ -857,4 +1014,202 @@ private:
   MYON_RTreeMemPool m_mem_pool;
 };
 
+// Number of children in an MYON_RTreeFlatNode.
+#define MYON_RTreeFlat_NODE_COUNT 8
+
+// The MYON_RTreeFlatNode is used at root, branch and leaf nodes of an
+// MYON_RTreeFlat. The child bounding boxes are stored as arrays of
+// coordinates so the boxes of all children can be tested at once with
+// SIMD instructions.
+struct MYON_RTreeFlatNode
+{
+  // m_min[j][i] and m_max[j][i] are coordinate j of the bounding box 
+  // of child i.
+  double m_min[3][MYON_RTreeFlat_NODE_COUNT];
+  double m_max[3][MYON_RTreeFlat_NODE_COUNT];
+
+  // If m_level > 0, then m_child[i] is the index of a child node.
+  // If m_level = 0, then m_child[i] identifies a leaf element.
+  MYON__INT_PTR m_child[MYON_RTreeFlat_NODE_COUNT];
+
+  int m_level; // =0 at leaf nodes, > 0 at branch nodes
+
+  // 1 <= m_count <= MYON_RTreeFlat_NODE_COUNT
+  int m_count;
+};
+
+#if defined(MYON_DLL_TEMPLATE)
+MYON_DLL_TEMPLATE template class MYON_CLASS MYON_SimpleArray<MYON_RTreeFlatNode>;
+#endif
+
+////////////////////////////////////////////////////////////////
+//
+// MYON_RTreeFlat
+//
+//   The MYON_RTreeFlat class is a read only R-tree. The nodes are 
+//   packed in one array with the root first and each level after
+//   the one above it. It is created once and then searched with
+//   SIMD box tests (AVX2 on x86-64 processors that have it, NEON
+//   on ARM64). Use MYON_RTree when elements are inserted or 
+//   removed after the tree is created.
+//
+class MYON_CLASS MYON_RTreeFlat
+{
+public:
+  static const MYON_RTreeFlat Empty;
+
+  MYON_RTreeFlat() = default;
+  ~MYON_RTreeFlat() = default;
+  MYON_RTreeFlat(const MYON_RTreeFlat&) = default;
+  MYON_RTreeFlat& operator=(const MYON_RTreeFlat&) = default;
+
+  /*
+  Description:
+    Create a flat R-tree from a list of elements.
+  Parameters:
+    leaves - [in]
+      bounding boxes and ids of the elements.
+    leaf_count - [in]
+      number of elements in leaves[].
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads.
+      1: create the tree on the calling thread (default).
+      > 1: use at most thread_count threads to sort the elements.
+  Returns:
+    True if successful. False if leaves[] is empty or contains an
+    invalid bounding box, in which case the tree is empty.
+  Remarks:
+    The elements are packed with the same sort-tile-recursive method
+    used by MYON_RTree::CreatePacked().
+  */
+  bool Create(
+    const MYON_RTreeLeaf* leaves,
+    size_t leaf_count,
+    unsigned int thread_count = 1
+    );
+
+  /*
+  Description:
+    Create a flat R-tree with the same elements as an MYON_RTree.
+  Parameters:
+    rtree - [in]
+  Returns:
+    True if successful.
+  */
+  bool Create(
+    const MYON_RTree& rtree
+    );
+
+  /*
+  Description:
+    Remove all elements.
+  */
+  void Destroy();
+
+  /*
+  Description:
+    Search the R-tree for all elements whose bounding boxes overlap
+    a region.
+  Parameters:
+    a_min - [in]
+    a_max - [in]
+      (a_min,a_max) is the bounding box of the search region.
+    a_sphere - [in]
+      Elements whose bounding boxes are within a_sphere.m_radius
+      of a_sphere.m_point are found.
+    a_line - [in]
+    bInfinite - [in]
+      If bInfinite is true, elements whose bounding boxes intersect the
+      infinite line through a_line are found. Otherwise, elements whose
+      bounding boxes intersect the line segment are found.
+    a_plane_eqn - [in]
+    a_plane_min - [in]
+    a_plane_max - [in]
+      Elements whose bounding boxes contain a point where the value of 
+      a_plane_eqn is >= a_plane_min and <= a_plane_max are found.
+    resultCallback - [in]
+      A function to call for each element that is found.
+      Return true to keep searching and false to terminate the search.
+    a_context - [in]
+      pointer passed to the resultCallback() function.
+    a_result - [out]
+      The ids of elements that are found are appended.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  */
+  bool Search(
+    const double a_min[3], 
+    const double a_max[3],
+    bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+    void* a_context
+    ) const;
+
+  bool Search(
+    const double a_min[3], 
+    const double a_max[3],
+    MYON_SimpleArray<int>& a_result
+    ) const;
+
+  bool Search(
+    const MYON_RTreeSphere& a_sphere,
+    bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+    void* a_context
+    ) const;
+
+  bool Search(
+    const MYON_Line& a_line,
+    bool bInfinite,
+    bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+    void* a_context
+    ) const;
+
+  bool Search(
+    const class MYON_PlaneEquation& a_plane_eqn,
+    double a_plane_min,
+    double a_plane_max,
+    bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+    void* a_context
+    ) const;
+
+  /*
+  Returns:
+    Number of elements (leaves).
+  */
+  unsigned int ElementCount() const;
+
+  /*
+  Returns:
+    Number of nodes.
+  */
+  unsigned int NodeCount() const;
+
+  /*
+  Returns:
+    Pointer to the nodes. The root is Nodes()[0].
+  */
+  const MYON_RTreeFlatNode* Nodes() const;
+
+  /*
+  Returns:
+    Bounding box of the entire R-tree;
+  */
+  MYON_BoundingBox BoundingBox() const;
+
+  /*
+  Returns:
+    Number of bytes of heap memory used by this R-tree.
+  */
+  size_t SizeOf() const;
+
+private:
+  template <class Q> bool Internal_Search(
+    const Q& query,
+    bool MYON_CALLBACK_CDECL resultCallback(void* a_context, MYON__INT_PTR a_id),
+    void* a_context
+    ) const;
+
+  MYON_SimpleArray<MYON_RTreeFlatNode> m_nodes;
+  unsigned int m_element_count = 0;
+};
+
 #endif
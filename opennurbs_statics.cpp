@@ -844,6 +844,7 @@ const MYON_3dmAnnotationSettings MYON_3dmAnnotationSettings::Default;
 const MYON_3dmAnnotationContext MYON_3dmAnnotationContext::Default;
 
 const MYON_3dmArchiveTableStatus MYON_3dmArchiveTableStatus::Unset;
+const MYON_3dmObjectTableIndexItem MYON_3dmObjectTableIndexItem::Unset;
 
 const wchar_t* MYON_TextDot::DefaultFontFace = L"Arial";
 const int MYON_TextDot::DefaultHeightInPoints = 14;
@@ -1177,6 +1178,8 @@ const MYON_HistoryRecord MYON_HistoryRecord::Empty;
 
 const MYON_RTreeMemPool MYON_RTreeMemPool::Empty;
 const MYON_RTree MYON_RTree::Empty;
+const MYON_RTreeFlat MYON_RTreeFlat::Empty;
+const MYON_MeshTree MYON_MeshTree::Empty;
 
 // {F5E3BAA9-A7A2-49FD-B8A1-66EB274A5F91}
 const MYON_UUID MYON_MeshCache::RenderMeshId =
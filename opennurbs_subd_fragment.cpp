@@ -2919,11 +2919,19 @@ const MYON_RTree& MYON_SubDMeshImpl::FragmentTree() const
   if (nullptr != m_fragment_tree && nullptr != m_first_fragment)
   {
     MYON_RTree* fragment_tree = new MYON_RTree();
+    MYON_SimpleArray<MYON_RTreeLeaf> leaves;
     for (const MYON_SubDMeshFragment* fragment = m_first_fragment; nullptr != fragment; fragment = fragment->m_next_fragment)
     {
-      if (fragment->PointCount() > 0 )
-        fragment_tree->Insert(&(fragment->m_surface_bbox.m_min.x), &(fragment->m_surface_bbox.m_max.x), (void*)fragment);
+      // CreatePacked() fails when any box is invalid, so skip those fragments.
+      if (fragment->PointCount() > 0 && fragment->m_surface_bbox.IsValid())
+      {
+        MYON_RTreeLeaf& leaf = leaves.AppendNew();
+        memcpy(leaf.m_rect.m_min, &(fragment->m_surface_bbox.m_min.x), sizeof(leaf.m_rect.m_min));
+        memcpy(leaf.m_rect.m_max, &(fragment->m_surface_bbox.m_max.x), sizeof(leaf.m_rect.m_max));
+        leaf.m_id = (MYON__INT_PTR)fragment;
+      }
     }
+    fragment_tree->CreatePacked(leaves.Array(), leaves.UnsignedCount(), 1);
     const_cast< MYON_SubDMeshImpl* >(this)->m_fragment_tree = fragment_tree;
   }
   return (nullptr == m_fragment_tree ) ? MYON_RTree::Empty : *m_fragment_tree;
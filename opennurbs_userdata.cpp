@@ -208,7 +208,7 @@ MYON_UUID MYON_UserData::UserDataClassUuid() const
 {
   const MYON_ClassId* this_rtti = ClassId();
 
-  if (this_rtti == &MYON_CLASS_RTTI(MYON_UnknownUserData))
+  if (this_rtti == &MYON_CLASS_RTTI(MYON_UnknownUserData) || this_rtti == &MYON_CLASS_RTTI(MYON_UnknownUserDataReference))
     return ((MYON_UnknownUserData*)this)->m_unknownclass_uuid;
 
   if (this_rtti == &MYON_CLASS_RTTI(MYON_ObsoleteUserData))
@@ -219,7 +219,8 @@ MYON_UUID MYON_UserData::UserDataClassUuid() const
 
 bool MYON_UserData::IsUnknownUserData() const
 {
-  return (ClassId() == &MYON_CLASS_RTTI(MYON_UnknownUserData))?true:false;
+  const MYON_ClassId* this_rtti = ClassId();
+  return (this_rtti == &MYON_CLASS_RTTI(MYON_UnknownUserData) || this_rtti == &MYON_CLASS_RTTI(MYON_UnknownUserDataReference))?true:false;
 }
 
 bool MYON_UserData::GetDescription( MYON_wString& description )
@@ -425,6 +426,107 @@ bool MYON_UnknownUserData::Read( MYON_BinaryArchive& file )
 }
 
 
+MYON_OBJECT_IMPLEMENT(MYON_UnknownUserDataReference,MYON_UnknownUserData,"48E2091F-D611-46A9-A660-0B0656726DA5");
+
+MYON_UnknownUserDataReference::MYON_UnknownUserDataReference(const MYON_UnknownUserDataReference& src)
+  : MYON_UnknownUserData(src)
+{
+  if ( m_userdata_copycount > 0 && src.m_sizeof_buffer > 0 && nullptr == src.m_buffer && nullptr != src.m_referenced_bytes )
+  {
+    // See MYON_UnknownUserData(const MYON_UnknownUserData&). 
+    // The referenced bytes are shared, not copied.
+    m_userdata_uuid = src.m_userdata_uuid;
+    m_unknownclass_uuid = src.m_unknownclass_uuid;
+    m_sizeof_buffer = src.m_sizeof_buffer;
+    m_3dm_version = src.m_3dm_version;
+    m_3dm_opennurbs_version_number = src.m_3dm_opennurbs_version_number;
+    m_referenced_bytes = src.m_referenced_bytes;
+    m_referenced_bytes_owner = src.m_referenced_bytes_owner;
+  }
+}
+
+MYON_UnknownUserDataReference::~MYON_UnknownUserDataReference()
+{
+  // This destructor is explictily implemented to insure m_referenced_bytes_owner 
+  // is destroyed by the same c-runtime that creates it.
+  m_referenced_bytes = nullptr;
+  m_referenced_bytes_owner.reset();
+}
+
+MYON_UnknownUserDataReference& MYON_UnknownUserDataReference::operator=(const MYON_UnknownUserDataReference& src)
+{
+  if ( this != &src )
+  {
+    m_referenced_bytes = nullptr;
+    m_referenced_bytes_owner.reset();
+    MYON_UnknownUserData::operator=(src);
+    if ( m_userdata_copycount > 0 && src.m_sizeof_buffer > 0 && nullptr == src.m_buffer && nullptr != src.m_referenced_bytes )
+    {
+      m_unknownclass_uuid = src.m_unknownclass_uuid;
+      m_sizeof_buffer = src.m_sizeof_buffer;
+      m_3dm_version = src.m_3dm_version;
+      m_3dm_opennurbs_version_number = src.m_3dm_opennurbs_version_number;
+      m_referenced_bytes = src.m_referenced_bytes;
+      m_referenced_bytes_owner = src.m_referenced_bytes_owner;
+    }
+  }
+  return *this;
+}
+
+const void* MYON_UnknownUserDataReference::UserDataBytes() const
+{
+  return (nullptr != m_buffer) ? m_buffer : m_referenced_bytes;
+}
+
+bool MYON_UnknownUserDataReference::IsValid( MYON_TextLog* text_log ) const
+{
+  bool rc = MYON_UserData::IsValid(text_log);
+  if (rc) 
+    rc = (m_sizeof_buffer > 0 && nullptr != UserDataBytes());
+  if (rc)
+    rc = (MYON_nil_uuid != m_unknownclass_uuid && MYON_CLASS_ID(MYON_UnknownUserData) != m_unknownclass_uuid);
+  return rc;
+}
+
+unsigned int MYON_UnknownUserDataReference::SizeOf() const
+{
+  // Referenced bytes are in the archive's memory.
+  unsigned int sz = MYON_UserData::SizeOf() + (sizeof(MYON_UnknownUserDataReference)-sizeof(MYON_UserData));
+  if (nullptr != m_buffer && m_sizeof_buffer > 0)
+    sz += (unsigned int)m_sizeof_buffer;
+  return sz;
+}
+
+bool MYON_UnknownUserDataReference::Write( MYON_BinaryArchive& file ) const
+{
+  return file.WriteByte(m_sizeof_buffer,UserDataBytes());
+}
+
+bool MYON_UnknownUserDataReference::Read( MYON_BinaryArchive& file )
+{
+  m_referenced_bytes = nullptr;
+  m_referenced_bytes_owner.reset();
+  m_3dm_version = file.Archive3dmVersion();
+  const std::shared_ptr<const void>& owner = file.UnknownUserDataReferenceOwner();
+  if ( m_sizeof_buffer > 0 && nullptr != owner.get() )
+  {
+    const void* view = file.ReadByteView((size_t)m_sizeof_buffer);
+    if ( nullptr != view )
+    {
+      if ( nullptr != m_buffer )
+      {
+        onfree(m_buffer);
+        m_buffer = nullptr;
+      }
+      m_referenced_bytes = view;
+      m_referenced_bytes_owner = owner;
+      return true;
+    }
+  }
+  // The archive cannot provide a view and the bytes are copied.
+  return MYON_UnknownUserData::Read(file);
+}
+
 class MYON_UnknownUserDataArchive : public MYON_BinaryArchive
 {
   // This class is used to define an MYON_BinaryArchive that can be used
@@ -462,7 +564,11 @@ MYON_UnknownUserDataArchive::MYON_UnknownUserDataArchive(const MYON_UnknownUserD
 {
   SetArchive3dmVersion(ud.m_3dm_version);
   m_sizeof_buffer = ud.m_sizeof_buffer;
-  m_buffer = (const unsigned char*)ud.m_buffer;
+  const MYON_UnknownUserDataReference* ud_reference = MYON_UnknownUserDataReference::Cast(&ud);
+  m_buffer 
+    = (nullptr != ud_reference)
+    ? (const unsigned char*)ud_reference->UserDataBytes()
+    : (const unsigned char*)ud.m_buffer;
   m_buffer_position = 0;
 }
 
@@ -328,6 +328,54 @@ public:
   unsigned int m_3dm_opennurbs_version_number;
 };
 
+/*
+Description:
+  MYON_UnknownUserDataReference is unknown user data that references the
+  bytes in the memory of the archive it was read from instead of copying
+  them into m_buffer. When it is written, the referenced bytes are written
+  directly to the destination archive.
+  MYON_BinaryArchive::SetUnknownUserDataReferenceOwner() enables creating
+  MYON_UnknownUserDataReference classes when an archive is read.
+Remarks:
+  m_buffer is nullptr and m_sizeof_buffer is the number of referenced bytes.
+  The referenced memory is kept valid by a shared_ptr to its owner, typically
+  the MYON_BinaryMappedFile the user data was read from. Do not call
+  MYON_BinaryMappedFile::UnmapFile() while the user data exists.
+*/
+class MYON_CLASS MYON_UnknownUserDataReference : public MYON_UnknownUserData
+{
+  MYON_OBJECT_DECLARE(MYON_UnknownUserDataReference);
+public:
+  MYON_UnknownUserDataReference() = default;
+  MYON_UnknownUserDataReference(const MYON_UnknownUserDataReference&);
+  ~MYON_UnknownUserDataReference();
+  MYON_UnknownUserDataReference& operator=(const MYON_UnknownUserDataReference&);
+
+  // MYON_Object overrides
+  bool IsValid( class MYON_TextLog* text_log = nullptr ) const override;
+  bool Write( MYON_BinaryArchive& ) const override;
+  bool Read( MYON_BinaryArchive& ) override;
+  unsigned int SizeOf() const override;
+
+  /*
+  Returns:
+    A pointer to the m_sizeof_buffer bytes of user data. 
+    If the archive could not provide a view when the user data was read,
+    the bytes are copied into m_buffer and m_buffer is returned.
+  */
+  const void* UserDataBytes() const;
+
+private:
+  const void* m_referenced_bytes = nullptr;
+
+#pragma MYON_PRAGMA_WARNING_PUSH
+#pragma MYON_PRAGMA_WARNING_DISABLE_MSC( 4251 ) 
+  // C4251: ... needs to have dll-interface to be used by clients of class ...
+  // m_referenced_bytes_owner is private and all code that manages it is explicitly implemented in the DLL.
+  std::shared_ptr<const void> m_referenced_bytes_owner;
+#pragma MYON_PRAGMA_WARNING_POP
+};
+
 class MYON_CLASS MYON_ObsoleteUserData : public MYON_UserData
 {
   MYON_OBJECT_DECLARE(MYON_ObsoleteUserData);
@@ -76,13 +76,185 @@ public:
   z_stream         m_strm;
 };
 
+// See MYON_BinaryArchive::BeginThreadCompressorReuseForExperts().
+static thread_local unsigned int Internal_CompressorReuseDepth = 0;
+static thread_local class MYON_CompressorImplementation* Internal_ReusedCompressor = nullptr;
+
+static void Internal_FreeCompressor(
+  class MYON_CompressorImplementation* compressor
+  )
+{
+  if (nullptr == compressor)
+    return;
+  switch (compressor->m_mode)
+  {
+  case MYON::archive_mode::read:
+  case MYON::archive_mode::read3dm:
+    inflateEnd(&compressor->m_strm);
+    break;
+  case MYON::archive_mode::write:
+  case MYON::archive_mode::write3dm:
+    deflateEnd(&compressor->m_strm);
+    break;
+  default: // to quiet lint
+    break;
+  }
+  onfree(compressor);
+}
+
+void MYON_BinaryArchive::BeginThreadCompressorReuseForExperts()
+{
+  Internal_CompressorReuseDepth++;
+}
+
+void MYON_BinaryArchive::EndThreadCompressorReuseForExperts()
+{
+  if (0 == Internal_CompressorReuseDepth)
+    return;
+  Internal_CompressorReuseDepth--;
+  if (0 == Internal_CompressorReuseDepth)
+  {
+    Internal_FreeCompressor(Internal_ReusedCompressor);
+    Internal_ReusedCompressor = nullptr;
+  }
+}
+
 class MYON_CompressorImplementation& MYON_BinaryArchive::Compressor()
 {
+  if (nullptr == m_compressor && nullptr != Internal_ReusedCompressor)
+  {
+    // The zlib stream may still be initialized for inflating.
+    // CompressionInit() ends it when a different mode is needed.
+    m_compressor = Internal_ReusedCompressor;
+    Internal_ReusedCompressor = nullptr;
+  }
   if (nullptr == m_compressor)
     m_compressor = (class MYON_CompressorImplementation*)oncalloc(1, sizeof(*m_compressor));
   return *m_compressor;
 }
 
+void MYON_BinaryArchive::Internal_ReleaseCompressor()
+{
+  if (nullptr == m_compressor)
+    return;
+  if (Internal_CompressorReuseDepth > 0 && nullptr == Internal_ReusedCompressor)
+  {
+    if (MYON::archive_mode::read != m_compressor->m_mode)
+      CompressionEnd();
+    Internal_ReusedCompressor = m_compressor;
+  }
+  else
+  {
+    Internal_FreeCompressor(m_compressor);
+  }
+  m_compressor = nullptr;
+}
+
+
+static unsigned int Internal_CompressionThreadCount(
+  unsigned int thread_count
+  )
+{
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+  return (thread_count > 1) ? thread_count : 1;
+}
+
+template <class T> static void Internal_ForEachCompressedBlock(
+  unsigned int thread_count,
+  unsigned int block_count,
+  const T& block_task
+  )
+{
+  std::atomic<unsigned int> next_block(0);
+  auto run = [&]()
+  {
+    for (unsigned int i = next_block++; i < block_count; i = next_block++)
+      block_task(i);
+  };
+
+  const unsigned int worker_count
+    = (block_count <= 1)
+    ? 0U
+    : ((block_count < thread_count) ? block_count : thread_count) - 1U;
+  MYON_SimpleArray< std::thread* > workers(worker_count);
+  for (unsigned int i = 0; i < worker_count; i++)
+  {
+    try
+    {
+      workers.Append(new std::thread(run));
+    }
+    catch (const std::system_error&)
+    {
+      // No more threads are available.
+      // The calling thread processes the remaining blocks.
+      break;
+    }
+  }
+  run();
+  for (int i = 0; i < workers.Count(); i++)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+}
+
+static unsigned char* Internal_DeflateBlock(
+  size_t sizeof_inbuffer,
+  const void* inbuffer,
+  MYON__UINT32* sizeof_outbuffer
+  )
+{
+  // Each block is a complete zlib stream.
+  *sizeof_outbuffer = 0;
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  if (Z_OK != deflateInit(&strm, Z_BEST_COMPRESSION))
+    return nullptr;
+
+  // deflateBound() is large enough for a single call to deflate().
+  const uLong capacity = deflateBound(&strm, (uLong)sizeof_inbuffer);
+  unsigned char* outbuffer = (unsigned char*)onmalloc(capacity);
+  if (nullptr != outbuffer)
+  {
+    strm.next_in = (Bytef*)inbuffer;
+    strm.avail_in = (uInt)sizeof_inbuffer;
+    strm.next_out = outbuffer;
+    strm.avail_out = (uInt)capacity;
+    if (Z_STREAM_END == z_deflate(&strm, Z_FINISH))
+      *sizeof_outbuffer = (MYON__UINT32)strm.total_out;
+    else
+    {
+      onfree(outbuffer);
+      outbuffer = nullptr;
+    }
+  }
+  deflateEnd(&strm);
+
+  return outbuffer;
+}
+
+static bool Internal_InflateBlock(
+  size_t sizeof_inbuffer,
+  const void* inbuffer,
+  size_t sizeof_outbuffer,
+  void* outbuffer
+  )
+{
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  if (Z_OK != inflateInit(&strm))
+    return false;
+  strm.next_in = (Bytef*)inbuffer;
+  strm.avail_in = (uInt)sizeof_inbuffer;
+  strm.next_out = (Bytef*)outbuffer;
+  strm.avail_out = (uInt)sizeof_outbuffer;
+  const bool rc 
+    = Z_STREAM_END == z_inflate(&strm, Z_FINISH) 
+    && sizeof_outbuffer == (size_t)strm.total_out;
+  inflateEnd(&strm);
+  return rc;
+}
 
 bool MYON_BinaryArchive::WriteCompressedBuffer(
         size_t sizeof__inbuffer,  // sizeof uncompressed input data
@@ -120,7 +292,14 @@ bool MYON_BinaryArchive::WriteCompressedBuffer(
     ? 1
     : 0;
 
-  if ( method ) {
+  const unsigned int thread_count = Internal_CompressionThreadCount(m_compression_thread_count);
+  if ( 1 == method && thread_count > 1 && sizeof__inbuffer > MYON_BinaryArchive::CompressedBufferBlockSize )
+  {
+    // independently deflated blocks
+    method = 2;
+  }
+
+  if ( 1 == method ) {
     if ( !CompressionInit() ) {
       CompressionEnd();
       method = 0;
@@ -129,6 +308,9 @@ bool MYON_BinaryArchive::WriteCompressedBuffer(
   if ( !WriteChar(method) )
     return false;
 
+  if (m_bProfilingEnabled)
+    Internal_ProfileBeginCompression();
+
   switch ( method )
   {
   case 0: // uncompressed
@@ -144,8 +326,16 @@ bool MYON_BinaryArchive::WriteCompressedBuffer(
     rc = ( compressed_size > 0 ) ? true : false;
     CompressionEnd();
     break;
+
+  case 2: // compressed in blocks
+    compressed_size = WriteBlockDeflate( sizeof__inbuffer, inbuffer, thread_count );
+    rc = ( compressed_size > 0 ) ? true : false;
+    break;
   }
 
+  if (m_bProfilingEnabled)
+    Internal_ProfileEndCompression();
+
 
   return rc;
 }
@@ -185,9 +375,12 @@ bool MYON_BinaryArchive::ReadCompressedBuffer( // read and uncompress
   if ( !ReadChar(&method) )
     return false;
 
-  if ( method != 0 && method != 1 )
+  if ( method != 0 && method != 1 && method != 2 )
     return false;
 
+  if (m_bProfilingEnabled)
+    Internal_ProfileBeginCompression();
+
   switch(method)
   {
   case 0: // uncompressed
@@ -197,10 +390,17 @@ bool MYON_BinaryArchive::ReadCompressedBuffer( // read and uncompress
     rc = CompressionInit();
     if (rc)
       rc = ReadInflate( sizeof__outbuffer, outbuffer );
-    CompressionEnd();
+    if ( false == rc || 0 == Internal_CompressorReuseDepth || Z_OK != inflateReset(&m_compressor->m_strm) )
+      CompressionEnd();
+    break;
+  case 2: // compressed in blocks
+    rc = ReadBlockInflate( sizeof__outbuffer, outbuffer );
     break;
   }
 
+  if (m_bProfilingEnabled)
+    Internal_ProfileEndCompression();
+
   if (rc ) 
   {
     buffer_crc1 = MYON_CRC32( 0, sizeof__outbuffer, outbuffer );
@@ -412,6 +612,9 @@ bool MYON_BinaryArchive::ReadInflate(
 
   size_t sizeof__inbuffer = 0;
   void* in___buffer = 0;
+  // When the archive contents are in memory, in___view points into the
+  // archive and the compressed bytes are not copied into in___buffer.
+  const void* in___view = 0;
   bool rc = false;
 
   // read compressed buffer from 3dm archive
@@ -433,14 +636,29 @@ bool MYON_BinaryArchive::ReadInflate(
     {
       // read compressed buffer from the archive
       sizeof__inbuffer = (size_t)(big_value-4); // the last 4 bytes in this chunk are a 32 bit crc
-      in___buffer = onmalloc(sizeof__inbuffer);
-      if ( !in___buffer )
+      bool bChunkBoundaryError = false;
+      in___view = Internal_ReadByteView( sizeof__inbuffer, bChunkBoundaryError );
+      if ( 0 != in___view )
       {
+        rc = true;
+      }
+      else if ( bChunkBoundaryError )
+      {
+        // The error has been reported and ReadByte() would fail the same way.
         rc = false;
       }
       else
       {
-        rc = ReadByte( sizeof__inbuffer, in___buffer );
+        in___buffer = onmalloc(sizeof__inbuffer);
+        if ( !in___buffer )
+        {
+          rc = false;
+        }
+        else
+        {
+          rc = ReadByte( sizeof__inbuffer, in___buffer );
+          in___view = in___buffer;
+        }
       }
     }
     else
@@ -481,7 +699,7 @@ bool MYON_BinaryArchive::ReadInflate(
   int zrc = -1;
 
   // set up zlib in buffer
-  unsigned char* my_next_in = (unsigned char*)in___buffer;
+  unsigned char* my_next_in = (unsigned char*)in___view;
   size_t my_avail_in = sizeof__inbuffer;
 
   size_t d = my_avail_in;
@@ -604,6 +822,179 @@ bool MYON_BinaryArchive::ReadInflate(
   return rc;
 }
 
+size_t MYON_BinaryArchive::WriteBlockDeflate( // returns number of bytes written
+        size_t sizeof___inbuffer,  // sizeof uncompressed input data ( > 0 )
+        const void* in___buffer,   // uncompressed input data ( != nullptr )
+        unsigned int thread_count
+        )
+{
+  // The compressed information is saved in a chunk:
+  //   block size (uncompressed bytes in each block, the last block may be smaller)
+  //   block count
+  //   compressed size of each block
+  //   the blocks - each block is a complete zlib stream
+  // Blocks are deflated and inflated independently on multiple threads.
+  const MYON__UINT32 block_size = MYON_BinaryArchive::CompressedBufferBlockSize;
+  const MYON__UINT32 block_count = (MYON__UINT32)((sizeof___inbuffer + block_size - 1) / block_size);
+
+  MYON_SimpleArray< unsigned char* > blocks(block_count);
+  blocks.SetCount(block_count);
+  blocks.Zero();
+  MYON_SimpleArray< MYON__UINT32 > block_sizes(block_count);
+  block_sizes.SetCount(block_count);
+  block_sizes.Zero();
+
+  const unsigned char* inbuffer = (const unsigned char*)in___buffer;
+  Internal_ForEachCompressedBlock(
+    thread_count,
+    block_count,
+    [&](unsigned int i)
+    {
+      const size_t offset = ((size_t)i) * block_size;
+      const size_t sizeof_block = (sizeof___inbuffer - offset < block_size) ? (sizeof___inbuffer - offset) : block_size;
+      blocks[i] = Internal_DeflateBlock(sizeof_block, inbuffer + offset, &block_sizes[i]);
+    }
+  );
+
+  size_t out__count = 0;
+  bool rc = true;
+  for (unsigned int i = 0; i < block_count && rc; i++)
+  {
+    if (nullptr == blocks[i])
+    {
+      MYON_ERROR("MYON_BinaryArchive::WriteBlockDeflate - z_deflate failure");
+      rc = false;
+    }
+    out__count += block_sizes[i];
+  }
+
+  if (rc)
+  {
+    rc = BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK, 0);
+    if (rc)
+    {
+      rc = WriteInt(block_size) && WriteInt(block_count) && WriteInt(block_count, block_sizes.Array());
+      for (unsigned int i = 0; i < block_count && rc; i++)
+        rc = WriteByte(block_sizes[i], blocks[i]);
+      if (!EndWrite3dmChunk())
+        rc = false;
+    }
+  }
+
+  for (unsigned int i = 0; i < block_count; i++)
+  {
+    if (nullptr != blocks[i])
+      onfree(blocks[i]);
+  }
+
+  return (rc ? out__count : 0);
+}
+
+bool MYON_BinaryArchive::ReadBlockInflate(
+        size_t sizeof___outbuffer,  // sizeof uncompressed data
+        void* out___buffer          // buffer for uncompressed data
+        )
+{
+  if (0 == sizeof___outbuffer || nullptr == out___buffer)
+    return false;
+
+  MYON__UINT32 tcode = 0;
+  MYON__INT64 big_value = 0;
+  if (!BeginRead3dmBigChunk(&tcode, &big_value))
+  {
+    memset(out___buffer, 0, sizeof___outbuffer);
+    return false;
+  }
+
+  MYON__UINT32 block_size = 0;
+  MYON__UINT32 block_count = 0;
+  MYON_SimpleArray< MYON__UINT32 > block_sizes;
+  size_t sizeof__inbuffer = 0;
+  void* in___buffer = nullptr;
+  const void* in___view = nullptr;
+  const unsigned int c0 = BadCRCCount();
+
+  bool rc = (TCODE_ANONYMOUS_CHUNK == tcode && big_value > 12);
+  if (rc)
+    rc = ReadInt(&block_size) && ReadInt(&block_count);
+  if (rc)
+  {
+    // validate the block layout before allocating anything
+    rc = block_size > 0
+      && block_count == (sizeof___outbuffer + block_size - 1) / block_size
+      && 4 * ((MYON__INT64)block_count) <= big_value - 12;
+  }
+  if (rc)
+  {
+    block_sizes.SetCapacity(block_count);
+    block_sizes.SetCount(block_count);
+    rc = ReadInt(block_count, block_sizes.Array());
+  }
+  if (rc)
+  {
+    for (unsigned int i = 0; i < block_count; i++)
+      sizeof__inbuffer += block_sizes[i];
+    // the last 4 bytes in this chunk are a 32 bit crc
+    rc = (MYON__INT64)sizeof__inbuffer == big_value - 12 - 4 * ((MYON__INT64)block_count);
+  }
+  if (rc)
+  {
+    // When the archive contents are in memory, in___view points into the
+    // archive and the compressed bytes are not copied into in___buffer.
+    in___view = ReadByteView(sizeof__inbuffer);
+    if (nullptr == in___view)
+    {
+      in___buffer = onmalloc(sizeof__inbuffer);
+      rc = (nullptr != in___buffer) && ReadByte(sizeof__inbuffer, in___buffer);
+      in___view = in___buffer;
+    }
+  }
+  if (!EndRead3dmChunk())
+    rc = false;
+  if (BadCRCCount() > c0)
+    rc = false;
+
+  if (rc)
+  {
+    MYON_SimpleArray< size_t > block_offsets(block_count);
+    size_t offset = 0;
+    for (unsigned int i = 0; i < block_count; i++)
+    {
+      block_offsets.Append(offset);
+      offset += block_sizes[i];
+    }
+
+    std::atomic<bool> bInflateFailed(false);
+    const unsigned char* inbuffer = (const unsigned char*)in___view;
+    unsigned char* outbuffer = (unsigned char*)out___buffer;
+    Internal_ForEachCompressedBlock(
+      Internal_CompressionThreadCount(m_compression_thread_count),
+      block_count,
+      [&](unsigned int i)
+      {
+        const size_t out_offset = ((size_t)i) * block_size;
+        const size_t sizeof_block = (sizeof___outbuffer - out_offset < block_size) ? (sizeof___outbuffer - out_offset) : block_size;
+        if (!Internal_InflateBlock(block_sizes[i], inbuffer + block_offsets[i], sizeof_block, outbuffer + out_offset))
+          bInflateFailed = true;
+      }
+    );
+    if (bInflateFailed)
+    {
+      MYON_ERROR("MYON_BinaryArchive::ReadBlockInflate - z_inflate failure");
+      rc = false;
+    }
+  }
+  else
+  {
+    memset(out___buffer, 0, sizeof___outbuffer);
+  }
+
+  if (nullptr != in___buffer)
+    onfree(in___buffer);
+
+  return rc;
+}
+
 bool MYON_BinaryArchive::CompressionInit()
 {
   // inflateInit() and deflateInit() are in zlib 1.3.3